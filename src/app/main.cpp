@@ -62,6 +62,11 @@ public:
         dialog.SetCommandLineAlgorithms(args.algorithms);
       }
 
+      // Reuse digests of unchanged files if requested
+      if (args.useCache) {
+        dialog.SetUseDigestCache(true);
+      }
+
       // Auto-start calculation if input and algorithms were provided
       if (!args.input.empty() && (args.allAlgorithms || !args.algorithms.empty())) {
         dialog.SetAutoStartCalculation(true);
@@ -0,0 +1,94 @@
+#include "AlignedBufferPool.h"
+#include <new>
+#include <windows.h>
+
+namespace core {
+
+AlignedBuffer::AlignedBuffer(AlignedBuffer&& other) noexcept
+    : m_pool(other.m_pool), m_data(other.m_data), m_size(other.m_size) {
+    other.m_pool = nullptr;
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+AlignedBuffer& AlignedBuffer::operator=(AlignedBuffer&& other) noexcept {
+    if (this != &other) {
+        reset();
+        m_pool = other.m_pool;
+        m_data = other.m_data;
+        m_size = other.m_size;
+        other.m_pool = nullptr;
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+void AlignedBuffer::reset() {
+    if (m_data != nullptr) {
+        m_pool->release(m_data, m_size);
+        m_pool = nullptr;
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
+
+AlignedBufferPool& AlignedBufferPool::instance() {
+    static AlignedBufferPool pool;
+    return pool;
+}
+
+AlignedBufferPool::~AlignedBufferPool() {
+    for (auto& entry : m_free) {
+        VirtualFree(entry.second, 0, MEM_RELEASE);
+    }
+}
+
+size_t AlignedBufferPool::alignment() {
+    static const size_t pageSize = []() {
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        return static_cast<size_t>(systemInfo.dwPageSize);
+    }();
+    return pageSize;
+}
+
+size_t AlignedBufferPool::alignUp(size_t size) {
+    size_t align = alignment();
+    return (size + align - 1) / align * align;
+}
+
+AlignedBuffer AlignedBufferPool::acquire(size_t size) {
+    size = alignUp(size == 0 ? 1 : size);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_free.find(size);
+        if (it != m_free.end()) {
+            uint8_t* data = it->second;
+            m_free.erase(it);
+            m_cachedBytes -= size;
+            return AlignedBuffer(this, data, size);
+        }
+    }
+
+    void* data = VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (data == NULL) {
+        throw std::bad_alloc();
+    }
+    return AlignedBuffer(this, static_cast<uint8_t*>(data), size);
+}
+
+void AlignedBufferPool::release(uint8_t* data, size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_cachedBytes + size <= MAX_CACHED_BYTES) {
+            m_free.emplace(size, data);
+            m_cachedBytes += size;
+            return;
+        }
+    }
+    VirtualFree(data, 0, MEM_RELEASE);
+}
+
+} // namespace core
@@ -0,0 +1,92 @@
+#ifndef ALIGNED_BUFFER_POOL_H
+#define ALIGNED_BUFFER_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+namespace core {
+
+class AlignedBufferPool;
+
+/**
+ * @brief Page-aligned I/O buffer borrowed from AlignedBufferPool.
+ *
+ * Move-only; the memory goes back to the pool when the buffer is destroyed.
+ */
+class AlignedBuffer {
+public:
+    AlignedBuffer() : m_pool(nullptr), m_data(nullptr), m_size(0) {}
+    ~AlignedBuffer() { reset(); }
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept;
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept;
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+    /// @brief Return the memory to the pool
+    void reset();
+
+private:
+    friend class AlignedBufferPool;
+    AlignedBuffer(AlignedBufferPool* pool, uint8_t* data, size_t size)
+        : m_pool(pool), m_data(data), m_size(size) {}
+
+    AlignedBufferPool* m_pool;
+    uint8_t* m_data;
+    size_t m_size;
+};
+
+/**
+ * @brief Process-wide cache of page-aligned read buffers.
+ *
+ * Unbuffered reads (FILE_FLAG_NO_BUFFERING) need sector-aligned memory, and
+ * committing fresh pages for every file of a bulk scan is wasteful. Buffers
+ * are allocated with VirtualAlloc, so they are aligned to the page size,
+ * which is a multiple of every common sector size (512e and 4Kn). Released
+ * buffers are kept for reuse up to MAX_CACHED_BYTES.
+ *
+ * Usage:
+ *   AlignedBuffer buffer = AlignedBufferPool::instance().acquire(1024 * 1024);
+ *   ReadFile(hFile, buffer.data(), static_cast<DWORD>(buffer.size()), ...);
+ */
+class AlignedBufferPool {
+public:
+    /// @brief Upper bound on memory kept around for reuse
+    static constexpr size_t MAX_CACHED_BYTES = 64 * 1024 * 1024;
+
+    static AlignedBufferPool& instance();
+
+    /// @brief Borrow a buffer of at least size bytes, rounded up to the alignment
+    /// @throws std::bad_alloc if memory cannot be committed
+    AlignedBuffer acquire(size_t size);
+
+    /// @return Alignment of every buffer (system page size)
+    static size_t alignment();
+
+    /// @brief Round size up to a multiple of the alignment
+    static size_t alignUp(size_t size);
+
+    AlignedBufferPool(const AlignedBufferPool&) = delete;
+    AlignedBufferPool& operator=(const AlignedBufferPool&) = delete;
+
+private:
+    friend class AlignedBuffer;
+    AlignedBufferPool() : m_cachedBytes(0) {}
+    ~AlignedBufferPool();
+
+    void release(uint8_t* data, size_t size);
+
+    std::mutex m_mutex;
+    std::multimap<size_t, uint8_t*> m_free; // Size -> idle buffer
+    size_t m_cachedBytes;
+};
+
+} // namespace core
+
+#endif // ALIGNED_BUFFER_POOL_H
@@ -0,0 +1,473 @@
+#include "BaoOutboard.h"
+#include "FileReader.h"
+#include "impl/native/BLAKE3Kernels.h"
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <windows.h>
+
+namespace core {
+
+namespace b3 = impl::blake3;
+
+namespace {
+
+// Parent nodes buffered per outboard page before it is written
+constexpr uint64_t NODES_PER_PAGE = 1024;
+
+std::string formatError(const char* what, DWORD error) {
+    std::ostringstream oss;
+    oss << what << " Error code: " << error;
+    return oss.str();
+}
+
+bool readAt(HANDLE hFile, uint64_t offset, void* buffer, size_t length, size_t& bytesRead) {
+    bytesRead = 0;
+    while (bytesRead < length) {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset + bytesRead);
+        overlapped.OffsetHigh = static_cast<DWORD>((offset + bytesRead) >> 32);
+        DWORD chunk = 0;
+        if (!ReadFile(hFile, static_cast<uint8_t*>(buffer) + bytesRead,
+                      static_cast<DWORD>(length - bytesRead), &chunk, &overlapped)) {
+            return GetLastError() == ERROR_HANDLE_EOF;
+        }
+        if (chunk == 0) {
+            break;
+        }
+        bytesRead += chunk;
+    }
+    return true;
+}
+
+bool writeAt(HANDLE hFile, uint64_t offset, const void* buffer, size_t length) {
+    size_t written = 0;
+    while (written < length) {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset + written);
+        overlapped.OffsetHigh = static_cast<DWORD>((offset + written) >> 32);
+        DWORD chunk = 0;
+        if (!WriteFile(hFile, static_cast<const uint8_t*>(buffer) + written,
+                       static_cast<DWORD>(length - written), &chunk, &overlapped) || chunk == 0) {
+            return false;
+        }
+        written += chunk;
+    }
+    return true;
+}
+
+/// @brief Closes a file handle on scope exit
+class HandleGuard {
+public:
+    explicit HandleGuard(HANDLE handle) : m_handle(handle) {}
+    ~HandleGuard() { CloseHandle(m_handle); }
+    HandleGuard(const HandleGuard&) = delete;
+    HandleGuard& operator=(const HandleGuard&) = delete;
+
+private:
+    HANDLE m_handle;
+};
+
+uint64_t groupCount(uint64_t contentLength, uint32_t chunkGroupLog) {
+    const uint64_t groupLen = static_cast<uint64_t>(b3::CHUNK_LEN) << chunkGroupLog;
+    return contentLength == 0 ? 1 : (contentLength - 1) / groupLen + 1;
+}
+
+/// @return Groups under the left child of a node covering count > 1 groups
+uint64_t leftGroups(uint64_t count) {
+    return b3::roundDownToPowerOf2(count - 1);
+}
+
+/// @return Pre-order index of the parent node covering groups [start, start + count)
+uint64_t nodeIndex(uint64_t start, uint64_t count, uint64_t totalGroups) {
+    uint64_t index = 0;
+    uint64_t nodeStart = 0;
+    uint64_t nodeCount = totalGroups;
+    while (nodeStart != start || nodeCount != count) {
+        const uint64_t left = leftGroups(nodeCount);
+        if (start < nodeStart + left) {
+            index += 1;
+            nodeCount = left;
+        } else {
+            index += left;
+            nodeStart += left;
+            nodeCount -= left;
+        }
+    }
+    return index;
+}
+
+void storeCv(const uint32_t cv[8], uint8_t out[b3::OUT_LEN]) {
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            out[i * 4 + j] = static_cast<uint8_t>(cv[i] >> (8 * j));
+        }
+    }
+}
+
+/// @brief Chaining value (or root hash) of a parent node
+void parentCv(const uint8_t node[BaoOutboard::NODE_SIZE], bool root, uint8_t out[b3::OUT_LEN]) {
+    uint32_t cv[8];
+    std::memcpy(cv, b3::IV, sizeof(cv));
+    b3::compressInPlace(cv, node, b3::BLOCK_LEN, 0, b3::PARENT | (root ? b3::ROOT : 0));
+    storeCv(cv, out);
+}
+
+/// @brief Chaining value (or root hash) of one leaf group starting at chunkCounter
+void groupCv(const uint8_t* data, size_t length, uint64_t chunkCounter, bool root,
+             uint8_t out[b3::OUT_LEN]) {
+    if (length <= b3::CHUNK_LEN) {
+        b3::compressChunk(data, length, b3::IV, chunkCounter, 0, out, root);
+        return;
+    }
+    uint8_t node[BaoOutboard::NODE_SIZE];
+    b3::compressSubtreeToParentNode(data, length, b3::IV, chunkCounter, 0, node);
+    parentCv(node, root, out);
+}
+
+/// @brief Places parent nodes at their pre-order positions in the outboard file
+///
+/// Nodes are finished in post-order, so only the pages along the current
+/// path through the tree are partly filled at any time: O(log n) memory
+/// however large the file is. A page is written once all its nodes are in.
+class NodeWriter {
+public:
+    NodeWriter(HANDLE hFile, uint64_t nodeCount) : m_hFile(hFile), m_nodeCount(nodeCount) {}
+
+    void put(uint64_t index, const uint8_t node[BaoOutboard::NODE_SIZE]) {
+        const uint64_t pageIndex = index / NODES_PER_PAGE;
+        Page& page = m_pages[pageIndex];
+        if (page.data.empty()) {
+            page.data.resize(static_cast<size_t>(pageNodes(pageIndex) * BaoOutboard::NODE_SIZE));
+        }
+        std::memcpy(&page.data[static_cast<size_t>(index % NODES_PER_PAGE) * BaoOutboard::NODE_SIZE],
+                    node, BaoOutboard::NODE_SIZE);
+        if (++page.filled == pageNodes(pageIndex)) {
+            write(pageIndex, page);
+            m_pages.erase(pageIndex);
+        }
+    }
+
+    /// @return true if every node has been placed and written
+    bool complete() const { return m_pages.empty(); }
+
+private:
+    struct Page {
+        std::vector<uint8_t> data;
+        uint64_t filled = 0;
+    };
+
+    uint64_t pageNodes(uint64_t pageIndex) const {
+        const uint64_t first = pageIndex * NODES_PER_PAGE;
+        return m_nodeCount - first < NODES_PER_PAGE ? m_nodeCount - first : NODES_PER_PAGE;
+    }
+
+    void write(uint64_t pageIndex, const Page& page) {
+        const uint64_t offset = BaoOutboard::HEADER_SIZE + pageIndex * NODES_PER_PAGE * BaoOutboard::NODE_SIZE;
+        if (!writeAt(m_hFile, offset, page.data.data(), page.data.size())) {
+            throw std::runtime_error(formatError("Cannot write outboard file.", GetLastError()));
+        }
+    }
+
+    HANDLE m_hFile;
+    uint64_t m_nodeCount;
+    std::map<uint64_t, Page> m_pages;
+};
+
+/// @brief Builds the tree bottom-up from group chaining values in file order
+class TreeBuilder {
+public:
+    TreeBuilder(NodeWriter& writer, uint64_t totalGroups) : m_writer(writer), m_totalGroups(totalGroups) {}
+
+    void addGroup(const uint8_t* data, size_t length, uint64_t chunkCounter) {
+        if (m_nextGroup == m_totalGroups) {
+            throw std::runtime_error("File grew while its outboard was created");
+        }
+        Subtree subtree;
+        subtree.start = m_nextGroup++;
+        subtree.count = 1;
+        groupCv(data, length, chunkCounter, m_totalGroups == 1, subtree.cv);
+        m_stack.push_back(subtree);
+
+        // Merge complete subtrees as soon as both halves are known; the node
+        // covering every group is the root and waits for finish()
+        while (m_stack.size() >= 2) {
+            const Subtree& left = m_stack[m_stack.size() - 2];
+            const Subtree& right = m_stack.back();
+            if (left.count != right.count || left.count + right.count == m_totalGroups) {
+                break;
+            }
+            mergeTop(false);
+        }
+    }
+
+    /// @return Root hash
+    std::vector<uint8_t> finish() {
+        if (m_nextGroup != m_totalGroups) {
+            throw std::runtime_error("File shrank while its outboard was created");
+        }
+        // The right edge of a tree whose group count is not a power of two
+        while (m_stack.size() > 1) {
+            mergeTop(m_stack.size() == 2);
+        }
+        return std::vector<uint8_t>(m_stack[0].cv, m_stack[0].cv + b3::OUT_LEN);
+    }
+
+private:
+    struct Subtree {
+        uint8_t cv[b3::OUT_LEN];
+        uint64_t start;
+        uint64_t count;
+    };
+
+    void mergeTop(bool root) {
+        Subtree right = m_stack.back();
+        m_stack.pop_back();
+        Subtree& left = m_stack.back();
+
+        uint8_t node[BaoOutboard::NODE_SIZE];
+        std::memcpy(node, left.cv, b3::OUT_LEN);
+        std::memcpy(node + b3::OUT_LEN, right.cv, b3::OUT_LEN);
+        left.count += right.count;
+        m_writer.put(nodeIndex(left.start, left.count, m_totalGroups), node);
+        parentCv(node, root, left.cv);
+    }
+
+    NodeWriter& m_writer;
+    uint64_t m_totalGroups;
+    uint64_t m_nextGroup = 0;
+    std::vector<Subtree> m_stack;
+};
+
+/// @brief Top-down check of the nodes and groups on the paths to a byte range
+class RangeVerifier {
+public:
+    RangeVerifier(HANDLE hFile, HANDLE hOutboard, uint64_t contentLength, uint32_t chunkGroupLog,
+                  uint64_t firstGroup, uint64_t lastGroup, BaoOutboard::RangeCheck& result)
+        : m_hFile(hFile), m_hOutboard(hOutboard), m_contentLength(contentLength),
+          m_groupLen(static_cast<uint64_t>(b3::CHUNK_LEN) << chunkGroupLog),
+          m_chunksPerGroup(static_cast<uint64_t>(1) << chunkGroupLog),
+          m_firstGroup(firstGroup), m_lastGroup(lastGroup), m_result(result) {}
+
+    bool verify(uint64_t start, uint64_t count, uint64_t index, const uint8_t expected[b3::OUT_LEN],
+                bool root) {
+        uint8_t actual[b3::OUT_LEN];
+        if (count == 1) {
+            const uint64_t offset = start * m_groupLen;
+            const uint64_t remaining = m_contentLength - offset;
+            std::vector<uint8_t> data(static_cast<size_t>(remaining < m_groupLen ? remaining : m_groupLen));
+            read(m_hFile, offset, data, "Cannot read file.");
+            m_result.contentBytesRead += data.size();
+            groupCv(data.data(), data.size(), start * m_chunksPerGroup, root, actual);
+            return std::memcmp(actual, expected, b3::OUT_LEN) == 0;
+        }
+
+        std::vector<uint8_t> node(BaoOutboard::NODE_SIZE);
+        read(m_hOutboard, BaoOutboard::HEADER_SIZE + index * BaoOutboard::NODE_SIZE, node,
+             "Cannot read outboard file.");
+        m_result.outboardBytesRead += node.size();
+        parentCv(node.data(), root, actual);
+        if (std::memcmp(actual, expected, b3::OUT_LEN) != 0) {
+            return false;
+        }
+
+        // Descend only into the children that overlap the range
+        const uint64_t left = leftGroups(count);
+        if (m_firstGroup < start + left &&
+            !verify(start, left, index + 1, node.data(), false)) {
+            return false;
+        }
+        if (m_lastGroup >= start + left &&
+            !verify(start + left, count - left, index + left, node.data() + b3::OUT_LEN, false)) {
+            return false;
+        }
+        return true;
+    }
+
+private:
+    static void read(HANDLE hFile, uint64_t offset, std::vector<uint8_t>& buffer, const char* what) {
+        size_t bytesRead = 0;
+        if (!readAt(hFile, offset, buffer.data(), buffer.size(), bytesRead)) {
+            throw std::runtime_error(formatError(what, GetLastError()));
+        }
+        if (bytesRead != buffer.size()) {
+            throw std::runtime_error("File is shorter than its outboard records");
+        }
+    }
+
+    HANDLE m_hFile;
+    HANDLE m_hOutboard;
+    uint64_t m_contentLength;
+    uint64_t m_groupLen;
+    uint64_t m_chunksPerGroup;
+    uint64_t m_firstGroup;
+    uint64_t m_lastGroup;
+    BaoOutboard::RangeCheck& m_result;
+};
+
+} // namespace
+
+uint64_t BaoOutboard::outboardSize(uint64_t contentLength, uint32_t chunkGroupLog) {
+    return HEADER_SIZE + (groupCount(contentLength, chunkGroupLog) - 1) * NODE_SIZE;
+}
+
+std::vector<uint8_t> BaoOutboard::create(const std::wstring& filePath, const std::wstring& outboardPath,
+                                         uint32_t chunkGroupLog, const ReadOptions& options) {
+    if (chunkGroupLog > MAX_CHUNK_GROUP_LOG) {
+        throw std::invalid_argument("Outboard chunk group log is too large");
+    }
+
+    FileReader reader(filePath, options);
+    const uint64_t contentLength = reader.getFileSize();
+    const uint64_t totalGroups = groupCount(contentLength, chunkGroupLog);
+    const size_t groupLen = b3::CHUNK_LEN << chunkGroupLog;
+    const uint64_t chunksPerGroup = static_cast<uint64_t>(1) << chunkGroupLog;
+
+    // Write beside the target and rename over it: never a half-written outboard
+    std::wstring tempPath = outboardPath + L".tmp";
+    HANDLE hOutboard = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                                   FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hOutboard == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(formatError("Cannot create outboard file.", GetLastError()));
+    }
+
+    std::vector<uint8_t> root;
+    try {
+        HandleGuard guard(hOutboard);
+
+        uint8_t header[HEADER_SIZE];
+        for (size_t i = 0; i < HEADER_SIZE; i++) {
+            header[i] = static_cast<uint8_t>(contentLength >> (8 * i));
+        }
+        if (!writeAt(hOutboard, 0, header, sizeof(header))) {
+            throw std::runtime_error(formatError("Cannot write outboard file.", GetLastError()));
+        }
+
+        NodeWriter writer(hOutboard, totalGroups - 1);
+        TreeBuilder builder(writer, totalGroups);
+
+        // Blocks are cut into groups; a group split between blocks is staged in pending
+        std::vector<uint8_t> pending(groupLen);
+        size_t pendingLen = 0;
+        uint64_t chunkCounter = 0;
+        reader.read([&](const uint8_t* data, size_t length) {
+            if (pendingLen > 0) {
+                const size_t take = groupLen - pendingLen < length ? groupLen - pendingLen : length;
+                std::memcpy(&pending[pendingLen], data, take);
+                pendingLen += take;
+                data += take;
+                length -= take;
+                if (pendingLen < groupLen) {
+                    return;
+                }
+                builder.addGroup(pending.data(), groupLen, chunkCounter);
+                chunkCounter += chunksPerGroup;
+                pendingLen = 0;
+            }
+            while (length >= groupLen) {
+                builder.addGroup(data, groupLen, chunkCounter);
+                chunkCounter += chunksPerGroup;
+                data += groupLen;
+                length -= groupLen;
+            }
+            std::memcpy(pending.data(), data, length);
+            pendingLen = length;
+        });
+        if (pendingLen > 0 || contentLength == 0) {
+            builder.addGroup(pending.data(), pendingLen, chunkCounter);
+        }
+
+        root = builder.finish();
+        if (!writer.complete()) {
+            throw std::runtime_error("Outboard tree is incomplete");
+        }
+        if (!FlushFileBuffers(hOutboard)) {
+            throw std::runtime_error(formatError("Cannot write outboard file.", GetLastError()));
+        }
+    } catch (...) {
+        DeleteFileW(tempPath.c_str());
+        throw;
+    }
+
+    if (!MoveFileExW(tempPath.c_str(), outboardPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        DWORD error = GetLastError();
+        DeleteFileW(tempPath.c_str());
+        throw std::runtime_error(formatError("Cannot replace outboard file.", error));
+    }
+    return root;
+}
+
+BaoOutboard::RangeCheck BaoOutboard::verifyRange(const std::wstring& filePath, const std::wstring& outboardPath,
+                                                 const std::vector<uint8_t>& rootHash,
+                                                 uint64_t offset, uint64_t length) {
+    if (rootHash.size() != b3::OUT_LEN) {
+        throw std::invalid_argument("Root hash must be 32 bytes");
+    }
+
+    HANDLE hOutboard = CreateFileW(outboardPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                   FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hOutboard == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(formatError("Cannot open outboard file.", GetLastError()));
+    }
+    HandleGuard outboardGuard(hOutboard);
+
+    HANDLE hFile = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(formatError("Cannot open file.", GetLastError()));
+    }
+    HandleGuard fileGuard(hFile);
+
+    LARGE_INTEGER outboardLength;
+    LARGE_INTEGER fileLength;
+    if (!GetFileSizeEx(hOutboard, &outboardLength) || !GetFileSizeEx(hFile, &fileLength)) {
+        throw std::runtime_error(formatError("Cannot get file size.", GetLastError()));
+    }
+    const uint64_t outboardBytes = static_cast<uint64_t>(outboardLength.QuadPart);
+    if (outboardBytes < HEADER_SIZE || (outboardBytes - HEADER_SIZE) % NODE_SIZE != 0) {
+        throw std::runtime_error("Outboard file has an invalid size");
+    }
+
+    RangeCheck result;
+    uint8_t header[HEADER_SIZE];
+    size_t bytesRead = 0;
+    if (!readAt(hOutboard, 0, header, sizeof(header), bytesRead) || bytesRead != sizeof(header)) {
+        throw std::runtime_error(formatError("Cannot read outboard file.", GetLastError()));
+    }
+    result.outboardBytesRead += sizeof(header);
+    uint64_t contentLength = 0;
+    for (size_t i = 0; i < HEADER_SIZE; i++) {
+        contentLength |= static_cast<uint64_t>(header[i]) << (8 * i);
+    }
+
+    if (offset > contentLength || length > contentLength - offset) {
+        throw std::invalid_argument("Range lies outside the content");
+    }
+    if (static_cast<uint64_t>(fileLength.QuadPart) != contentLength) {
+        return result;
+    }
+
+    // The smallest group size giving this many leaves; a single-leaf tree has no nodes
+    // to tell group sizes apart, and any of them hashes the whole content the same way
+    const uint64_t totalGroups = (outboardBytes - HEADER_SIZE) / NODE_SIZE + 1;
+    uint32_t chunkGroupLog = 0;
+    while (groupCount(contentLength, chunkGroupLog) != totalGroups) {
+        if (++chunkGroupLog > MAX_CHUNK_GROUP_LOG) {
+            throw std::runtime_error("Outboard file does not match the content length");
+        }
+    }
+
+    const uint64_t groupLen = static_cast<uint64_t>(b3::CHUNK_LEN) << chunkGroupLog;
+    uint64_t firstGroup = offset / groupLen;
+    if (firstGroup == totalGroups) {
+        firstGroup--;  // Empty range at the very end: check the last group
+    }
+    const uint64_t lastGroup = length == 0 ? firstGroup : (offset + length - 1) / groupLen;
+
+    RangeVerifier verifier(hFile, hOutboard, contentLength, chunkGroupLog, firstGroup, lastGroup, result);
+    result.verified = verifier.verify(0, totalGroups, 0, rootHash.data(), true);
+    return result;
+}
+
+} // namespace core
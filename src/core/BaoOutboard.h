@@ -0,0 +1,86 @@
+#ifndef BAO_OUTBOARD_H
+#define BAO_OUTBOARD_H
+
+#include "ReadOptions.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief BLAKE3 outboard hash tree for verified random access (Bao format).
+ *
+ * create() hashes a file with BLAKE3 and writes every parent node of its
+ * hash tree (the two child chaining values, 64 bytes) to a separate
+ * outboard file: an 8-byte little-endian content length followed by the
+ * nodes in pre-order, as Bao does. The root hash is the file's ordinary
+ * BLAKE3 digest. verifyRange() then checks any byte range against the root
+ * hash by reading only the leaves it covers and the O(log n) parent nodes
+ * above them, so trusting a slice of a huge file costs a few kilobytes of
+ * I/O instead of a full read.
+ *
+ * Leaves are groups of 2^chunkGroupLog BLAKE3 chunks (1 KiB each). Group
+ * log 0 is exactly Bao's outboard encoding; the default of 4 (16 KiB
+ * groups) keeps the outboard at 0.4% of the content. The group size is not
+ * stored: it is the only one that gives the outboard's node count for the
+ * content length. The outboard needs no checksum of its own since every
+ * node it holds is authenticated by the root hash.
+ *
+ * Usage:
+ *   std::vector<uint8_t> root = BaoOutboard::create(L"D:\\big.iso", L"D:\\big.iso.obao");
+ *   BaoOutboard::RangeCheck check =
+ *       BaoOutboard::verifyRange(L"D:\\big.iso", L"D:\\big.iso.obao", root, offset, length);
+ *   if (!check.verified) {
+ *       // The range, or the part of the outboard that covers it, was modified
+ *   }
+ */
+class BaoOutboard {
+public:
+    /// @brief Result of verifyRange()
+    struct RangeCheck {
+        bool verified = false;          ///< Range matches the root hash
+        uint64_t contentBytesRead = 0;  ///< Bytes read from the content file
+        uint64_t outboardBytesRead = 0; ///< Bytes read from the outboard file
+    };
+
+    /// @brief Bytes of the content length at the start of an outboard
+    static constexpr size_t HEADER_SIZE = 8;
+
+    /// @brief Bytes of one parent node (left and right chaining values)
+    static constexpr size_t NODE_SIZE = 64;
+
+    /// @brief Default leaf size: 2^4 chunks = 16 KiB
+    static constexpr uint32_t DEFAULT_CHUNK_GROUP_LOG = 4;
+
+    /// @brief Largest leaf size: 2^16 chunks = 64 MiB
+    static constexpr uint32_t MAX_CHUNK_GROUP_LOG = 16;
+
+    /// @return Size of the outboard of contentLength bytes
+    static uint64_t outboardSize(uint64_t contentLength, uint32_t chunkGroupLog = DEFAULT_CHUNK_GROUP_LOG);
+
+    /// @brief Hash a file and write its outboard, atomically replacing any previous one
+    /// @return BLAKE3 root hash (32 bytes), the same as the file's BLAKE3 digest
+    /// @throws std::invalid_argument if chunkGroupLog exceeds MAX_CHUNK_GROUP_LOG
+    /// @throws std::runtime_error if the file cannot be read, changes while it is read,
+    ///         or the outboard cannot be written
+    static std::vector<uint8_t> create(const std::wstring& filePath, const std::wstring& outboardPath,
+                                       uint32_t chunkGroupLog = DEFAULT_CHUNK_GROUP_LOG,
+                                       const ReadOptions& options = ReadOptions());
+
+    /// @brief Check bytes [offset, offset + length) of a file against its root hash
+    ///
+    /// A zero length checks the leaf that holds offset. A file whose size differs
+    /// from the length recorded in the outboard fails verification.
+    /// @param rootHash BLAKE3 digest of the whole file as returned by create()
+    /// @throws std::invalid_argument if rootHash is not 32 bytes or the range lies
+    ///         outside the content
+    /// @throws std::runtime_error if a file cannot be read or the outboard is malformed
+    static RangeCheck verifyRange(const std::wstring& filePath, const std::wstring& outboardPath,
+                                  const std::vector<uint8_t>& rootHash, uint64_t offset, uint64_t length);
+};
+
+} // namespace core
+
+#endif // BAO_OUTBOARD_H
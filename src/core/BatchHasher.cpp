@@ -0,0 +1,495 @@
+#include "BatchHasher.h"
+#include "DigestCache.h"
+#include "DirectoryWalker.h"
+#include "HashAlgorithmFactory.h"
+#include "IBatchHashAlgorithm.h"
+#include "MultiHasher.h"
+#include "ThreadPool.h"
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <windows.h>
+
+namespace core {
+
+namespace {
+
+/// @brief Volume serial number and file index: identifies a file across its hard links
+using FileKey = std::pair<uint64_t, uint64_t>;
+
+/// @brief Outcome of one scheduled path, filled by a worker and read by the caller
+struct Slot {
+    std::wstring path;
+    uint64_t size = 0;
+    std::vector<std::vector<uint8_t>> digests;
+    std::string error;
+    bool cached = false;
+    bool appended = false;
+
+    bool multiLink = false;          // File has more than one hard link
+    FileKey key;                     // Valid if multiLink
+    unsigned long links = 0;         // Hard link count, valid if multiLink
+    std::shared_ptr<Slot> original;  // Set if another slot hashes this file
+
+    std::mutex mutex;
+    std::condition_variable readyChanged;
+    bool ready = false;
+
+    void publish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready = true;
+        }
+        readyChanged.notify_all();
+    }
+
+    void waitReady() {
+        std::unique_lock<std::mutex> lock(mutex);
+        readyChanged.wait(lock, [this]() { return ready; });
+    }
+
+    bool isReady() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ready;
+    }
+};
+
+/// @brief A small file of a group, read and waiting to be hashed with the others
+struct PendingFile {
+    std::shared_ptr<Slot> slot;
+    size_t offset;                  // Contents at WorkerState::groupData + offset
+    size_t length;
+    DigestCache::FileKey cacheKey;
+    bool store;                     // Record the digests in the digest cache
+};
+
+/// @brief Per-worker scratch state, reused for every file the worker hashes
+struct WorkerState {
+    std::unique_ptr<MultiHasher> hasher;
+    std::vector<uint8_t> buffer;
+
+    // Groups of small files: multi-buffer instances by algorithm index (null where
+    // there is none), and a hasher for the other algorithms
+    std::vector<std::unique_ptr<IBatchHashAlgorithm>> batch;
+    std::unique_ptr<MultiHasher> restHasher;
+    std::vector<uint8_t> groupData;
+    std::vector<PendingFile> pending;
+};
+
+/// @brief First slot seen for a multi-link file and how many of its paths were scheduled
+struct LinkOwner {
+    std::shared_ptr<Slot> slot;
+    unsigned long seen;
+};
+
+/// @brief Multi-link files with paths still to come; an entry is dropped once
+///        every link has been seen, so the table does not grow with the tree
+struct LinkTable {
+    std::mutex mutex;
+    std::map<FileKey, LinkOwner> owners;
+};
+
+std::string formatError(const char* what, DWORD error) {
+    std::ostringstream oss;
+    oss << what << " Error code: " << error;
+    return oss.str();
+}
+
+/// @brief Emitted paths of a multi-link file, until every link has been emitted
+struct EmittedLinks {
+    unsigned long seen = 0;
+    bool reported = false; // A path was reported in full
+};
+
+/// @brief Shared, read-only settings of one run
+struct RunContext {
+    ReadOptions readOptions;
+    DigestCache* digestCache;
+    bool appendMode; // Worker hashers consult the cache themselves for large files
+    std::vector<std::string> algorithmNames;
+    std::vector<size_t> restIndices; // Algorithms without a multi-buffer instance, when grouping
+};
+
+/// @param defer Leave small files in state.pending for hashPending() instead of hashing them
+void hashFile(const std::shared_ptr<Slot>& slot, WorkerState& state, LinkTable& links,
+              const RunContext& context, bool defer) {
+    HANDLE hFile = CreateFileW(
+        slot->path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        NULL
+    );
+    if (hFile == INVALID_HANDLE_VALUE) {
+        slot->error = formatError("Cannot open file for hashing.", GetLastError());
+        return;
+    }
+
+    BY_HANDLE_FILE_INFORMATION info;
+    if (!GetFileInformationByHandle(hFile, &info)) {
+        slot->error = formatError("Cannot query file information.", GetLastError());
+        CloseHandle(hFile);
+        return;
+    }
+    slot->size = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+
+    if (info.nNumberOfLinks > 1) {
+        slot->multiLink = true;
+        slot->key = FileKey(info.dwVolumeSerialNumber,
+                            (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow);
+        slot->links = info.nNumberOfLinks;
+
+        std::lock_guard<std::mutex> lock(links.mutex);
+        auto inserted = links.owners.emplace(slot->key, LinkOwner{slot, 0});
+        LinkOwner& owner = inserted.first->second;
+        if (++owner.seen >= slot->links) {
+            // Last path to this file: later duplicates still hold the owner
+            // through their original pointer
+            std::shared_ptr<Slot> first = owner.slot;
+            links.owners.erase(inserted.first);
+            if (!inserted.second) {
+                slot->original = first;
+                CloseHandle(hFile);
+                return;
+            }
+        } else if (!inserted.second) {
+            // Another path to this file is being hashed already
+            slot->original = owner.slot;
+            CloseHandle(hFile);
+            return;
+        }
+    }
+
+    DigestCache::FileKey cacheKey;
+    const bool cacheable = context.digestCache != nullptr && DigestCache::queryFileKey(hFile, cacheKey);
+    if (cacheable && context.digestCache->lookup(cacheKey, context.algorithmNames, slot->digests)) {
+        slot->cached = true;
+        CloseHandle(hFile);
+        return;
+    }
+
+    if (slot->size <= BatchHasher::SMALL_FILE_SIZE) {
+        // Fast path: one read, hash from memory. Read one byte more than the
+        // limit so a file that grew since it was listed is noticed.
+        state.buffer.resize(static_cast<size_t>(BatchHasher::SMALL_FILE_SIZE) + 1);
+        size_t total = 0;
+        DWORD bytesRead = 0;
+        BOOL success;
+        while ((success = ReadFile(hFile, state.buffer.data() + total,
+                                   static_cast<DWORD>(state.buffer.size() - total),
+                                   &bytesRead, NULL)) && bytesRead > 0) {
+            total += bytesRead;
+            if (total == state.buffer.size()) {
+                break;
+            }
+        }
+        DWORD error = success ? 0 : GetLastError();
+        DigestCache::FileKey after;
+        bool unchanged = cacheable && DigestCache::queryFileKey(hFile, after) && after == cacheKey;
+        CloseHandle(hFile);
+
+        if (error != 0) {
+            slot->error = formatError("Error reading file.", error);
+            return;
+        }
+        if (total <= BatchHasher::SMALL_FILE_SIZE) {
+            slot->size = total;
+            if (defer) {
+                state.pending.push_back(PendingFile{slot, state.groupData.size(), total, cacheKey, unchanged});
+                state.groupData.insert(state.groupData.end(), state.buffer.data(), state.buffer.data() + total);
+                return;
+            }
+            slot->digests = state.hasher->computeData(state.buffer.data(), total);
+            if (unchanged) {
+                context.digestCache->store(cacheKey, context.algorithmNames, slot->digests);
+            }
+            return;
+        }
+    } else {
+        CloseHandle(hFile);
+    }
+
+    // Large (or grown) file: stream it through FileReader
+    state.hasher->setReadOptions(context.readOptions);
+    slot->digests = state.hasher->computeFile(slot->path);
+    if (context.appendMode) {
+        slot->appended = state.hasher->getAppendOffset() > 0;
+        return;
+    }
+
+    DigestCache::FileKey after;
+    if (cacheable && DigestCache::queryFileKey(slot->path, after) && after == cacheKey) {
+        context.digestCache->store(cacheKey, context.algorithmNames, slot->digests);
+    }
+}
+
+/// @brief Hash the files hashFile() deferred: every algorithm with a multi-buffer
+///        instance over all of them at once, the others file by file
+void hashPending(WorkerState& state, const RunContext& context) {
+    std::vector<IBatchHashAlgorithm::Message> messages;
+    messages.reserve(state.pending.size());
+    for (PendingFile& file : state.pending) {
+        messages.push_back(IBatchHashAlgorithm::Message{state.groupData.data() + file.offset, file.length});
+        file.slot->digests.resize(context.algorithmNames.size());
+    }
+
+    std::vector<uint8_t> digests;
+    for (size_t index = 0; index < state.batch.size(); index++) {
+        IBatchHashAlgorithm* batch = state.batch[index].get();
+        if (batch == nullptr) {
+            continue;
+        }
+        const size_t digestSize = batch->getDigestSize();
+        digests.resize(messages.size() * digestSize);
+        batch->computeMany(messages.data(), messages.size(), digests.data());
+        for (size_t i = 0; i < state.pending.size(); i++) {
+            const uint8_t* digest = digests.data() + i * digestSize;
+            state.pending[i].slot->digests[index].assign(digest, digest + digestSize);
+        }
+    }
+
+    for (size_t i = 0; !context.restIndices.empty() && i < state.pending.size(); i++) {
+        std::vector<std::vector<uint8_t>> rest = state.restHasher->computeData(messages[i].data, messages[i].length);
+        for (size_t r = 0; r < rest.size(); r++) {
+            state.pending[i].slot->digests[context.restIndices[r]] = std::move(rest[r]);
+        }
+    }
+
+    for (const PendingFile& file : state.pending) {
+        if (file.store) {
+            context.digestCache->store(file.cacheKey, context.algorithmNames, file.slot->digests);
+        }
+    }
+}
+
+} // namespace
+
+BatchHasher::BatchHasher(const std::vector<std::string>& algorithmNames)
+    : m_algorithmNames(algorithmNames),
+      m_threadCount(0),
+      m_digestCache(nullptr),
+      m_appendMode(false) {
+    for (const std::string& name : m_algorithmNames) {
+        if (!HashAlgorithmFactory::isAvailable(name)) {
+            throw std::invalid_argument("Unknown hash algorithm: " + name);
+        }
+    }
+}
+
+void BatchHasher::addFile(const std::wstring& path) {
+    m_inputs.push_back(Input{path, false});
+}
+
+void BatchHasher::addDirectory(const std::wstring& path) {
+    m_inputs.push_back(Input{path, true});
+}
+
+void BatchHasher::run(const ResultCallback& onResult) {
+    // Declared before the pool: queued tasks reference them until the pool is joined
+    const bool appendMode = m_digestCache != nullptr && m_appendMode;
+    RunContext context{m_readOptions, m_digestCache, appendMode, m_algorithmNames, {}};
+    LinkTable links;
+    std::vector<WorkerState> workers;
+    ThreadPool pool(m_threadCount);
+
+    // Small files from directory listings are grouped if any algorithm hashes
+    // many messages at once faster than one at a time on this CPU
+    std::vector<bool> batched(m_algorithmNames.size());
+    bool grouping = false;
+    for (size_t index = 0; index < m_algorithmNames.size(); index++) {
+        batched[index] = HashAlgorithmFactory::createBatch(m_algorithmNames[index]) != nullptr;
+        grouping = grouping || batched[index];
+        if (!batched[index]) {
+            context.restIndices.push_back(index);
+        }
+    }
+
+    workers.resize(pool.getThreadCount());
+    for (WorkerState& worker : workers) {
+        worker.hasher.reset(new MultiHasher());
+        worker.hasher->setThreadCount(1); // Files are the unit of parallelism here
+        for (const std::string& name : m_algorithmNames) {
+            worker.hasher->add(HashAlgorithmFactory::create(name));
+        }
+        if (appendMode) {
+            worker.hasher->setDigestCache(m_digestCache, m_algorithmNames);
+            worker.hasher->setAppendMode(true);
+        }
+
+        if (grouping) {
+            worker.restHasher.reset(new MultiHasher());
+            worker.restHasher->setThreadCount(1);
+            for (size_t index = 0; index < m_algorithmNames.size(); index++) {
+                if (batched[index]) {
+                    worker.batch.push_back(HashAlgorithmFactory::createBatch(m_algorithmNames[index]));
+                } else {
+                    worker.batch.push_back(nullptr);
+                    worker.restHasher->add(HashAlgorithmFactory::create(m_algorithmNames[index]));
+                }
+            }
+        }
+    }
+
+    const size_t window = pool.getThreadCount() * WINDOW_PER_THREAD;
+    std::deque<std::shared_ptr<Slot>> inFlight;
+    std::map<FileKey, EmittedLinks> reportedLinks; // Multi-link files with paths still to come
+    std::vector<std::shared_ptr<Slot>> group;  // Small files not yet submitted
+    uint64_t groupBytes = 0;
+
+    // Deliver the oldest slot to the caller, waiting for it if needed
+    auto emitFront = [&]() {
+        std::shared_ptr<Slot> slot = inFlight.front();
+        inFlight.pop_front();
+        slot->waitReady();
+
+        Result result;
+        result.path = slot->path;
+        result.size = slot->size;
+
+        const Slot* source = slot.get();
+        if (slot->original) {
+            slot->original->waitReady();
+            source = slot->original.get();
+        }
+        result.digests = source->digests;
+        result.error = source->error;
+        result.cached = source->cached;
+        result.appended = source->appended;
+
+        // Whichever link comes first in output order is the one reported in full,
+        // independent of which worker got to the file first
+        if (slot->multiLink) {
+            auto found = reportedLinks.emplace(slot->key, EmittedLinks()).first;
+            EmittedLinks& emitted = found->second;
+            if (result.error.empty()) {
+                result.hardLink = emitted.reported;
+                emitted.reported = true;
+            }
+            if (++emitted.seen >= slot->links) {
+                reportedLinks.erase(found);
+            }
+        }
+
+        onResult(result);
+    };
+
+    std::function<void()> submitGroupFn;
+
+    // Emit whatever has finished in order; stall the walk when too far ahead
+    auto drain = [&]() {
+        while (!inFlight.empty() && (inFlight.size() >= window || inFlight.front()->isReady())) {
+            if (!inFlight.front()->isReady()) {
+                // Never wait for a slot whose group is still being collected
+                submitGroupFn();
+            }
+            emitFront();
+        }
+    };
+
+    auto schedule = [&](const std::wstring& path) {
+        std::shared_ptr<Slot> slot = std::make_shared<Slot>();
+        slot->path = path;
+        inFlight.push_back(slot);
+
+        pool.submit([slot, &workers, &links, &pool, &context]() {
+            try {
+                hashFile(slot, workers[pool.currentWorkerIndex()], links, context, false);
+            } catch (const std::exception& ex) {
+                slot->error = ex.what();
+            }
+            slot->publish();
+        });
+
+        drain();
+    };
+
+    // One task for a whole group of small files
+    auto submitGroup = [&]() {
+        if (group.empty()) {
+            return;
+        }
+        std::vector<std::shared_ptr<Slot>> slots;
+        slots.swap(group);
+        groupBytes = 0;
+
+        pool.submit([slots, &workers, &links, &pool, &context]() {
+            WorkerState& state = workers[pool.currentWorkerIndex()];
+            for (const std::shared_ptr<Slot>& slot : slots) {
+                try {
+                    hashFile(slot, state, links, context, true);
+                } catch (const std::exception& ex) {
+                    slot->error = ex.what();
+                }
+            }
+            try {
+                hashPending(state, context);
+            } catch (const std::exception& ex) {
+                for (PendingFile& file : state.pending) {
+                    file.slot->digests.clear();
+                    file.slot->error = ex.what();
+                }
+            }
+            state.pending.clear();
+            state.groupData.clear();
+            for (const std::shared_ptr<Slot>& slot : slots) {
+                slot->publish();
+            }
+        });
+    };
+    submitGroupFn = submitGroup;
+
+    auto scheduleSmall = [&](const std::wstring& path, uint64_t size) {
+        std::shared_ptr<Slot> slot = std::make_shared<Slot>();
+        slot->path = path;
+        inFlight.push_back(slot);
+        group.push_back(slot);
+        groupBytes += size;
+        if (group.size() >= GROUP_FILES || groupBytes >= GROUP_BYTES) {
+            submitGroup();
+        }
+
+        drain();
+    };
+
+    auto scheduleError = [&](const std::wstring& path, const std::string& error) {
+        std::shared_ptr<Slot> slot = std::make_shared<Slot>();
+        slot->path = path;
+        slot->error = error;
+        slot->ready = true;
+        inFlight.push_back(slot);
+    };
+
+    for (const Input& input : m_inputs) {
+        if (!input.isDirectory) {
+            schedule(input.path);
+            continue;
+        }
+
+        DirectoryWalker walker(input.path);
+        DirectoryWalker::Entry entry;
+        while (walker.next(entry)) {
+            if (entry.error) {
+                scheduleError(entry.path, formatError("Cannot list directory.", entry.errorCode));
+            } else if (grouping && entry.size <= SMALL_FILE_SIZE) {
+                scheduleSmall(entry.path, entry.size);
+            } else {
+                schedule(entry.path);
+            }
+        }
+    }
+
+    submitGroup();
+    while (!inFlight.empty()) {
+        emitFront();
+    }
+    pool.wait();
+}
+
+} // namespace core
@@ -0,0 +1,111 @@
+#ifndef BATCH_HASHER_H
+#define BATCH_HASHER_H
+
+#include "ReadOptions.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace core {
+
+class DigestCache;
+
+/**
+ * @brief Hashes many files and directory trees on a work-stealing pool.
+ *
+ * Inputs are enumerated lazily (see DirectoryWalker) and every file becomes
+ * one ThreadPool task; each worker reuses its own set of algorithm
+ * instances. At most a bounded window of files is in flight, so memory does
+ * not grow with the size of the tree. Results are delivered on the calling
+ * thread in enumeration order no matter which worker finished first.
+ *
+ * Files with several hard links are hashed once: later paths to the same
+ * file (same volume and file index) reuse the digests and are flagged.
+ * Files up to SMALL_FILE_SIZE are read with a single ReadFile and hashed
+ * straight from memory, skipping FileReader's progress and cancellation
+ * machinery. With a DigestCache attached, unchanged files are answered from
+ * the cache without being read, and in append mode large files that have
+ * only grown are hashed from their previous end (see MultiHasher::setAppendMode).
+ *
+ * Small files from directory listings are hashed in groups of up to
+ * GROUP_FILES by one worker when an algorithm has a multi-buffer
+ * implementation on this CPU (HashAlgorithmFactory::createBatch): the group
+ * is read into memory and each such algorithm runs over all of it at once.
+ *
+ * Usage:
+ *   BatchHasher batch({"SHA-256", "MD5"});
+ *   batch.addDirectory(L"C:\\data");
+ *   batch.run([](const BatchHasher::Result& result) { print(result); });
+ */
+class BatchHasher {
+public:
+    /// @brief Largest file taken by the single-read fast path
+    static constexpr uint64_t SMALL_FILE_SIZE = 256 * 1024;
+
+    /// @brief Files queued ahead of the oldest unfinished one, per worker
+    static constexpr size_t WINDOW_PER_THREAD = 64;
+
+    /// @brief Most small files hashed together as one group
+    static constexpr size_t GROUP_FILES = 64;
+
+    /// @brief Listed size at which a group is closed before GROUP_FILES
+    static constexpr uint64_t GROUP_BYTES = 1024 * 1024;
+
+    /// @brief Outcome for one path
+    struct Result {
+        std::wstring path;
+        uint64_t size = 0;
+        std::vector<std::vector<uint8_t>> digests; ///< In algorithm order; empty on error
+        std::string error;                         ///< Non-empty if the path could not be hashed
+        bool hardLink = false;                     ///< Same file as a path reported earlier
+        bool cached = false;                       ///< Digests came from the digest cache
+        bool appended = false;                     ///< Only data appended since a cached run was read
+    };
+
+    using ResultCallback = std::function<void(const Result& result)>;
+
+    /// @param algorithmNames Factory names of the algorithms to compute
+    /// @throws std::invalid_argument if an algorithm is not registered
+    explicit BatchHasher(const std::vector<std::string>& algorithmNames);
+
+    /// @brief Set number of worker threads (0 = ThreadPool::defaultThreadCount())
+    void setThreadCount(size_t threadCount) { m_threadCount = threadCount; }
+
+    /// @brief Set file input options for files above SMALL_FILE_SIZE
+    void setReadOptions(const ReadOptions& options) { m_readOptions = options; }
+
+    /// @brief Look files up in a digest cache and record new digests there
+    /// @param cache Cache to use (not owned), nullptr to disable
+    void setDigestCache(DigestCache* cache) { m_digestCache = cache; }
+
+    /// @brief Continue grown files from their cached end (needs a digest cache)
+    void setAppendMode(bool enabled) { m_appendMode = enabled; }
+
+    /// @brief Queue a single file
+    void addFile(const std::wstring& path);
+
+    /// @brief Queue every file below a directory, recursively
+    void addDirectory(const std::wstring& path);
+
+    /// @brief Hash all queued inputs
+    /// @param onResult Called on the calling thread, once per file, in input order
+    void run(const ResultCallback& onResult);
+
+private:
+    struct Input {
+        std::wstring path;
+        bool isDirectory;
+    };
+
+    std::vector<std::string> m_algorithmNames;
+    std::vector<Input> m_inputs;
+    size_t m_threadCount;
+    ReadOptions m_readOptions;
+    DigestCache* m_digestCache;
+    bool m_appendMode;
+};
+
+} // namespace core
+
+#endif // BATCH_HASHER_H
@@ -0,0 +1,195 @@
+#include "CheckpointFile.h"
+#include <sstream>
+#include <stdexcept>
+#include <windows.h>
+
+namespace core {
+
+namespace {
+
+constexpr uint32_t CHECKPOINT_MAGIC = 0x4B434348; // "HCCK"
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint64_t MAX_FILE_SIZE = 16 * 1024 * 1024;
+
+std::string formatError(const char* what, DWORD error) {
+    std::ostringstream oss;
+    oss << what << " Error code: " << error;
+    return oss.str();
+}
+
+uint32_t checksum(const uint8_t* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void putU16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+/// @brief Bounds-checked little-endian reader over the checkpoint contents
+class Parser {
+public:
+    Parser(const uint8_t* data, size_t length) : m_data(data), m_length(length), m_pos(0) {}
+
+    const uint8_t* take(size_t length) {
+        if (length > m_length - m_pos) {
+            throw std::runtime_error("Checkpoint file is truncated");
+        }
+        const uint8_t* data = m_data + m_pos;
+        m_pos += length;
+        return data;
+    }
+
+    uint64_t get(size_t bytes) {
+        const uint8_t* data = take(bytes);
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; i++) {
+            value |= static_cast<uint64_t>(data[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    bool atEnd() const { return m_pos == m_length; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_length;
+    size_t m_pos;
+};
+
+} // namespace
+
+void CheckpointFile::save(const std::wstring& path, const std::vector<std::string>& names,
+                          const MultiHasher::Checkpoint& checkpoint) {
+    if (names.size() != checkpoint.states.size()) {
+        throw std::invalid_argument("Checkpoint names do not match its states");
+    }
+
+    std::vector<uint8_t> data;
+    putU32(data, CHECKPOINT_MAGIC);
+    putU32(data, FORMAT_VERSION);
+    putU64(data, checkpoint.file.volumeSerial);
+    putU64(data, checkpoint.file.fileIndex);
+    putU64(data, checkpoint.file.size);
+    putU64(data, checkpoint.file.lastWriteTime);
+    putU64(data, checkpoint.file.changeTime);
+    putU64(data, checkpoint.offset);
+    putU32(data, static_cast<uint32_t>(names.size()));
+    for (size_t i = 0; i < names.size(); i++) {
+        putU16(data, static_cast<uint16_t>(names[i].size()));
+        data.insert(data.end(), names[i].begin(), names[i].end());
+        putU32(data, static_cast<uint32_t>(checkpoint.states[i].size()));
+        data.insert(data.end(), checkpoint.states[i].begin(), checkpoint.states[i].end());
+    }
+    putU32(data, checksum(data.data(), data.size()));
+
+    // Write beside the target and rename over it: never a half-written checkpoint
+    std::wstring tempPath = path + L".tmp";
+    HANDLE hFile = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(formatError("Cannot create checkpoint file.", GetLastError()));
+    }
+    DWORD written = 0;
+    BOOL success = WriteFile(hFile, data.data(), static_cast<DWORD>(data.size()), &written, NULL) &&
+                   written == data.size() && FlushFileBuffers(hFile);
+    DWORD error = success ? 0 : GetLastError();
+    CloseHandle(hFile);
+    if (!success) {
+        DeleteFileW(tempPath.c_str());
+        throw std::runtime_error(formatError("Cannot write checkpoint file.", error));
+    }
+
+    if (!MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        error = GetLastError();
+        DeleteFileW(tempPath.c_str());
+        throw std::runtime_error(formatError("Cannot replace checkpoint file.", error));
+    }
+}
+
+bool CheckpointFile::load(const std::wstring& path, std::vector<std::string>& names,
+                          MultiHasher::Checkpoint& checkpoint) {
+    HANDLE hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        DWORD error = GetLastError();
+        if (error == ERROR_FILE_NOT_FOUND) {
+            return false;
+        }
+        throw std::runtime_error(formatError("Cannot open checkpoint file.", error));
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart < 8 ||
+        static_cast<uint64_t>(fileSize.QuadPart) > MAX_FILE_SIZE) {
+        CloseHandle(hFile);
+        throw std::runtime_error("Checkpoint file has an invalid size");
+    }
+    std::vector<uint8_t> data(static_cast<size_t>(fileSize.QuadPart));
+    DWORD bytesRead = 0;
+    BOOL success = ReadFile(hFile, data.data(), static_cast<DWORD>(data.size()), &bytesRead, NULL);
+    DWORD error = success ? 0 : GetLastError();
+    CloseHandle(hFile);
+    if (!success) {
+        throw std::runtime_error(formatError("Cannot read checkpoint file.", error));
+    }
+    if (bytesRead != data.size()) {
+        throw std::runtime_error("Checkpoint file is truncated");
+    }
+
+    const size_t bodyLength = data.size() - sizeof(uint32_t);
+    Parser trailer(data.data() + bodyLength, sizeof(uint32_t));
+    if (trailer.get(4) != checksum(data.data(), bodyLength)) {
+        throw std::runtime_error("Checkpoint file is damaged");
+    }
+
+    Parser parser(data.data(), bodyLength);
+    if (parser.get(4) != CHECKPOINT_MAGIC || parser.get(4) != FORMAT_VERSION) {
+        throw std::runtime_error("Not a checkpoint file of this version");
+    }
+    checkpoint.file.volumeSerial = parser.get(8);
+    checkpoint.file.fileIndex = parser.get(8);
+    checkpoint.file.size = parser.get(8);
+    checkpoint.file.lastWriteTime = parser.get(8);
+    checkpoint.file.changeTime = parser.get(8);
+    checkpoint.offset = parser.get(8);
+
+    size_t count = static_cast<size_t>(parser.get(4));
+    names.clear();
+    checkpoint.states.clear();
+    for (size_t i = 0; i < count; i++) {
+        size_t nameLength = static_cast<size_t>(parser.get(2));
+        const uint8_t* name = parser.take(nameLength);
+        names.emplace_back(reinterpret_cast<const char*>(name), nameLength);
+
+        size_t stateLength = static_cast<size_t>(parser.get(4));
+        const uint8_t* state = parser.take(stateLength);
+        checkpoint.states.emplace_back(state, state + stateLength);
+    }
+    if (!parser.atEnd()) {
+        throw std::runtime_error("Checkpoint file is damaged");
+    }
+    return true;
+}
+
+void CheckpointFile::remove(const std::wstring& path) {
+    DeleteFileW(path.c_str());
+}
+
+} // namespace core
@@ -0,0 +1,46 @@
+#ifndef CHECKPOINT_FILE_H
+#define CHECKPOINT_FILE_H
+
+#include "MultiHasher.h"
+#include <string>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief On-disk form of a MultiHasher checkpoint (console --resume).
+ *
+ * Holds the file identity, the offset, and the factory name and saved state
+ * of every algorithm, followed by a checksum. save() writes a temporary file
+ * and renames it over the old checkpoint, so an interruption at any moment
+ * leaves either the previous or the new checkpoint intact.
+ *
+ * Usage:
+ *   hasher.setCheckpointCallback([&](const MultiHasher::Checkpoint& checkpoint) {
+ *       CheckpointFile::save(path, names, checkpoint);
+ *   });
+ *   if (CheckpointFile::load(path, savedNames, checkpoint) && savedNames == names) {
+ *       digests = hasher.resumeFile(filePath, checkpoint);
+ *   }
+ */
+class CheckpointFile {
+public:
+    /// @brief Write a checkpoint, atomically replacing any previous one
+    /// @param names Factory algorithm names in add() order
+    /// @throws std::runtime_error if the file cannot be written
+    static void save(const std::wstring& path, const std::vector<std::string>& names,
+                     const MultiHasher::Checkpoint& checkpoint);
+
+    /// @brief Read a checkpoint
+    /// @return false if there is no checkpoint at path
+    /// @throws std::runtime_error if the file cannot be read or is damaged
+    static bool load(const std::wstring& path, std::vector<std::string>& names,
+                     MultiHasher::Checkpoint& checkpoint);
+
+    /// @brief Delete a checkpoint once the file has been hashed completely
+    static void remove(const std::wstring& path);
+};
+
+} // namespace core
+
+#endif // CHECKPOINT_FILE_H
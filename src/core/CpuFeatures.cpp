@@ -0,0 +1,123 @@
+#include "CpuFeatures.h"
+#include <cstdint>
+
+#if defined(HASHCALC_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(HASHCALC_ARM64)
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+namespace core {
+
+namespace {
+
+#if defined(HASHCALC_X86)
+
+struct CpuidResult {
+    uint32_t eax = 0;
+    uint32_t ebx = 0;
+    uint32_t ecx = 0;
+    uint32_t edx = 0;
+};
+
+CpuidResult cpuid(uint32_t leaf, uint32_t subleaf) {
+    CpuidResult result;
+#if defined(_MSC_VER)
+    int registers[4];
+    __cpuidex(registers, static_cast<int>(leaf), static_cast<int>(subleaf));
+    result.eax = static_cast<uint32_t>(registers[0]);
+    result.ebx = static_cast<uint32_t>(registers[1]);
+    result.ecx = static_cast<uint32_t>(registers[2]);
+    result.edx = static_cast<uint32_t>(registers[3]);
+#else
+    __cpuid_count(leaf, subleaf, result.eax, result.ebx, result.ecx, result.edx);
+#endif
+    return result;
+}
+
+/// @brief Register state the OS saves on context switches (XCR0)
+uint64_t enabledRegisterState() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax = 0;
+    uint32_t edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+CpuFeatures detect() {
+    CpuFeatures features;
+    const uint32_t maxLeaf = cpuid(0, 0).eax;
+    if (maxLeaf < 1) {
+        return features;
+    }
+
+    const CpuidResult leaf1 = cpuid(1, 0);
+    features.sse2 = (leaf1.edx & (1u << 26)) != 0;
+    features.ssse3 = (leaf1.ecx & (1u << 9)) != 0;
+    features.sse41 = (leaf1.ecx & (1u << 19)) != 0;
+    features.sse42 = (leaf1.ecx & (1u << 20)) != 0;
+    features.pclmul = (leaf1.ecx & (1u << 1)) != 0;
+
+    // XMM and YMM state (bits 1-2), then opmask and ZMM state (bits 5-7)
+    const bool osxsave = (leaf1.ecx & (1u << 27)) != 0;
+    const uint64_t xcr0 = osxsave ? enabledRegisterState() : 0;
+    const bool ymmEnabled = (xcr0 & 0x06) == 0x06;
+    const bool zmmEnabled = ymmEnabled && (xcr0 & 0xE0) == 0xE0;
+    features.avx = ymmEnabled && (leaf1.ecx & (1u << 28)) != 0;
+
+    if (maxLeaf >= 7) {
+        const CpuidResult leaf7 = cpuid(7, 0);
+        features.avx2 = features.avx && (leaf7.ebx & (1u << 5)) != 0;
+        features.bmi2 = (leaf7.ebx & (1u << 8)) != 0;
+        features.avx512f = zmmEnabled && (leaf7.ebx & (1u << 16)) != 0;
+        features.sha = (leaf7.ebx & (1u << 29)) != 0;
+        features.avx512bw = features.avx512f && (leaf7.ebx & (1u << 30)) != 0;
+        features.avx512vl = features.avx512f && (leaf7.ebx & (1u << 31)) != 0;
+        features.vpclmulqdq = features.avx && (leaf7.ecx & (1u << 10)) != 0;
+    }
+    return features;
+}
+
+#elif defined(HASHCALC_ARM64)
+
+CpuFeatures detect() {
+    CpuFeatures features;
+#if defined(_WIN32)
+    features.armCrc32 = IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE) != 0;
+    features.armPmull = IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0;
+#else
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+    features.armCrc32 = (hwcap & HWCAP_CRC32) != 0;
+    features.armPmull = (hwcap & HWCAP_PMULL) != 0;
+#endif
+    return features;
+}
+
+#else
+
+CpuFeatures detect() {
+    return CpuFeatures();
+}
+
+#endif
+
+} // namespace
+
+const CpuFeatures& CpuFeatures::get() {
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+} // namespace core
@@ -0,0 +1,61 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+// x86 and x64 builds can carry SIMD kernels selected at run time
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define HASHCALC_X86 1
+#endif
+
+// ARM64 builds (Windows on ARM) likewise
+#if defined(_M_ARM64) || defined(__aarch64__)
+#define HASHCALC_ARM64 1
+#endif
+
+// Compile one function for an instruction set extension. MSVC accepts every
+// intrinsic without this; GCC and Clang need it per function.
+#if defined(__GNUC__) || defined(__clang__)
+#define HASHCALC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define HASHCALC_TARGET(isa)
+#endif
+
+namespace core {
+
+/**
+ * @brief Instruction set extensions usable by this process.
+ *
+ * Detected once with CPUID. AVX and AVX-512 additionally require the
+ * operating system to save the wider registers on context switches
+ * (checked with XGETBV), so a flag is only set if the kernel can actually
+ * run. On ARM64 only armCrc32 and armPmull are detected; every other flag is false
+ * there, and every flag is false on other architectures.
+ *
+ * Usage:
+ *   if (CpuFeatures::get().avx2) {
+ *       hashMany8Avx2(...);  // defined with HASHCALC_TARGET("avx2")
+ *   }
+ */
+struct CpuFeatures {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sse42 = false;
+    bool pclmul = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool bmi2 = false;
+    bool avx512f = false;
+    bool avx512vl = false;
+    bool avx512bw = false;
+    bool vpclmulqdq = false;
+    bool sha = false;        // SHA-1/SHA-256 extensions (SHA-NI)
+    bool armCrc32 = false;   // ARMv8 CRC32/CRC32C instructions
+    bool armPmull = false;   // ARMv8 64-bit polynomial multiply (crypto extension)
+
+    /// @return Features of the CPU the process runs on
+    static const CpuFeatures& get();
+};
+
+} // namespace core
+
+#endif // CPU_FEATURES_H
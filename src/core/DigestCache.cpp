@@ -0,0 +1,830 @@
+#include "DigestCache.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <windows.h>
+
+namespace core {
+
+namespace {
+
+constexpr uint32_t INDEX_MAGIC = 0x49444348;  // "HCDI"
+constexpr uint32_t LOG_MAGIC = 0x4C444348;    // "HCDL"
+constexpr uint32_t RECORD_MAGIC = 0x52444348; // "HCDR"
+constexpr uint32_t FORMAT_VERSION = 2;
+
+constexpr uint32_t STATE_CLEAN = 0;
+constexpr uint32_t STATE_REBUILDING = 1; // Slots or log being rewritten; reset if seen on open
+
+constexpr uint64_t INITIAL_CAPACITY = 64 * 1024;
+constexpr uint64_t LOG_HEADER_SIZE = 16;
+constexpr uint64_t MAX_RECORD_SIZE = 1024 * 1024; // Room for saved algorithm states
+constexpr size_t FIRST_READ_SIZE = 1024; // Enough for a typical record in one read
+
+// The lock lives far beyond the end of the index so it never blocks I/O on it
+constexpr DWORD LOCK_OFFSET_HIGH = 0x7FFFFFFF;
+
+struct LogHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t reserved;
+};
+
+/// @brief Fixed part of a log record; followed by entryCount entries of
+///        {uint8 nameLength, uint8 digestLength, name, digest}, then stateCount
+///        entries of {uint8 nameLength, uint32 stateLength, name, state}, padded to 8 bytes
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t length;
+    uint64_t volumeSerial;
+    uint64_t fileIndex;
+    uint64_t size;
+    uint64_t lastWriteTime;
+    uint64_t changeTime;
+    uint32_t entryCount;
+    uint32_t stateCount;
+    uint64_t fingerprint; // DigestCache::Tail::fingerprint, valid if stateCount > 0
+    uint32_t checksum;    // FNV-1a of the whole record with this field zeroed
+    uint32_t reserved;
+};
+
+constexpr size_t STATE_ENTRY_HEADER_SIZE = 5;
+
+uint32_t getU32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | static_cast<uint32_t>(in[1]) << 8 |
+           static_cast<uint32_t>(in[2]) << 16 | static_cast<uint32_t>(in[3]) << 24;
+}
+
+std::string formatError(const char* what, DWORD error) {
+    std::ostringstream oss;
+    oss << what << " Error code: " << error;
+    return oss.str();
+}
+
+uint64_t tagOf(const DigestCache::FileKey& key) {
+    // splitmix64 finalizer over the file identity; 0 marks an empty slot
+    uint64_t x = key.volumeSerial * 0x9E3779B97F4A7C15ULL ^ key.fileIndex;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x != 0 ? x : 1;
+}
+
+uint32_t recordChecksum(const uint8_t* data, size_t length) {
+    const size_t skip = offsetof(RecordHeader, checksum);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t byte = (i >= skip && i < skip + sizeof(uint32_t)) ? 0 : data[i];
+        hash = (hash ^ byte) * 16777619u;
+    }
+    return hash;
+}
+
+bool readAt(HANDLE hFile, uint64_t offset, void* buffer, size_t length, size_t& bytesRead) {
+    bytesRead = 0;
+    while (bytesRead < length) {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset + bytesRead);
+        overlapped.OffsetHigh = static_cast<DWORD>((offset + bytesRead) >> 32);
+        DWORD chunk = 0;
+        if (!ReadFile(hFile, static_cast<uint8_t*>(buffer) + bytesRead,
+                      static_cast<DWORD>(length - bytesRead), &chunk, &overlapped)) {
+            return GetLastError() == ERROR_HANDLE_EOF;
+        }
+        if (chunk == 0) {
+            break;
+        }
+        bytesRead += chunk;
+    }
+    return true;
+}
+
+bool writeAt(HANDLE hFile, uint64_t offset, const void* buffer, size_t length) {
+    size_t written = 0;
+    while (written < length) {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset + written);
+        overlapped.OffsetHigh = static_cast<DWORD>((offset + written) >> 32);
+        DWORD chunk = 0;
+        if (!WriteFile(hFile, static_cast<const uint8_t*>(buffer) + written,
+                       static_cast<DWORD>(length - written), &chunk, &overlapped) || chunk == 0) {
+            return false;
+        }
+        written += chunk;
+    }
+    return true;
+}
+
+bool truncateAt(HANDLE hFile, uint64_t size) {
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(size);
+    return SetFilePointerEx(hFile, position, NULL, FILE_BEGIN) && SetEndOfFile(hFile);
+}
+
+} // namespace
+
+struct DigestCache::IndexHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;  // Slot count, a power of two
+    uint64_t count;     // Occupied slots
+    uint64_t logSize;   // End of the last complete record; appends go here
+    uint64_t liveBytes; // Bytes of the log referenced by slots
+    uint32_t state;
+    uint32_t reserved;
+    uint64_t padding[2];
+};
+
+struct DigestCache::Slot {
+    uint64_t tag;    // tagOf() of the file, 0 = empty
+    uint64_t offset; // Record offset in the log
+};
+
+/// @brief Cross-process lock on the index file, released on destruction
+class DigestCache::FileLock {
+public:
+    explicit FileLock(void* hFile) : m_hFile(hFile), m_locked(false) {}
+    ~FileLock() { release(); }
+
+    bool acquire(bool exclusive) {
+        OVERLAPPED overlapped = {};
+        overlapped.OffsetHigh = LOCK_OFFSET_HIGH;
+        m_locked = LockFileEx(m_hFile, exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, 1, 0, &overlapped) != FALSE;
+        return m_locked;
+    }
+
+    void release() {
+        if (m_locked) {
+            OVERLAPPED overlapped = {};
+            overlapped.OffsetHigh = LOCK_OFFSET_HIGH;
+            UnlockFileEx(m_hFile, 0, 1, 0, &overlapped);
+            m_locked = false;
+        }
+    }
+
+private:
+    void* m_hFile;
+    bool m_locked;
+};
+
+DigestCache::DigestCache(const std::wstring& path)
+    : m_hLog(INVALID_HANDLE_VALUE),
+      m_hIndex(INVALID_HANDLE_VALUE),
+      m_hMapping(NULL),
+      m_header(nullptr),
+      m_slots(nullptr),
+      m_capacity(0) {
+    const DWORD share = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+    m_hLog = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, share, NULL,
+                         OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_hLog == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(formatError("Cannot open digest cache.", GetLastError()));
+    }
+
+    m_hIndex = CreateFileW((path + L".idx").c_str(), GENERIC_READ | GENERIC_WRITE, share, NULL,
+                           OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_hIndex == INVALID_HANDLE_VALUE) {
+        DWORD error = GetLastError();
+        CloseHandle(m_hLog);
+        throw std::runtime_error(formatError("Cannot open digest cache index.", error));
+    }
+
+    try {
+        FileLock fileLock(m_hIndex);
+        if (!fileLock.acquire(true)) {
+            throw std::runtime_error(formatError("Cannot lock digest cache.", GetLastError()));
+        }
+        initializeLocked();
+
+        if (m_header->logSize > AUTO_COMPACT_SIZE && m_header->liveBytes * 2 < m_header->logSize) {
+            compactLocked();
+        }
+    } catch (...) {
+        unmapIndex();
+        CloseHandle(m_hIndex);
+        CloseHandle(m_hLog);
+        throw;
+    }
+}
+
+DigestCache::~DigestCache() {
+    unmapIndex();
+    CloseHandle(m_hIndex);
+    CloseHandle(m_hLog);
+}
+
+std::wstring DigestCache::defaultPath() {
+    wchar_t buffer[MAX_PATH];
+    DWORD length = GetEnvironmentVariableW(L"LOCALAPPDATA", buffer, MAX_PATH);
+    if (length == 0 || length >= MAX_PATH) {
+        length = GetTempPathW(MAX_PATH, buffer);
+    }
+
+    std::wstring directory(buffer, length);
+    if (!directory.empty() && directory.back() != L'\\') {
+        directory += L'\\';
+    }
+    directory += L"HashCalc";
+    CreateDirectoryW(directory.c_str(), NULL); // Fails harmlessly if it exists
+    return directory + L"\\digests.cache";
+}
+
+bool DigestCache::queryFileKey(void* hFile, FileKey& key) {
+    BY_HANDLE_FILE_INFORMATION info;
+    FILE_BASIC_INFO basic;
+    if (!GetFileInformationByHandle(hFile, &info) ||
+        !GetFileInformationByHandleEx(hFile, FileBasicInfo, &basic, sizeof(basic))) {
+        return false;
+    }
+
+    key.volumeSerial = info.dwVolumeSerialNumber;
+    key.fileIndex = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+    key.size = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    // ChangeTime also moves on metadata changes that leave LastWriteTime alone
+    key.lastWriteTime = static_cast<uint64_t>(basic.LastWriteTime.QuadPart);
+    key.changeTime = static_cast<uint64_t>(basic.ChangeTime.QuadPart);
+    return true;
+}
+
+bool DigestCache::queryFileKey(const std::wstring& path, FileKey& key) {
+    HANDLE hFile = CreateFileW(path.c_str(), FILE_READ_ATTRIBUTES,
+                               FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    bool success = queryFileKey(hFile, key);
+    CloseHandle(hFile);
+    return success;
+}
+
+bool DigestCache::fingerprint(const std::wstring& path, uint64_t end, uint64_t& value) {
+    HANDLE hFile = CreateFileW(path.c_str(), GENERIC_READ,
+                               FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    const uint64_t start = end > FINGERPRINT_SIZE ? end - FINGERPRINT_SIZE : 0;
+    std::vector<uint8_t> buffer(static_cast<size_t>(end - start));
+    size_t bytesRead = 0;
+    bool success = readAt(hFile, start, buffer.data(), buffer.size(), bytesRead) && bytesRead == buffer.size();
+    CloseHandle(hFile);
+    if (!success) {
+        return false;
+    }
+
+    // FNV-1a, 64-bit: guards against rewrites, not against deliberate collisions
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint8_t byte : buffer) {
+        hash = (hash ^ byte) * 1099511628211ULL;
+    }
+    value = hash;
+    return true;
+}
+
+bool DigestCache::isSettled(const FileKey& key) {
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+    uint64_t nowTime = (static_cast<uint64_t>(now.dwHighDateTime) << 32) | now.dwLowDateTime;
+    return nowTime >= key.lastWriteTime + RACY_INTERVAL && nowTime >= key.changeTime + RACY_INTERVAL;
+}
+
+bool DigestCache::lookup(const FileKey& key, const std::vector<std::string>& names,
+                         std::vector<std::vector<uint8_t>>& digests) {
+    digests.clear();
+    if (names.empty()) {
+        return false;
+    }
+
+    try {
+        Probe probe;
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex, std::defer_lock);
+            FileLock fileLock(m_hIndex);
+            if (!lockShared(lock, fileLock)) {
+                return false;
+            }
+            probe = findSlot(key);
+        }
+
+        if (!probe.matched || probe.key != key) {
+            return false;
+        }
+
+        for (const std::string& name : names) {
+            auto it = std::find_if(probe.entries.begin(), probe.entries.end(),
+                                   [&name](const Entry& entry) { return entry.name == name; });
+            if (it == probe.entries.end()) {
+                digests.clear();
+                return false;
+            }
+            digests.push_back(std::move(it->digest));
+        }
+        return true;
+    } catch (const std::exception&) {
+        digests.clear();
+        return false;
+    }
+}
+
+bool DigestCache::lookupTail(const FileKey& key, const std::vector<std::string>& names, Tail& tail) {
+    tail.states.clear();
+    if (names.empty()) {
+        return false;
+    }
+
+    try {
+        Probe probe;
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex, std::defer_lock);
+            FileLock fileLock(m_hIndex);
+            if (!lockShared(lock, fileLock)) {
+                return false;
+            }
+            probe = findSlot(key);
+        }
+
+        if (!probe.matched) {
+            return false;
+        }
+
+        for (const std::string& name : names) {
+            auto it = std::find_if(probe.states.begin(), probe.states.end(),
+                                   [&name](const StateEntry& entry) { return entry.name == name; });
+            if (it == probe.states.end()) {
+                tail.states.clear();
+                return false;
+            }
+            tail.states.push_back(std::move(it->state));
+        }
+        tail.key = probe.key;
+        tail.fingerprint = probe.fingerprint;
+        return true;
+    } catch (const std::exception&) {
+        tail.states.clear();
+        return false;
+    }
+}
+
+void DigestCache::store(const FileKey& key, const std::vector<std::string>& names,
+                        const std::vector<std::vector<uint8_t>>& digests, const Tail* tail) {
+    if (names.empty() || names.size() != digests.size()) {
+        return;
+    }
+    if (tail != nullptr && (tail->key != key || tail->states.size() != names.size())) {
+        tail = nullptr;
+    }
+
+    // Digests rely on the timestamps to notice changes, so racy files get none;
+    // states are only used after their fingerprint has been checked
+    const bool settled = isSettled(key);
+    if (!settled && tail == nullptr) {
+        return;
+    }
+
+    std::vector<Entry> entries;
+    std::vector<StateEntry> states;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i].size() > 255) {
+            continue;
+        }
+        if (settled && digests[i].size() <= 255) {
+            entries.push_back(Entry{names[i], digests[i]});
+        }
+        if (tail != nullptr) {
+            states.push_back(StateEntry{names[i], tail->states[i]});
+        }
+    }
+
+    try {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        FileLock fileLock(m_hIndex);
+        if (!fileLock.acquire(true)) {
+            return;
+        }
+        refreshMappingLocked();
+
+        Probe probe = findSlot(key);
+        if (probe.slot == nullptr) {
+            return;
+        }
+
+        // Keep what is known about other algorithms for the same version of the file
+        uint64_t fingerprint = tail != nullptr ? tail->fingerprint : 0;
+        if (probe.matched && probe.key == key) {
+            for (Entry& cached : probe.entries) {
+                bool replaced = std::any_of(entries.begin(), entries.end(),
+                                            [&cached](const Entry& entry) { return entry.name == cached.name; });
+                if (settled && !replaced) {
+                    entries.push_back(std::move(cached));
+                }
+            }
+            if (tail == nullptr || tail->fingerprint == probe.fingerprint) {
+                for (StateEntry& cached : probe.states) {
+                    bool replaced = std::any_of(states.begin(), states.end(),
+                                                [&cached](const StateEntry& entry) { return entry.name == cached.name; });
+                    if (!replaced) {
+                        states.push_back(std::move(cached));
+                    }
+                }
+                fingerprint = probe.fingerprint;
+            }
+        }
+
+        size_t length = sizeof(RecordHeader);
+        for (const Entry& entry : entries) {
+            length += 2 + entry.name.size() + entry.digest.size();
+        }
+        for (const StateEntry& entry : states) {
+            length += STATE_ENTRY_HEADER_SIZE + entry.name.size() + entry.state.size();
+        }
+        length = (length + 7) & ~static_cast<size_t>(7);
+        if ((entries.empty() && states.empty()) || length > MAX_RECORD_SIZE) {
+            return;
+        }
+
+        std::vector<uint8_t> record(length, 0);
+        RecordHeader header = {};
+        header.magic = RECORD_MAGIC;
+        header.length = static_cast<uint32_t>(length);
+        header.volumeSerial = key.volumeSerial;
+        header.fileIndex = key.fileIndex;
+        header.size = key.size;
+        header.lastWriteTime = key.lastWriteTime;
+        header.changeTime = key.changeTime;
+        header.entryCount = static_cast<uint32_t>(entries.size());
+        header.stateCount = static_cast<uint32_t>(states.size());
+        header.fingerprint = fingerprint;
+        std::memcpy(record.data(), &header, sizeof(header));
+
+        uint8_t* out = record.data() + sizeof(RecordHeader);
+        for (const Entry& entry : entries) {
+            *out++ = static_cast<uint8_t>(entry.name.size());
+            *out++ = static_cast<uint8_t>(entry.digest.size());
+            std::memcpy(out, entry.name.data(), entry.name.size());
+            out += entry.name.size();
+            std::memcpy(out, entry.digest.data(), entry.digest.size());
+            out += entry.digest.size();
+        }
+        for (const StateEntry& entry : states) {
+            const uint32_t stateLength = static_cast<uint32_t>(entry.state.size());
+            *out++ = static_cast<uint8_t>(entry.name.size());
+            for (int i = 0; i < 4; i++) {
+                *out++ = static_cast<uint8_t>(stateLength >> (8 * i));
+            }
+            std::memcpy(out, entry.name.data(), entry.name.size());
+            out += entry.name.size();
+            std::memcpy(out, entry.state.data(), entry.state.size());
+            out += entry.state.size();
+        }
+        header.checksum = recordChecksum(record.data(), record.size());
+        std::memcpy(record.data() + offsetof(RecordHeader, checksum), &header.checksum, sizeof(uint32_t));
+
+        // Append first, publish second: a crash in between only leaks log space
+        uint64_t offset = m_header->logSize;
+        if (!writeAt(m_hLog, offset, record.data(), record.size())) {
+            return;
+        }
+        m_header->logSize = offset + record.size();
+        m_header->liveBytes += record.size() - probe.length;
+
+        bool isNew = probe.slot->tag == 0;
+        probe.slot->offset = offset;
+        probe.slot->tag = tagOf(key);
+
+        if (isNew && ++m_header->count * 10 > m_capacity * 7) {
+            growLocked();
+        }
+    } catch (const std::exception&) {
+        // A cache that cannot be written is just a cache that misses
+    }
+}
+
+void DigestCache::compact() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    FileLock fileLock(m_hIndex);
+    if (!fileLock.acquire(true)) {
+        throw std::runtime_error(formatError("Cannot lock digest cache.", GetLastError()));
+    }
+    refreshMappingLocked();
+    compactLocked();
+}
+
+uint64_t DigestCache::getEntryCount() {
+    std::shared_lock<std::shared_mutex> lock(m_mutex, std::defer_lock);
+    FileLock fileLock(m_hIndex);
+    if (!lockShared(lock, fileLock)) {
+        return 0;
+    }
+    return m_header->count;
+}
+
+bool DigestCache::lockShared(std::shared_lock<std::shared_mutex>& lock, FileLock& fileLock) {
+    while (true) {
+        lock.lock();
+        if (m_header == nullptr || !fileLock.acquire(false)) {
+            return false;
+        }
+        if (m_header->capacity == m_capacity) {
+            return true;
+        }
+
+        // Another process grew the table: remap, which needs this process to ourselves
+        fileLock.release();
+        lock.unlock();
+        {
+            std::unique_lock<std::shared_mutex> exclusive(m_mutex);
+            FileLock refreshLock(m_hIndex);
+            if (m_header == nullptr || !refreshLock.acquire(false)) {
+                return false;
+            }
+            refreshMappingLocked();
+        }
+    }
+}
+
+void DigestCache::refreshMappingLocked() {
+    if (m_header == nullptr) {
+        throw std::runtime_error("Digest cache index is not mapped.");
+    }
+    if (m_header->capacity != m_capacity) {
+        mapIndex(m_header->capacity);
+    }
+}
+
+void DigestCache::initializeLocked() {
+    IndexHeader header = {};
+    size_t bytesRead = 0;
+    LARGE_INTEGER indexSize = {};
+    GetFileSizeEx(m_hIndex, &indexSize);
+
+    bool valid = readAt(m_hIndex, 0, &header, sizeof(header), bytesRead) &&
+                 bytesRead == sizeof(header) &&
+                 header.magic == INDEX_MAGIC && header.version == FORMAT_VERSION &&
+                 header.state == STATE_CLEAN &&
+                 header.capacity >= INITIAL_CAPACITY && (header.capacity & (header.capacity - 1)) == 0 &&
+                 static_cast<uint64_t>(indexSize.QuadPart) >= sizeof(IndexHeader) + header.capacity * sizeof(Slot);
+
+    LogHeader logHeader = {};
+    LARGE_INTEGER logSize = {};
+    GetFileSizeEx(m_hLog, &logSize);
+    valid = valid &&
+            readAt(m_hLog, 0, &logHeader, sizeof(logHeader), bytesRead) &&
+            bytesRead == sizeof(logHeader) &&
+            logHeader.magic == LOG_MAGIC && logHeader.version == FORMAT_VERSION &&
+            header.logSize >= LOG_HEADER_SIZE &&
+            header.logSize <= static_cast<uint64_t>(logSize.QuadPart);
+
+    if (!valid) {
+        // New, foreign or damaged: start over
+        resetLocked();
+        return;
+    }
+    mapIndex(header.capacity);
+}
+
+void DigestCache::resetLocked() {
+    LogHeader logHeader = {LOG_MAGIC, FORMAT_VERSION, 0};
+    if (!truncateAt(m_hLog, 0) || !writeAt(m_hLog, 0, &logHeader, sizeof(logHeader))) {
+        throw std::runtime_error(formatError("Cannot initialize digest cache.", GetLastError()));
+    }
+
+    // Other processes may still map the index, so it is cleared rather than truncated
+    mapIndex(INITIAL_CAPACITY);
+    std::memset(m_slots, 0, static_cast<size_t>(m_capacity * sizeof(Slot)));
+    IndexHeader header = {};
+    header.magic = INDEX_MAGIC;
+    header.version = FORMAT_VERSION;
+    header.capacity = INITIAL_CAPACITY;
+    header.logSize = LOG_HEADER_SIZE;
+    header.state = STATE_CLEAN;
+    *m_header = header;
+}
+
+void DigestCache::mapIndex(uint64_t capacity) {
+    unmapIndex();
+
+    uint64_t size = sizeof(IndexHeader) + capacity * sizeof(Slot);
+    if (size > SIZE_MAX) {
+        throw std::runtime_error("Digest cache index is too large for this process.");
+    }
+
+    // Creating a mapping larger than the file extends it with zeros
+    m_hMapping = CreateFileMappingW(m_hIndex, NULL, PAGE_READWRITE,
+                                    static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), NULL);
+    if (m_hMapping == NULL) {
+        throw std::runtime_error(formatError("Cannot map digest cache index.", GetLastError()));
+    }
+
+    void* view = MapViewOfFile(m_hMapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, static_cast<SIZE_T>(size));
+    if (view == NULL) {
+        DWORD error = GetLastError();
+        CloseHandle(m_hMapping);
+        m_hMapping = NULL;
+        throw std::runtime_error(formatError("Cannot map digest cache index.", error));
+    }
+
+    m_header = static_cast<IndexHeader*>(view);
+    m_slots = reinterpret_cast<Slot*>(m_header + 1);
+    m_capacity = capacity;
+}
+
+void DigestCache::unmapIndex() {
+    if (m_header != nullptr) {
+        UnmapViewOfFile(m_header);
+        m_header = nullptr;
+        m_slots = nullptr;
+        m_capacity = 0;
+    }
+    if (m_hMapping != NULL) {
+        CloseHandle(m_hMapping);
+        m_hMapping = NULL;
+    }
+}
+
+void DigestCache::growLocked() {
+    const uint64_t oldCapacity = m_capacity;
+    std::vector<Slot> old(m_slots, m_slots + oldCapacity);
+
+    try {
+        mapIndex(oldCapacity * 2);
+    } catch (const std::exception&) {
+        // Out of address space: stay at the current size, probes just get longer
+        mapIndex(oldCapacity);
+        return;
+    }
+
+    m_header->state = STATE_REBUILDING;
+    std::memset(m_slots, 0, static_cast<size_t>(m_capacity * sizeof(Slot)));
+    const uint64_t mask = m_capacity - 1;
+    for (const Slot& slot : old) {
+        if (slot.tag == 0) {
+            continue;
+        }
+        uint64_t i = slot.tag & mask;
+        while (m_slots[i].tag != 0) {
+            i = (i + 1) & mask;
+        }
+        m_slots[i] = slot;
+    }
+    m_header->capacity = m_capacity;
+    m_header->state = STATE_CLEAN;
+}
+
+void DigestCache::compactLocked() {
+    // Live records in log order; each moves down (or stays), never past a record not yet read
+    std::vector<std::pair<uint64_t, uint64_t>> live; // offset, slot index
+    for (uint64_t i = 0; i < m_capacity; i++) {
+        if (m_slots[i].tag != 0) {
+            live.emplace_back(m_slots[i].offset, i);
+        }
+    }
+    std::sort(live.begin(), live.end());
+
+    m_header->state = STATE_REBUILDING;
+    uint64_t end = LOG_HEADER_SIZE;
+    std::vector<uint8_t> record;
+    for (const auto& item : live) {
+        Slot& slot = m_slots[item.second];
+        if (!readRecord(item.first, record)) {
+            // Keep the slot so its probe chain stays intact; the next store for the file reclaims it
+            slot.offset = 0;
+            continue;
+        }
+        if (item.first != end && !writeAt(m_hLog, end, record.data(), record.size())) {
+            // Left in STATE_REBUILDING: the next open starts a fresh cache
+            throw std::runtime_error(formatError("Cannot compact digest cache.", GetLastError()));
+        }
+        slot.offset = end;
+        end += record.size();
+    }
+
+    truncateAt(m_hLog, end);
+    m_header->logSize = end;
+    m_header->liveBytes = end - LOG_HEADER_SIZE;
+    m_header->state = STATE_CLEAN;
+}
+
+DigestCache::Probe DigestCache::findSlot(const FileKey& key) {
+    Probe probe;
+    const uint64_t tag = tagOf(key);
+    const uint64_t mask = m_capacity - 1;
+    std::vector<uint8_t> record;
+
+    for (uint64_t i = tag & mask, n = 0; n < m_capacity; i = (i + 1) & mask, n++) {
+        Slot& slot = m_slots[i];
+        if (slot.tag == 0) {
+            probe.slot = &slot;
+            return probe;
+        }
+        if (slot.tag != tag) {
+            continue;
+        }
+
+        if (!readRecord(slot.offset, record)) {
+            // Unreadable record under this file's tag: take the slot over
+            probe.slot = &slot;
+            return probe;
+        }
+
+        RecordHeader header;
+        std::memcpy(&header, record.data(), sizeof(header));
+        if (header.volumeSerial != key.volumeSerial || header.fileIndex != key.fileIndex) {
+            continue; // Tag collision with another file
+        }
+
+        probe.slot = &slot;
+        probe.matched = true;
+        probe.key.volumeSerial = header.volumeSerial;
+        probe.key.fileIndex = header.fileIndex;
+        probe.key.size = header.size;
+        probe.key.lastWriteTime = header.lastWriteTime;
+        probe.key.changeTime = header.changeTime;
+        probe.length = record.size();
+
+        const uint8_t* in = record.data() + sizeof(RecordHeader);
+        for (uint32_t e = 0; e < header.entryCount; e++) {
+            Entry entry;
+            entry.name.assign(reinterpret_cast<const char*>(in + 2), in[0]);
+            entry.digest.assign(in + 2 + in[0], in + 2 + in[0] + in[1]);
+            in += 2 + in[0] + in[1];
+            probe.entries.push_back(std::move(entry));
+        }
+        for (uint32_t e = 0; e < header.stateCount; e++) {
+            const size_t nameLength = in[0];
+            const size_t stateLength = getU32(in + 1);
+            const uint8_t* data = in + STATE_ENTRY_HEADER_SIZE;
+            StateEntry entry;
+            entry.name.assign(reinterpret_cast<const char*>(data), nameLength);
+            entry.state.assign(data + nameLength, data + nameLength + stateLength);
+            in = data + nameLength + stateLength;
+            probe.states.push_back(std::move(entry));
+        }
+        probe.fingerprint = header.fingerprint;
+        return probe;
+    }
+    return probe;
+}
+
+bool DigestCache::readRecord(uint64_t offset, std::vector<uint8_t>& record) {
+    const uint64_t logSize = m_header->logSize;
+    if (offset < LOG_HEADER_SIZE || offset + sizeof(RecordHeader) > logSize) {
+        return false;
+    }
+    const uint64_t available = std::min(logSize - offset, MAX_RECORD_SIZE);
+
+    record.resize(static_cast<size_t>(std::min<uint64_t>(available, FIRST_READ_SIZE)));
+    size_t bytesRead = 0;
+    if (!readAt(m_hLog, offset, record.data(), record.size(), bytesRead) || bytesRead < sizeof(RecordHeader)) {
+        return false;
+    }
+
+    RecordHeader header;
+    std::memcpy(&header, record.data(), sizeof(header));
+    if (header.magic != RECORD_MAGIC || header.length < sizeof(RecordHeader) || header.length > available) {
+        return false;
+    }
+
+    if (header.length > bytesRead) {
+        size_t have = bytesRead;
+        record.resize(header.length);
+        if (!readAt(m_hLog, offset + have, record.data() + have, header.length - have, bytesRead) ||
+            bytesRead != header.length - have) {
+            return false;
+        }
+    }
+    record.resize(header.length);
+
+    if (recordChecksum(record.data(), record.size()) != header.checksum) {
+        return false;
+    }
+
+    // Entries must fit inside the record
+    size_t position = sizeof(RecordHeader);
+    for (uint32_t e = 0; e < header.entryCount; e++) {
+        if (position + 2 > record.size()) {
+            return false;
+        }
+        position += 2 + record[position] + record[position + 1];
+        if (position > record.size()) {
+            return false;
+        }
+    }
+    for (uint32_t e = 0; e < header.stateCount; e++) {
+        if (position + STATE_ENTRY_HEADER_SIZE > record.size()) {
+            return false;
+        }
+        position += STATE_ENTRY_HEADER_SIZE + record[position] + static_cast<size_t>(getU32(&record[position + 1]));
+        if (position > record.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace core
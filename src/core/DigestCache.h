@@ -0,0 +1,192 @@
+#ifndef DIGEST_CACHE_H
+#define DIGEST_CACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief Persistent on-disk cache of file digests keyed by file identity.
+ *
+ * A file is identified by its volume serial number and file index (the
+ * Windows counterparts of device and inode) and is considered unchanged
+ * while its size, last write time and change time are the same as when it
+ * was hashed. Digests are stored per factory algorithm name, so a lookup
+ * for any subset of previously computed algorithms is answered without
+ * reading the file.
+ *
+ * Storage is two files: an append-only log of checksummed records
+ * (<path>) and an open-addressing hash table (<path>.idx) mapped into
+ * memory, holding one slot per file that points at its newest record.
+ * Lookups are one probe sequence plus one positioned read. Any number of
+ * threads and processes may use the same cache: a byte-range lock on the
+ * index serialises writers against readers across processes, a
+ * shared_mutex does the same between threads of one process.
+ *
+ * A record may also carry the saved state of each algorithm at the end of
+ * the file (a Tail) and a fingerprint of the last bytes hashed. When the
+ * same file is later found longer, lookupTail() returns those states so
+ * that only the appended data has to be hashed (see MultiHasher).
+ *
+ * Replaced records stay in the log until compact() slides the live ones
+ * down over them; this also happens automatically on open once more than
+ * half of a large log is garbage. A damaged cache is never trusted:
+ * records that fail their checksum or key check are misses, and a cache
+ * left half-compacted by a crash is reset.
+ *
+ * Usage:
+ *   DigestCache cache(DigestCache::defaultPath());
+ *   DigestCache::FileKey key;
+ *   if (DigestCache::queryFileKey(path, key) && cache.lookup(key, names, digests)) {
+ *       // digests are current for the file
+ *   }
+ */
+class DigestCache {
+public:
+    /// @brief Identity and version of a file on disk
+    struct FileKey {
+        uint64_t volumeSerial = 0;
+        uint64_t fileIndex = 0;
+        uint64_t size = 0;
+        uint64_t lastWriteTime = 0; ///< FILETIME units
+        uint64_t changeTime = 0;    ///< FILETIME units
+
+        bool operator==(const FileKey& other) const {
+            return volumeSerial == other.volumeSerial && fileIndex == other.fileIndex &&
+                   size == other.size && lastWriteTime == other.lastWriteTime &&
+                   changeTime == other.changeTime;
+        }
+        bool operator!=(const FileKey& other) const { return !(*this == other); }
+    };
+
+    /// @brief Algorithm states at the end of a cached version of a file
+    struct Tail {
+        FileKey key;                              ///< Version of the file the states belong to
+        uint64_t fingerprint = 0;                 ///< fingerprint() of the bytes ending at key.size
+        std::vector<std::vector<uint8_t>> states; ///< IHashAlgorithm::saveState() in names order
+    };
+
+    /// @brief Bytes before the end of the hashed data covered by a fingerprint
+    static constexpr uint64_t FINGERPRINT_SIZE = 64 * 1024;
+
+    /// @brief Log size below which the cache is never compacted automatically
+    static constexpr uint64_t AUTO_COMPACT_SIZE = 64 * 1024 * 1024;
+
+    /// @brief Files written more recently than this are not cached (FAT has 2 s timestamps)
+    static constexpr uint64_t RACY_INTERVAL = 2 * 10000000ULL;
+
+    /// @brief Open or create the cache
+    /// @param path Log file path; the index is kept next to it as <path>.idx
+    /// @throws std::runtime_error if the files cannot be opened or mapped
+    explicit DigestCache(const std::wstring& path);
+    ~DigestCache();
+
+    DigestCache(const DigestCache&) = delete;
+    DigestCache& operator=(const DigestCache&) = delete;
+
+    /// @return Per-user cache location (%LOCALAPPDATA%\HashCalc\digests.cache), directory created
+    static std::wstring defaultPath();
+
+    /// @brief Read the identity of an open file
+    /// @param hFile Win32 file handle with at least FILE_READ_ATTRIBUTES access
+    static bool queryFileKey(void* hFile, FileKey& key);
+
+    /// @brief Read the identity of a file by path
+    static bool queryFileKey(const std::wstring& path, FileKey& key);
+
+    /// @brief Fingerprint the FINGERPRINT_SIZE bytes (fewer for a short file) before an offset
+    /// @param end Offset just past the fingerprinted bytes, at most the file size
+    /// @return false if the bytes cannot be read
+    static bool fingerprint(const std::wstring& path, uint64_t end, uint64_t& value);
+
+    /// @brief Check that a file was not modified so recently that a later write
+    ///        could leave its timestamps unchanged
+    static bool isSettled(const FileKey& key);
+
+    /// @brief Fetch cached digests for every named algorithm
+    /// @param names Factory algorithm names
+    /// @param digests Receives the digests in names order
+    /// @return true only if the file is unchanged and all names are cached
+    bool lookup(const FileKey& key, const std::vector<std::string>& names,
+                std::vector<std::vector<uint8_t>>& digests);
+
+    /// @brief Fetch the saved states of any cached version of the file
+    /// @param key Current identity of the file; size and times may differ from tail.key
+    /// @param names Factory algorithm names
+    /// @return true if states for every named algorithm are cached
+    bool lookupTail(const FileKey& key, const std::vector<std::string>& names, Tail& tail);
+
+    /// @brief Record digests for a file, keeping cached digests of other algorithms
+    ///        if the file is unchanged. Digests of files that are not isSettled() are
+    ///        skipped and failures are ignored: the cache is best effort.
+    /// @param tail Algorithm states at the end of the file (tail->key == key), or nullptr;
+    ///        kept even for files that are not settled, as they are checked by fingerprint
+    void store(const FileKey& key, const std::vector<std::string>& names,
+               const std::vector<std::vector<uint8_t>>& digests, const Tail* tail = nullptr);
+
+    /// @brief Drop replaced records from the log
+    void compact();
+
+    /// @return Number of files in the cache
+    uint64_t getEntryCount();
+
+private:
+    struct IndexHeader;
+    struct Slot;
+    class FileLock;
+
+    struct Entry {
+        std::string name;
+        std::vector<uint8_t> digest;
+    };
+
+    struct StateEntry {
+        std::string name;
+        std::vector<uint8_t> state;
+    };
+
+    /// @brief Result of looking a file up in the index
+    struct Probe {
+        Slot* slot = nullptr;   ///< The file's slot, or the empty slot ending its probe sequence
+        bool matched = false;   ///< slot holds a readable record for the same file
+        FileKey key;            ///< Key stored in that record
+        std::vector<Entry> entries;
+        std::vector<StateEntry> states;
+        uint64_t fingerprint = 0;
+        uint64_t length = 0;    ///< Size of the record in the log
+    };
+
+    /// @brief Take the in-process and file locks for reading, remapping the index
+    ///        first if another process has grown it
+    bool lockShared(std::shared_lock<std::shared_mutex>& lock, FileLock& fileLock);
+
+    /// @brief Bring the mapping up to date with the header (writer side)
+    void refreshMappingLocked();
+
+    void initializeLocked();
+    void resetLocked();
+    void mapIndex(uint64_t capacity);
+    void unmapIndex();
+    void growLocked();
+    void compactLocked();
+
+    Probe findSlot(const FileKey& key);
+    bool readRecord(uint64_t offset, std::vector<uint8_t>& record);
+
+    void* m_hLog;
+    void* m_hIndex;
+    void* m_hMapping;
+    IndexHeader* m_header;
+    Slot* m_slots;
+    uint64_t m_capacity;
+
+    std::shared_mutex m_mutex;
+};
+
+} // namespace core
+
+#endif // DIGEST_CACHE_H
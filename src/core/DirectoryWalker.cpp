@@ -0,0 +1,126 @@
+#include "DirectoryWalker.h"
+#include <algorithm>
+#include <windows.h>
+
+namespace core {
+
+namespace {
+
+std::wstring joinPath(const std::wstring& directory, const std::wstring& name) {
+    if (!directory.empty() && directory.back() != L'\\' && directory.back() != L'/') {
+        return directory + L'\\' + name;
+    }
+    return directory + name;
+}
+
+} // namespace
+
+DirectoryWalker::DirectoryWalker(const std::wstring& root)
+    : m_root(root),
+      m_started(false) {
+}
+
+bool DirectoryWalker::next(Entry& entry) {
+    if (!m_started) {
+        m_started = true;
+        Frame frame;
+        unsigned long error = listDirectory(m_root, frame);
+        if (error != 0) {
+            entry.path = m_root;
+            entry.size = 0;
+            entry.error = true;
+            entry.errorCode = error;
+            return true;
+        }
+        m_stack.push_back(std::move(frame));
+    }
+
+    while (!m_stack.empty()) {
+        Frame& top = m_stack.back();
+        if (top.next == top.children.size()) {
+            m_stack.pop_back();
+            continue;
+        }
+
+        Child& child = top.children[top.next++];
+        std::wstring path = joinPath(top.directory, child.name);
+
+        if (child.isDirectory) {
+            Frame frame;
+            unsigned long error = listDirectory(path, frame);
+            if (error != 0) {
+                entry.path = path;
+                entry.size = 0;
+                entry.error = true;
+                entry.errorCode = error;
+                return true;
+            }
+            // Invalidates top and child
+            m_stack.push_back(std::move(frame));
+            continue;
+        }
+
+        entry.path = std::move(path);
+        entry.size = child.size;
+        entry.error = false;
+        entry.errorCode = 0;
+        return true;
+    }
+
+    return false;
+}
+
+unsigned long DirectoryWalker::listDirectory(const std::wstring& directory, Frame& frame) {
+    frame.directory = directory;
+    frame.children.clear();
+    frame.next = 0;
+
+    // FindExInfoBasic skips the 8.3 name lookup; large fetch batches the directory reads
+    WIN32_FIND_DATAW data;
+    HANDLE hFind = FindFirstFileExW(joinPath(directory, L"*").c_str(), FindExInfoBasic, &data,
+                                    FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+    if (hFind == INVALID_HANDLE_VALUE) {
+        DWORD error = GetLastError();
+        // An empty directory is not an error
+        return error == ERROR_FILE_NOT_FOUND ? 0 : error;
+    }
+
+    do {
+        const wchar_t* name = data.cFileName;
+        if (name[0] == L'.' && (name[1] == L'\0' || (name[1] == L'.' && name[2] == L'\0'))) {
+            continue;
+        }
+
+        bool isDirectory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        if (isDirectory && (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0) {
+            // Junctions and directory symlinks can form cycles
+            continue;
+        }
+
+        Child child;
+        child.name = name;
+        child.size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+        child.isDirectory = isDirectory;
+        frame.children.push_back(std::move(child));
+    } while (FindNextFileW(hFind, &data));
+
+    DWORD error = GetLastError();
+    FindClose(hFind);
+    if (error != ERROR_NO_MORE_FILES) {
+        return error;
+    }
+
+    // NTFS happens to list names in order, FAT and network shares do not
+    std::sort(frame.children.begin(), frame.children.end(), [](const Child& a, const Child& b) {
+        int order = CompareStringOrdinal(a.name.c_str(), static_cast<int>(a.name.size()),
+                                         b.name.c_str(), static_cast<int>(b.name.size()), TRUE);
+        if (order != CSTR_EQUAL) {
+            return order == CSTR_LESS_THAN;
+        }
+        // Case-sensitive directories may hold names differing only in case
+        return a.name < b.name;
+    });
+    return 0;
+}
+
+} // namespace core
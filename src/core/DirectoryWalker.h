@@ -0,0 +1,65 @@
+#ifndef DIRECTORY_WALKER_H
+#define DIRECTORY_WALKER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief Streaming, deterministic recursive directory enumeration.
+ *
+ * Files are produced one at a time in depth-first order with the entries of
+ * every directory sorted by name (ordinal, case-insensitive), so two walks
+ * of the same tree yield the same sequence regardless of file system.
+ * Only the directories on the current path are held in memory, never the
+ * whole tree. Directory symlinks and junctions are not followed.
+ *
+ * Usage:
+ *   DirectoryWalker walker(L"C:\\data");
+ *   DirectoryWalker::Entry entry;
+ *   while (walker.next(entry)) {
+ *       if (!entry.error) hash(entry.path);
+ *   }
+ */
+class DirectoryWalker {
+public:
+    /// @brief One file, or a directory that could not be listed
+    struct Entry {
+        std::wstring path;
+        uint64_t size = 0;           ///< File size from the directory listing
+        bool error = false;          ///< true if path is a directory that could not be listed
+        unsigned long errorCode = 0; ///< Win32 error code when error is set
+    };
+
+    explicit DirectoryWalker(const std::wstring& root);
+
+    /// @brief Advance to the next file
+    /// @return false when the walk is finished
+    bool next(Entry& entry);
+
+private:
+    struct Child {
+        std::wstring name;
+        uint64_t size;
+        bool isDirectory;
+    };
+
+    struct Frame {
+        std::wstring directory;
+        std::vector<Child> children; // Sorted; consumed front to back
+        size_t next = 0;
+    };
+
+    /// @return Win32 error code, 0 on success
+    static unsigned long listDirectory(const std::wstring& directory, Frame& frame);
+
+    std::wstring m_root;
+    bool m_started;
+    std::vector<Frame> m_stack;
+};
+
+} // namespace core
+
+#endif // DIRECTORY_WALKER_H
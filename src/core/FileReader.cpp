@@ -0,0 +1,712 @@
+#include "FileReader.h"
+#include "IoRing.h"
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <windows.h>
+
+namespace core {
+
+namespace {
+
+/// @brief One overlapped read request and the buffer it fills
+struct PendingRead {
+    OVERLAPPED overlapped;
+    AlignedBuffer buffer;
+    bool inFlight;
+};
+
+/// @brief Cancels and drains reads still owned by the kernel before their buffers are freed
+struct PendingReadGuard {
+    HANDLE hFile;
+    std::vector<PendingRead>& reads;
+
+    ~PendingReadGuard() {
+        for (PendingRead& read : reads) {
+            if (read.inFlight) {
+                DWORD ignored = 0;
+                CancelIoEx(hFile, &read.overlapped);
+                GetOverlappedResult(hFile, &read.overlapped, &ignored, TRUE);
+            }
+            if (read.overlapped.hEvent != NULL) {
+                CloseHandle(read.overlapped.hEvent);
+            }
+        }
+    }
+};
+
+[[noreturn]] void throwReadError(DWORD error) {
+    std::ostringstream oss;
+    oss << "Error reading file. Error code: " << error;
+    throw std::runtime_error(oss.str());
+}
+
+void setOffset(OVERLAPPED& overlapped, uint64_t offset) {
+    overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+}
+
+// Touching a mapped page whose read fails (disk error, network drop, file
+// truncated under the view) raises EXCEPTION_IN_PAGE_ERROR instead of
+// returning an error. These helpers turn it back into an error code; they
+// hold no objects with destructors so that __try is allowed.
+#ifdef _MSC_VER
+constexpr bool MAPPED_READS_GUARDED = true;
+
+DWORD deliverMapped(const FileReader::BlockCallback& onBlock, const uint8_t* data, size_t length) {
+    __try {
+        onBlock(data, length);
+    } __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ?
+                EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH) {
+        return ERROR_READ_FAULT;
+    }
+    return ERROR_SUCCESS;
+}
+
+DWORD copyMapped(uint8_t* buffer, const uint8_t* data, size_t length) {
+    __try {
+        memcpy(buffer, data, length);
+    } __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ?
+                EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH) {
+        return ERROR_READ_FAULT;
+    }
+    return ERROR_SUCCESS;
+}
+#else
+// Without __try a failed page-in would crash the process, so files are
+// never mapped and these are unreachable
+constexpr bool MAPPED_READS_GUARDED = false;
+
+DWORD deliverMapped(const FileReader::BlockCallback& onBlock, const uint8_t* data, size_t length) {
+    onBlock(data, length);
+    return ERROR_SUCCESS;
+}
+
+DWORD copyMapped(uint8_t* buffer, const uint8_t* data, size_t length) {
+    memcpy(buffer, data, length);
+    return ERROR_SUCCESS;
+}
+#endif
+
+/// @brief Ask the memory manager to read a freshly mapped window ahead of the hash
+void prefetchView(const void* view, size_t length) {
+    // PrefetchVirtualMemory is Windows 8+; resolve it at run time to keep Windows 7 support
+    struct MemoryRange {
+        PVOID VirtualAddress;
+        SIZE_T NumberOfBytes;
+    };
+    typedef BOOL (WINAPI *PrefetchVirtualMemoryFn)(HANDLE, ULONG_PTR, MemoryRange*, ULONG);
+    static const PrefetchVirtualMemoryFn prefetch = reinterpret_cast<PrefetchVirtualMemoryFn>(
+        GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory"));
+
+    if (prefetch != NULL) {
+        MemoryRange range = { const_cast<void*>(view), length };
+        prefetch(GetCurrentProcess(), 1, &range, 0);
+    }
+}
+
+} // namespace
+
+FileReader::FileReader(const std::wstring& filePath, const ReadOptions& options)
+    : m_hFile(INVALID_HANDLE_VALUE),
+      m_fileSize(0),
+      m_offset(0),
+      m_overlapped(false),
+      m_options(options),
+      m_direct(options.mode == ReadMode::Direct),
+      m_endOfFile(false),
+      m_stagePos(0),
+      m_stageLength(0),
+      m_mapped(false),
+      m_hMapping(NULL),
+      m_view(nullptr),
+      m_viewOffset(0),
+      m_viewLength(0),
+      m_windowSize(0),
+      m_startOffset(0),
+      m_bytesProcessed(0),
+      m_lastReportedBytes(0),
+      m_progressThreshold(0),
+      m_progressStarted(false),
+      m_progressFinished(false) {
+    if (m_direct && m_options.blockSize != 0) {
+        // Unbuffered reads must be a whole number of sectors
+        m_options.blockSize = AlignedBufferPool::alignUp(m_options.blockSize);
+    }
+    if (m_options.blockSize == 0 || m_options.blockSize > MAXDWORD) {
+        throw std::invalid_argument("Invalid read block size");
+    }
+    if (m_options.queueDepth == 0) {
+        m_options.queueDepth = 1;
+    }
+    if (!MAPPED_READS_GUARDED && m_options.mode == ReadMode::Mapped) {
+        // Page-in errors cannot be caught on this toolchain: use streamed reads
+        m_options.mode = ReadMode::Stream;
+    }
+    m_overlapped = m_options.queueDepth > 1 && m_options.mode != ReadMode::Mapped;
+
+    // Use CreateFile with FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE
+    // to allow reading files that are currently in use by other processes
+    // FILE_FLAG_SEQUENTIAL_SCAN optimizes for sequential file reading; direct
+    // mode bypasses the cache entirely so read-ahead is up to the queue depth
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    flags |= m_direct ? FILE_FLAG_NO_BUFFERING : FILE_FLAG_SEQUENTIAL_SCAN;
+    if (m_overlapped) {
+        flags |= FILE_FLAG_OVERLAPPED;
+    }
+
+    HANDLE hFile = CreateFile(
+        filePath.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL,
+        OPEN_EXISTING,
+        flags,
+        NULL
+    );
+
+    if (hFile == INVALID_HANDLE_VALUE) {
+        DWORD error = GetLastError();
+        std::ostringstream oss;
+        oss << "Cannot open file for hashing. Error code: " << error;
+        throw std::runtime_error(oss.str());
+    }
+    m_hFile = hFile;
+
+    // Get file size for progress reporting
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(hFile, &fileSize)) {
+        m_fileSize = static_cast<uint64_t>(fileSize.QuadPart);
+    }
+
+    // Empty files cannot be mapped and have nothing to read anyway
+    bool wantMapped = MAPPED_READS_GUARDED &&
+                      (m_options.mode == ReadMode::Mapped ||
+                       (m_options.mode == ReadMode::Auto && m_fileSize >= ReadOptions::MAPPED_THRESHOLD));
+    if (wantMapped && m_fileSize > 0) {
+        HANDLE hMapping = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (hMapping != NULL) {
+            SYSTEM_INFO systemInfo;
+            GetSystemInfo(&systemInfo);
+            size_t granularity = systemInfo.dwAllocationGranularity;
+            m_windowSize = ReadOptions::MAPPED_WINDOW_SIZE - ReadOptions::MAPPED_WINDOW_SIZE % granularity;
+            if (m_windowSize == 0) {
+                m_windowSize = granularity;
+            }
+            m_hMapping = hMapping;
+            m_mapped = true;
+        } else if (m_options.mode == ReadMode::Mapped) {
+            // Mapping was requested explicitly: report it rather than silently streaming
+            DWORD error = GetLastError();
+            CloseHandle(hFile);
+            m_hFile = INVALID_HANDLE_VALUE;
+            std::ostringstream oss;
+            oss << "Cannot map file for hashing. Error code: " << error;
+            throw std::runtime_error(oss.str());
+        }
+        // Auto mode falls back to streamed reads (e.g. files on some network redirectors)
+    }
+}
+
+FileReader::~FileReader() {
+    unmapWindow();
+    if (m_hMapping != NULL) {
+        CloseHandle(static_cast<HANDLE>(m_hMapping));
+    }
+    if (m_hFile != INVALID_HANDLE_VALUE) {
+        CloseHandle(static_cast<HANDLE>(m_hFile));
+    }
+}
+
+void FileReader::seek(uint64_t offset) {
+    if (m_progressStarted) {
+        throw std::runtime_error("Cannot seek after reading has started");
+    }
+    if (offset > m_fileSize) {
+        throw std::invalid_argument("Read offset is past the end of the file");
+    }
+    if (m_direct && offset % AlignedBufferPool::alignment() != 0) {
+        throw std::invalid_argument("Unbuffered reads must start at a sector-aligned offset");
+    }
+
+    // Overlapped reads carry their own offset; everything else uses the file pointer
+    if (!m_overlapped) {
+        LARGE_INTEGER distance;
+        distance.QuadPart = static_cast<LONGLONG>(offset);
+        if (!SetFilePointerEx(static_cast<HANDLE>(m_hFile), distance, NULL, FILE_BEGIN)) {
+            DWORD error = GetLastError();
+            std::ostringstream oss;
+            oss << "Cannot seek in file. Error code: " << error;
+            throw std::runtime_error(oss.str());
+        }
+    }
+    m_offset = offset;
+    m_startOffset = offset;
+}
+
+void FileReader::read(const BlockCallback& onBlock) {
+    if (m_mapped) {
+        readMapped(onBlock);
+    } else if (m_options.mode == ReadMode::IoRing && IoRing::isAvailable()) {
+        readIoRing(onBlock);
+    } else if (m_overlapped) {
+        readOverlapped(onBlock);
+    } else {
+        readSynchronous(onBlock);
+    }
+}
+
+size_t FileReader::readBlock(uint8_t* buffer, size_t capacity) {
+    if (!m_progressStarted) {
+        beginProgress();
+    }
+
+    // Check for cancellation before reading next chunk
+    checkCancelled();
+
+    size_t length;
+    if (m_mapped) {
+        length = 0;
+        if (m_offset < m_fileSize) {
+            if (m_view == nullptr || m_offset >= m_viewOffset + m_viewLength) {
+                mapWindow(m_offset);
+            }
+            length = static_cast<size_t>(m_viewOffset + m_viewLength - m_offset);
+            if (length > capacity) {
+                length = capacity;
+            }
+            DWORD error = copyMapped(buffer, m_view + (m_offset - m_viewOffset), length);
+            if (error != ERROR_SUCCESS) {
+                throwReadError(error);
+            }
+            m_offset += length;
+        }
+    } else if (m_direct) {
+        size_t alignment = AlignedBufferPool::alignment();
+        bool aligned = reinterpret_cast<uintptr_t>(buffer) % alignment == 0 && capacity >= alignment;
+        if (aligned && m_stagePos == m_stageLength) {
+            length = readRaw(buffer, capacity - capacity % alignment);
+        } else {
+            length = readStaged(buffer, capacity);
+        }
+    } else {
+        length = readRaw(buffer, capacity);
+    }
+
+    // End of file reached
+    if (length == 0) {
+        endProgress();
+        return 0;
+    }
+
+    advanceProgress(length);
+    return length;
+}
+
+size_t FileReader::readRaw(uint8_t* buffer, size_t length) {
+    if (m_endOfFile) {
+        return 0;
+    }
+
+    HANDLE hFile = static_cast<HANDLE>(m_hFile);
+    DWORD bytesRead = 0;
+    BOOL success;
+
+    if (m_overlapped) {
+        // Overlapped handles have no file pointer: read at our own offset and wait
+        OVERLAPPED overlapped = {};
+        setOffset(overlapped, m_offset);
+        success = ReadFile(hFile, buffer, static_cast<DWORD>(length), NULL, &overlapped) ||
+                  GetLastError() == ERROR_IO_PENDING;
+        if (success) {
+            success = GetOverlappedResult(hFile, &overlapped, &bytesRead, TRUE);
+        }
+        if (!success && GetLastError() == ERROR_HANDLE_EOF) {
+            success = TRUE;
+            bytesRead = 0;
+        }
+    } else {
+        success = ReadFile(hFile, buffer, static_cast<DWORD>(length), &bytesRead, NULL);
+    }
+
+    // Check for read errors
+    if (!success) {
+        throwReadError(GetLastError());
+    }
+
+    // Unbuffered reads must stay sector-aligned, so nothing follows a short one
+    if (m_direct && bytesRead < length) {
+        m_endOfFile = true;
+    }
+
+    m_offset += bytesRead;
+    return static_cast<size_t>(bytesRead);
+}
+
+size_t FileReader::readStaged(uint8_t* buffer, size_t capacity) {
+    if (m_stagePos == m_stageLength) {
+        if (m_stage.data() == nullptr) {
+            m_stage = AlignedBufferPool::instance().acquire(m_options.blockSize);
+        }
+        m_stageLength = readRaw(m_stage.data(), m_options.blockSize);
+        m_stagePos = 0;
+    }
+
+    size_t length = m_stageLength - m_stagePos;
+    if (length > capacity) {
+        length = capacity;
+    }
+    memcpy(buffer, m_stage.data() + m_stagePos, length);
+    m_stagePos += length;
+    return length;
+}
+
+void FileReader::readSynchronous(const BlockCallback& onBlock) {
+    AlignedBuffer buffer = AlignedBufferPool::instance().acquire(m_options.blockSize);
+
+    while (true) {
+        size_t bytesRead = readBlock(buffer.data(), m_options.blockSize);
+
+        // End of file reached
+        if (bytesRead == 0) {
+            break;
+        }
+
+        onBlock(buffer.data(), bytesRead);
+    }
+}
+
+void FileReader::readOverlapped(const BlockCallback& onBlock) {
+    HANDLE hFile = static_cast<HANDLE>(m_hFile);
+    const size_t blockSize = m_options.blockSize;
+
+    std::vector<PendingRead> reads(m_options.queueDepth);
+    PendingReadGuard guard{hFile, reads};
+    for (PendingRead& read : reads) {
+        ZeroMemory(&read.overlapped, sizeof(read.overlapped));
+        read.inFlight = false;
+        read.buffer = AlignedBufferPool::instance().acquire(blockSize);
+        read.overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+        if (read.overlapped.hEvent == NULL) {
+            throwReadError(GetLastError());
+        }
+    }
+
+    bool endOfFile = false;
+
+    // Queue the next block of the file into a free request slot
+    auto issue = [&](PendingRead& read) {
+        setOffset(read.overlapped, m_offset);
+        if (!ReadFile(hFile, read.buffer.data(), static_cast<DWORD>(blockSize), NULL, &read.overlapped)) {
+            DWORD error = GetLastError();
+            if (error == ERROR_HANDLE_EOF) {
+                endOfFile = true;
+                return;
+            }
+            if (error != ERROR_IO_PENDING) {
+                throwReadError(error);
+            }
+        }
+        read.inFlight = true;
+        m_offset += blockSize;
+    };
+
+    if (!m_progressStarted) {
+        beginProgress();
+    }
+
+    // Prime the queue with reads up to the known file size
+    for (PendingRead& read : reads) {
+        if (m_offset >= m_fileSize) {
+            break;
+        }
+        issue(read);
+    }
+
+    // Requests are issued round-robin, so completing them in the same order
+    // delivers the blocks in file order
+    for (size_t head = 0; ; head = (head + 1) % reads.size()) {
+        PendingRead& read = reads[head];
+
+        if (!read.inFlight) {
+            // Queue drained: probe past the size snapshot in case the file grew
+            if (endOfFile) {
+                break;
+            }
+            issue(read);
+            if (!read.inFlight) {
+                break;
+            }
+        }
+
+        // Check for cancellation before consuming next chunk
+        checkCancelled();
+
+        DWORD bytesRead = 0;
+        BOOL success = GetOverlappedResult(hFile, &read.overlapped, &bytesRead, TRUE);
+        read.inFlight = false;
+        if (!success) {
+            DWORD error = GetLastError();
+            if (error != ERROR_HANDLE_EOF) {
+                throwReadError(error);
+            }
+            bytesRead = 0;
+        }
+
+        // End of file reached
+        if (bytesRead == 0) {
+            break;
+        }
+
+        onBlock(read.buffer.data(), static_cast<size_t>(bytesRead));
+        advanceProgress(bytesRead);
+
+        // A short read only happens at end of file; anything queued after it is stale
+        if (bytesRead < blockSize) {
+            break;
+        }
+
+        if (m_offset < m_fileSize) {
+            issue(read);
+        }
+    }
+
+    endProgress();
+}
+
+void FileReader::readIoRing(const BlockCallback& onBlock) {
+    HANDLE hFile = static_cast<HANDLE>(m_hFile);
+    const size_t blockSize = m_options.blockSize;
+    const size_t depth = m_options.queueDepth;
+
+    // State of one ring slot (slot i always reads into registered buffer i)
+    struct Slot {
+        bool inFlight;
+        bool done;
+        uint32_t bytesRead;
+        unsigned long error;
+    };
+
+    // Buffers are declared before the ring so they outlive the reads it may still own
+    std::vector<AlignedBuffer> buffers(depth);
+    std::vector<IoRing::BufferInfo> bufferInfos(depth);
+    for (size_t i = 0; i < depth; i++) {
+        buffers[i] = AlignedBufferPool::instance().acquire(blockSize);
+        bufferInfos[i].address = buffers[i].data();
+        bufferInfos[i].length = static_cast<uint32_t>(blockSize);
+    }
+
+    std::unique_ptr<IoRing> ring;
+    try {
+        ring.reset(new IoRing(static_cast<uint32_t>(depth)));
+        ring->registerBuffers(bufferInfos);
+    } catch (const std::runtime_error&) {
+        // Ring quota exhausted or buffers could not be pinned: use the portable loop
+        ring.reset();
+        if (m_overlapped) {
+            readOverlapped(onBlock);
+        } else {
+            readSynchronous(onBlock);
+        }
+        return;
+    }
+
+    std::vector<Slot> slots(depth);
+
+    auto issue = [&](size_t index) {
+        ring->queueRead(hFile, static_cast<uint32_t>(index), static_cast<uint32_t>(blockSize),
+                        m_offset, index);
+        slots[index].inFlight = true;
+        slots[index].done = false;
+        m_offset += blockSize;
+    };
+
+    // Completions arrive in any order; park them on their slot
+    auto waitFor = [&](Slot& slot) {
+        while (!slot.done) {
+            ring->submit(1);
+            IoRing::Completion completion;
+            while (ring->popCompletion(completion)) {
+                Slot& finished = slots[completion.userData];
+                finished.done = true;
+                finished.bytesRead = completion.bytesRead;
+                finished.error = completion.error;
+            }
+        }
+    };
+
+    if (!m_progressStarted) {
+        beginProgress();
+    }
+
+    // Prime the ring with reads up to the known file size
+    for (size_t i = 0; i < depth && m_offset < m_fileSize; i++) {
+        issue(i);
+    }
+    ring->submit(0);
+
+    // Slots are filled round-robin, so consuming them in the same order
+    // delivers the blocks in file order
+    for (size_t head = 0; ; head = (head + 1) % depth) {
+        Slot& slot = slots[head];
+
+        if (!slot.inFlight) {
+            // Queue drained: probe past the size snapshot in case the file grew
+            issue(head);
+            ring->submit(0);
+        }
+
+        // Check for cancellation before consuming next chunk
+        checkCancelled();
+
+        waitFor(slot);
+        slot.inFlight = false;
+        if (slot.error != 0 && slot.error != ERROR_HANDLE_EOF) {
+            throwReadError(slot.error);
+        }
+
+        // End of file reached
+        size_t bytesRead = slot.error == 0 ? slot.bytesRead : 0;
+        if (bytesRead == 0) {
+            break;
+        }
+
+        onBlock(buffers[head].data(), bytesRead);
+        advanceProgress(bytesRead);
+
+        // A short read only happens at end of file; anything queued after it is stale
+        if (bytesRead < blockSize) {
+            break;
+        }
+
+        if (m_offset < m_fileSize) {
+            issue(head);
+            ring->submit(0);
+        }
+    }
+
+    endProgress();
+}
+
+void FileReader::readMapped(const BlockCallback& onBlock) {
+    if (!m_progressStarted) {
+        beginProgress();
+    }
+
+    // The mapping covers the size snapshot taken at open; later growth is not read
+    while (m_offset < m_fileSize) {
+        if (m_view == nullptr || m_offset >= m_viewOffset + m_viewLength) {
+            mapWindow(m_offset);
+        }
+
+        // Check for cancellation before consuming next chunk
+        checkCancelled();
+
+        // Hand out block-sized slices so progress, cancellation and cache
+        // locality behave as with streamed reads
+        size_t length = static_cast<size_t>(m_viewOffset + m_viewLength - m_offset);
+        if (length > m_options.blockSize) {
+            length = m_options.blockSize;
+        }
+        DWORD error = deliverMapped(onBlock, m_view + (m_offset - m_viewOffset), length);
+        if (error != ERROR_SUCCESS) {
+            throwReadError(error);
+        }
+        m_offset += length;
+        advanceProgress(length);
+    }
+
+    unmapWindow();
+    endProgress();
+}
+
+void FileReader::mapWindow(uint64_t offset) {
+    unmapWindow();
+
+    // Views start at multiples of m_windowSize, hence of the allocation granularity;
+    // only a seek() can ask for an offset inside a window
+    offset -= offset % m_windowSize;
+    uint64_t remaining = m_fileSize - offset;
+    size_t length = remaining < m_windowSize ? static_cast<size_t>(remaining) : m_windowSize;
+
+    void* view = MapViewOfFile(
+        static_cast<HANDLE>(m_hMapping),
+        FILE_MAP_READ,
+        static_cast<DWORD>(offset >> 32),
+        static_cast<DWORD>(offset & 0xFFFFFFFF),
+        length
+    );
+    if (view == NULL) {
+        DWORD error = GetLastError();
+        std::ostringstream oss;
+        oss << "Cannot map file view. Error code: " << error;
+        throw std::runtime_error(oss.str());
+    }
+
+    m_view = static_cast<const uint8_t*>(view);
+    m_viewOffset = offset;
+    m_viewLength = length;
+    prefetchView(view, length);
+}
+
+void FileReader::unmapWindow() {
+    if (m_view != nullptr) {
+        UnmapViewOfFile(m_view);
+        m_view = nullptr;
+        m_viewLength = 0;
+    }
+}
+
+void FileReader::checkCancelled() const {
+    if (m_cancelCallback && m_cancelCallback()) {
+        throw std::runtime_error("Operation cancelled by user");
+    }
+}
+
+void FileReader::beginProgress() {
+    m_progressStarted = true;
+    m_bytesProcessed = m_startOffset;
+    m_lastReportedBytes = m_startOffset;
+
+    // Progress throttling: only update when progress changes by at least 1% or every 512KB
+    m_progressThreshold = m_fileSize / 100; // 1% of file size
+    if (m_progressThreshold < 512 * 1024) {
+        m_progressThreshold = 512 * 1024; // At least 512KB
+    }
+    if (m_progressThreshold > 5 * 1024 * 1024) {
+        m_progressThreshold = 5 * 1024 * 1024; // At most 5MB
+    }
+
+    // Report initial progress
+    if (m_progressCallback) {
+        m_progressCallback(m_startOffset, m_fileSize);
+    }
+}
+
+void FileReader::advanceProgress(size_t length) {
+    m_bytesProcessed += length;
+    if (m_progressCallback) {
+        // Only report progress if we've processed enough bytes since last report
+        if (m_bytesProcessed - m_lastReportedBytes >= m_progressThreshold ||
+            m_bytesProcessed >= m_fileSize) {
+            m_progressCallback(m_bytesProcessed, m_fileSize);
+            m_lastReportedBytes = m_bytesProcessed;
+        }
+    }
+}
+
+void FileReader::endProgress() {
+    if (m_progressFinished) {
+        return;
+    }
+    m_progressFinished = true;
+
+    // Report final progress (100%)
+    if (m_progressCallback && m_bytesProcessed > m_lastReportedBytes) {
+        m_progressCallback(m_bytesProcessed, m_fileSize);
+    }
+}
+
+} // namespace core
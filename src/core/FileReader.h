@@ -0,0 +1,145 @@
+#ifndef FILE_READER_H
+#define FILE_READER_H
+
+#include "AlignedBufferPool.h"
+#include "IHashAlgorithm.h"
+#include "ReadOptions.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace core {
+
+/**
+ * @brief Sequential block reader shared by all file hashing paths.
+ *
+ * Opens a file once and delivers its contents block by block, applying the
+ * progress throttling and cancellation checks used by computeFile.
+ *
+ * With a queue depth above one the file is opened for overlapped I/O and
+ * read() keeps that many reads in flight, so the next blocks are loaded
+ * from disk while the current one is being hashed. Blocks are still
+ * delivered strictly in file order.
+ *
+ * In mapped mode the file is mapped in sliding windows and blocks point
+ * straight into the view, so update() reads from the page cache without a
+ * staging copy. Windowing keeps huge files usable in a 32-bit address space.
+ * A page that fails to load is reported as a read error through structured
+ * exception handling, so builds without it (MinGW, clang in GNU mode) never
+ * map and read Mapped and large Auto files with streamed reads instead.
+ *
+ * In direct mode the file is opened with FILE_FLAG_NO_BUFFERING so a bulk
+ * scan does not evict everything else from the file cache. Reads then go
+ * into page-aligned buffers from AlignedBufferPool with an aligned length;
+ * the unaligned tail of the file simply comes back as a short read.
+ * readBlock() stages through an aligned buffer when the caller's buffer
+ * does not meet the alignment rules.
+ *
+ * In I/O ring mode read() queues up to queueDepth reads into registered
+ * buffers on a Windows I/O ring and completes them in file order. Systems
+ * without I/O rings get the overlapped loop instead. readBlock() always
+ * reads synchronously, so callers that want the queue (HashPipeline) check
+ * readsAhead() and use read() instead.
+ *
+ * Usage:
+ *   FileReader reader(L"C:\\data.bin");
+ *   reader.setProgressCallback(onProgress);
+ *   reader.read([&](const uint8_t* data, size_t length) { algo->update(data, length); });
+ */
+class FileReader {
+public:
+    /// @brief Callback receiving each block in file order
+    /// @note The data pointer is only valid for the duration of the call
+    using BlockCallback = std::function<void(const uint8_t* data, size_t length)>;
+
+    /// @brief Open file for sequential reading
+    /// @throws std::runtime_error if file cannot be opened
+    explicit FileReader(const std::wstring& filePath, const ReadOptions& options = ReadOptions());
+    ~FileReader();
+
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+
+    /// @return File size in bytes (0 if unknown)
+    uint64_t getFileSize() const { return m_fileSize; }
+
+    /// @return true if the file is read through mapped views
+    bool isMapped() const { return m_mapped; }
+
+    /// @return true if read() keeps several reads in flight (overlapped or I/O ring),
+    ///         which readBlock() does not
+    bool readsAhead() const {
+        return !m_mapped && (m_overlapped || m_options.mode == ReadMode::IoRing);
+    }
+
+    /// @brief Set cancellation callback (checked before every block)
+    void setCancelCallback(IHashAlgorithm::CancelCallback callback) { m_cancelCallback = callback; }
+
+    /// @brief Set progress callback (throttled to 1% / 512KB..5MB steps)
+    void setProgressCallback(IHashAlgorithm::ProgressCallback callback) { m_progressCallback = callback; }
+
+    /// @brief Start reading at an offset instead of at the beginning (resume)
+    /// @note Call before the first read; progress is reported from the offset on.
+    ///       Direct mode needs an offset that is a multiple of AlignedBufferPool::alignment().
+    /// @throws std::invalid_argument if the offset is past the end or misaligned
+    /// @throws std::runtime_error if reading has started or the file pointer cannot be moved
+    void seek(uint64_t offset);
+
+    /// @brief Read the whole file, passing every block to onBlock in order
+    /// @throws std::runtime_error on read error or cancellation
+    void read(const BlockCallback& onBlock);
+
+    /// @brief Read the next block into a caller-owned buffer
+    /// @return Number of bytes read, 0 at end of file
+    /// @throws std::runtime_error on read error or cancellation
+    size_t readBlock(uint8_t* buffer, size_t capacity);
+
+private:
+    size_t readRaw(uint8_t* buffer, size_t length);
+    size_t readStaged(uint8_t* buffer, size_t capacity);
+    void readSynchronous(const BlockCallback& onBlock);
+    void readOverlapped(const BlockCallback& onBlock);
+    void readIoRing(const BlockCallback& onBlock);
+    void readMapped(const BlockCallback& onBlock);
+    void mapWindow(uint64_t offset);
+    void unmapWindow();
+    void checkCancelled() const;
+    void beginProgress();
+    void advanceProgress(size_t length);
+    void endProgress();
+
+    void* m_hFile;
+    uint64_t m_fileSize;
+    uint64_t m_offset;       // Next read offset (overlapped handles have no file pointer)
+    bool m_overlapped;
+    ReadOptions m_options;
+
+    // Direct (unbuffered) backend
+    bool m_direct;
+    bool m_endOfFile;        // A short unbuffered read was seen; the next offset is unaligned
+    AlignedBuffer m_stage;   // Bounce buffer for readBlock() callers with unaligned buffers
+    size_t m_stagePos;
+    size_t m_stageLength;
+
+    // Mapped backend
+    bool m_mapped;
+    void* m_hMapping;
+    const uint8_t* m_view;
+    uint64_t m_viewOffset;
+    size_t m_viewLength;
+    size_t m_windowSize;     // ReadOptions::MAPPED_WINDOW_SIZE rounded to the allocation granularity
+
+    uint64_t m_startOffset;  // Set by seek(); progress starts here
+    uint64_t m_bytesProcessed;
+    uint64_t m_lastReportedBytes;
+    uint64_t m_progressThreshold;
+    bool m_progressStarted;
+    bool m_progressFinished;
+
+    IHashAlgorithm::CancelCallback m_cancelCallback;
+    IHashAlgorithm::ProgressCallback m_progressCallback;
+};
+
+} // namespace core
+
+#endif // FILE_READER_H
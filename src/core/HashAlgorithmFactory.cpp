@@ -10,17 +10,49 @@ std::map<std::string, HashAlgorithmFactory::Creator>& HashAlgorithmFactory::getR
     return *registry;
 }
 
+std::map<std::string, HashAlgorithmFactory::ParameterizedCreator>&
+HashAlgorithmFactory::getParameterizedRegistry() {
+    // Leaked for the same reason as getRegistry()
+    static std::map<std::string, ParameterizedCreator>* registry =
+        new std::map<std::string, ParameterizedCreator>();
+    return *registry;
+}
+
+std::map<std::string, HashAlgorithmFactory::BatchCreator>& HashAlgorithmFactory::getBatchRegistry() {
+    // Leaked for the same reason as getRegistry()
+    static std::map<std::string, BatchCreator>* registry = new std::map<std::string, BatchCreator>();
+    return *registry;
+}
+
 void HashAlgorithmFactory::registerAlgorithm(const std::string& name, Creator creator) {
     getRegistry()[name] = std::move(creator);
 }
 
+void HashAlgorithmFactory::registerParameterized(const std::string& name, ParameterizedCreator creator) {
+    getParameterizedRegistry()[name] = std::move(creator);
+}
+
+void HashAlgorithmFactory::registerBatch(const std::string& name, BatchCreator creator) {
+    getBatchRegistry()[name] = std::move(creator);
+}
+
 std::unique_ptr<IHashAlgorithm> HashAlgorithmFactory::create(const std::string& name) {
     auto& registry = getRegistry();
     auto it = registry.find(name);
-    if (it == registry.end()) {
-        throw std::invalid_argument("Unknown hash algorithm: " + name);
+    if (it != registry.end()) {
+        return it->second();
     }
-    return it->second();
+    
+    // "Family/parameters", e.g. "MD6-256/L=0"
+    const size_t slash = name.find('/');
+    if (slash != std::string::npos) {
+        auto& families = getParameterizedRegistry();
+        auto family = families.find(name.substr(0, slash));
+        if (family != families.end()) {
+            return family->second(name.substr(slash + 1));
+        }
+    }
+    throw std::invalid_argument("Unknown hash algorithm: " + name);
 }
 
 std::vector<std::string> HashAlgorithmFactory::getAvailableAlgorithms() {
@@ -31,8 +63,31 @@ std::vector<std::string> HashAlgorithmFactory::getAvailableAlgorithms() {
     return names;
 }
 
+std::unique_ptr<IBatchHashAlgorithm> HashAlgorithmFactory::createBatch(const std::string& name, size_t lanes) {
+    if (lanes != 0 && lanes != 4 && lanes != 8 && lanes != 16) {
+        throw std::invalid_argument("Unsupported lane count for " + name + ": " + std::to_string(lanes));
+    }
+    auto& registry = getBatchRegistry();
+    auto it = registry.find(name);
+    if (it == registry.end()) {
+        return nullptr;
+    }
+    return it->second(lanes);
+}
+
 bool HashAlgorithmFactory::isAvailable(const std::string& name) {
-    return getRegistry().count(name) > 0;
+    if (getRegistry().count(name) > 0) {
+        return true;
+    }
+    if (name.find('/') == std::string::npos) {
+        return false;
+    }
+    try {
+        create(name);
+        return true;
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
 }
 
 } // namespace core
@@ -1,6 +1,7 @@
 #ifndef HASH_ALGORITHM_FACTORY_H
 #define HASH_ALGORITHM_FACTORY_H
 
+#include "IBatchHashAlgorithm.h"
 #include "IHashAlgorithm.h"
 #include <functional>
 #include <map>
@@ -13,31 +14,58 @@ namespace core {
 /**
  * @brief Factory for creating hash algorithm instances.
  * 
- * Algorithms self-register using HashAlgorithmRegistrar.
+ * Algorithms self-register using HashAlgorithmRegistrar. Families with
+ * parameters register a second creator with HashAlgorithmFamilyRegistrar;
+ * a name that is not registered as such is split at its first '/' and the
+ * rest passed to the creator of the family named by the first part.
+ * Algorithms with multi-buffer kernels also register a batch creator with
+ * HashAlgorithmBatchRegistrar (see IBatchHashAlgorithm).
  * 
  * Usage:
  *   auto sha256 = HashAlgorithmFactory::create("SHA-256");
+ *   auto md6 = HashAlgorithmFactory::create("MD6-256/L=0/r=80");
+ *   auto md5x8 = HashAlgorithmFactory::createBatch("MD5", 8);
  *   auto algos = HashAlgorithmFactory::getAvailableAlgorithms();
  */
 class HashAlgorithmFactory {
 public:
     using Creator = std::function<std::unique_ptr<IHashAlgorithm>()>;
+    /// @brief Creates an instance from the parameter part of a name
+    /// @throws std::invalid_argument for parameters it does not accept
+    using ParameterizedCreator = std::function<std::unique_ptr<IHashAlgorithm>(const std::string& parameters)>;
+    /// @brief Creates a batch instance hashing lanes messages side by side (see createBatch)
+    using BatchCreator = std::function<std::unique_ptr<IBatchHashAlgorithm>(size_t lanes)>;
 
     /// @brief Create algorithm by name
-    /// @throws std::invalid_argument if algorithm not found
+    /// @throws std::invalid_argument if algorithm not found or its parameters are invalid
     static std::unique_ptr<IHashAlgorithm> create(const std::string& name);
 
     /// @brief Get list of available algorithm names
     static std::vector<std::string> getAvailableAlgorithms();
 
-    /// @brief Check if algorithm is available
+    /// @brief Check if algorithm is available (including valid parameters)
     static bool isAvailable(const std::string& name);
 
     /// @brief Register algorithm creator (used by registrar)
     static void registerAlgorithm(const std::string& name, Creator creator);
 
+    /// @brief Register the creator of a parameterized family (used by registrar)
+    static void registerParameterized(const std::string& name, ParameterizedCreator creator);
+
+    /// @brief Create a multi-buffer instance for hashing many messages at once
+    /// @param lanes Messages hashed side by side: 4, 8 or 16, or 0 for the fastest choice on this CPU
+    /// @return nullptr if the algorithm has no multi-buffer implementation, or if lanes is 0
+    ///         and hashing one message at a time is at least as fast on this CPU
+    /// @throws std::invalid_argument if lanes is not 0, 4, 8 or 16
+    static std::unique_ptr<IBatchHashAlgorithm> createBatch(const std::string& name, size_t lanes = 0);
+
+    /// @brief Register the batch creator of an algorithm (used by registrar)
+    static void registerBatch(const std::string& name, BatchCreator creator);
+
 private:
     static std::map<std::string, Creator>& getRegistry();
+    static std::map<std::string, ParameterizedCreator>& getParameterizedRegistry();
+    static std::map<std::string, BatchCreator>& getBatchRegistry();
 };
 
 /**
@@ -56,6 +84,36 @@ public:
     }
 };
 
+/**
+ * @brief RAII helper for auto-registration of parameterized algorithm families.
+ * 
+ * Usage (in .cpp file):
+ *   static HashAlgorithmFamilyRegistrar registrar("MD6-256", [](const std::string& params) {
+ *       return createMd6(params);
+ *   });
+ */
+class HashAlgorithmFamilyRegistrar {
+public:
+    HashAlgorithmFamilyRegistrar(const std::string& name, HashAlgorithmFactory::ParameterizedCreator creator) {
+        HashAlgorithmFactory::registerParameterized(name, std::move(creator));
+    }
+};
+
+/**
+ * @brief RAII helper for auto-registration of multi-buffer implementations.
+ * 
+ * Usage (in .cpp file):
+ *   static HashAlgorithmBatchRegistrar registrar("SHA-256", [](size_t lanes) {
+ *       return createSha256Batch(lanes);
+ *   });
+ */
+class HashAlgorithmBatchRegistrar {
+public:
+    HashAlgorithmBatchRegistrar(const std::string& name, HashAlgorithmFactory::BatchCreator creator) {
+        HashAlgorithmFactory::registerBatch(name, std::move(creator));
+    }
+};
+
 } // namespace core
 
 #endif // HASH_ALGORITHM_FACTORY_H
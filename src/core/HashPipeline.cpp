@@ -0,0 +1,257 @@
+#include "HashPipeline.h"
+#include "AlignedBufferPool.h"
+#include "FileReader.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace core {
+
+namespace {
+
+/// @brief One ring slot; recycled when every algorithm has consumed it
+struct Block {
+    AlignedBuffer data; // Aligned so unbuffered reads land here without a bounce copy
+    size_t length = 0;
+    size_t pending = 0; // Algorithms that still have to consume this block
+};
+
+/// @brief Per-algorithm progress through the stream
+struct Cursor {
+    IHashAlgorithm* algorithm = nullptr;
+    uint64_t next = 0;  // Sequence number of the next block to feed
+    bool busy = false;  // Currently being fed by a worker
+};
+
+} // namespace
+
+HashPipeline::HashPipeline(const std::vector<IHashAlgorithm*>& algorithms, size_t workerCount)
+    : m_algorithms(algorithms),
+      m_workerCount(workerCount),
+      m_blockSize(DEFAULT_BLOCK_SIZE),
+      m_blockCount(DEFAULT_BLOCK_COUNT),
+      m_syncInterval(0) {
+    if (m_workerCount == 0) {
+        m_workerCount = std::thread::hardware_concurrency();
+    }
+    if (m_workerCount > m_algorithms.size()) {
+        m_workerCount = m_algorithms.size();
+    }
+    if (m_workerCount == 0) {
+        m_workerCount = 1;
+    }
+}
+
+void HashPipeline::setBuffers(size_t blockSize, size_t blockCount) {
+    if (blockSize == 0 || blockCount == 0) {
+        throw std::invalid_argument("HashPipeline: block size and count must be non-zero");
+    }
+    m_blockSize = blockSize;
+    m_blockCount = blockCount;
+}
+
+void HashPipeline::setSyncPoint(uint64_t interval, SyncCallback onSync) {
+    if (interval == 0) {
+        throw std::invalid_argument("HashPipeline: sync interval must be non-zero");
+    }
+    m_syncInterval = interval;
+    m_onSync = onSync;
+}
+
+void HashPipeline::run(FileReader& reader) {
+    std::vector<Block> ring(m_blockCount);
+    for (Block& block : ring) {
+        block.data = AlignedBufferPool::instance().acquire(m_blockSize);
+    }
+
+    std::vector<Cursor> cursors(m_algorithms.size());
+    for (size_t i = 0; i < m_algorithms.size(); i++) {
+        cursors[i].algorithm = m_algorithms[i];
+    }
+
+    std::mutex mutex;
+    std::condition_variable workAvailable; // Signalled when a block is published or an algorithm frees up
+    std::condition_variable blockFree;     // Signalled when a ring slot is fully consumed
+    uint64_t published = 0;                // Number of blocks available to workers
+    bool endOfInput = false;
+    bool aborted = false;
+    std::exception_ptr error;
+
+    // Pick the algorithm that is furthest behind among those that are idle
+    // and have a published block waiting. Caller must hold the mutex.
+    auto pickTask = [&]() -> Cursor* {
+        Cursor* best = nullptr;
+        for (Cursor& cursor : cursors) {
+            if (!cursor.busy && cursor.next < published &&
+                (best == nullptr || cursor.next < best->next)) {
+                best = &cursor;
+            }
+        }
+        return best;
+    };
+
+    auto allConsumed = [&]() {
+        for (const Cursor& cursor : cursors) {
+            if (cursor.next < published) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto fail = [&](std::exception_ptr exception) {
+        // Caller must hold the mutex
+        if (!error) {
+            error = exception;
+        }
+        aborted = true;
+        workAvailable.notify_all();
+        blockFree.notify_all();
+    };
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            Cursor* task = nullptr;
+            workAvailable.wait(lock, [&]() {
+                if (aborted) {
+                    return true;
+                }
+                task = pickTask();
+                return task != nullptr || (endOfInput && allConsumed());
+            });
+            if (aborted || task == nullptr) {
+                // Wake the remaining idle workers so they can observe the same state
+                workAvailable.notify_all();
+                return;
+            }
+
+            task->busy = true;
+            Block& block = ring[task->next % ring.size()];
+            lock.unlock();
+
+            try {
+                task->algorithm->update(block.data.data(), block.length);
+            } catch (...) {
+                lock.lock();
+                fail(std::current_exception());
+                return;
+            }
+
+            lock.lock();
+            task->busy = false;
+            task->next++;
+            if (--block.pending == 0) {
+                blockFree.notify_one();
+            }
+            // The algorithm just released may have more blocks queued
+            workAvailable.notify_one();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    try {
+        for (size_t i = 0; i < m_workerCount; i++) {
+            workers.emplace_back(worker);
+        }
+
+        uint64_t bytesFed = 0;
+        uint64_t nextSync = m_syncInterval;
+        uint64_t sequence = 0;
+
+        // Next ring slot once every algorithm is done with it (backpressure);
+        // nullptr if the pipeline was aborted
+        auto acquireSlot = [&]() -> Block* {
+            Block& block = ring[sequence % ring.size()];
+            std::unique_lock<std::mutex> lock(mutex);
+            blockFree.wait(lock, [&]() { return aborted || block.pending == 0; });
+            return aborted ? nullptr : &block;
+        };
+
+        // Hand a filled slot to the workers; false if the pipeline was aborted
+        auto publish = [&](Block& block, size_t length) {
+            std::unique_lock<std::mutex> lock(mutex);
+            block.length = length;
+            block.pending = cursors.size();
+            published = ++sequence;
+            workAvailable.notify_all();
+            bytesFed += length;
+
+            if (m_onSync && bytesFed >= nextSync) {
+                // Nothing new is published until the callback returns, so once
+                // every algorithm has caught up the workers leave them alone
+                blockFree.wait(lock, [&]() { return aborted || allConsumed(); });
+                if (aborted) {
+                    return false;
+                }
+                lock.unlock();
+                m_onSync(bytesFed);
+                nextSync = bytesFed - bytesFed % m_syncInterval + m_syncInterval;
+            }
+            return true;
+        };
+
+        if (reader.readsAhead()) {
+            // Let the reader keep its queue of reads in flight and copy each
+            // completed block into the ring, filling every slot before publishing it
+            Block* block = nullptr;
+            size_t filled = 0;
+            reader.read([&](const uint8_t* data, size_t length) {
+                while (length > 0) {
+                    if (block == nullptr && (block = acquireSlot()) == nullptr) {
+                        throw std::runtime_error("HashPipeline aborted");
+                    }
+                    const size_t chunk = std::min(length, m_blockSize - filled);
+                    memcpy(block->data.data() + filled, data, chunk);
+                    filled += chunk;
+                    data += chunk;
+                    length -= chunk;
+                    if (filled == m_blockSize) {
+                        Block* full = block;
+                        block = nullptr;
+                        filled = 0;
+                        if (!publish(*full, m_blockSize)) {
+                            throw std::runtime_error("HashPipeline aborted");
+                        }
+                    }
+                }
+            });
+            if (filled > 0) {
+                publish(*block, filled);
+            }
+        } else {
+            // Read straight into the ring slots
+            for (;;) {
+                Block* block = acquireSlot();
+                if (block == nullptr) {
+                    break;
+                }
+                const size_t length = reader.readBlock(block->data.data(), m_blockSize);
+                if (length == 0 || !publish(*block, length)) {
+                    break;
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        endOfInput = true;
+        workAvailable.notify_all();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        fail(std::current_exception());
+    }
+
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace core
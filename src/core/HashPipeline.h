@@ -0,0 +1,78 @@
+#ifndef HASH_PIPELINE_H
+#define HASH_PIPELINE_H
+
+#include "IHashAlgorithm.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace core {
+
+class FileReader;
+
+/**
+ * @brief Parallel fan-out of one input stream to many hash algorithms.
+ *
+ * A single reader (the calling thread) fills a fixed ring of reference-counted
+ * block buffers. A pool of worker threads hashes the blocks: each task is
+ * "feed block N to algorithm A", and an algorithm is only ever fed by one
+ * worker at a time and always in block order. Idle workers pick the algorithm
+ * that is furthest behind, so cheap algorithms are naturally batched on
+ * whichever worker is free while expensive ones keep a worker busy.
+ *
+ * A block buffer is recycled once every algorithm has consumed it; when the
+ * slowest algorithm falls a full ring behind, the reader blocks (backpressure).
+ * Wall time therefore approaches the cost of the slowest algorithm rather
+ * than the sum of all of them.
+ *
+ * With a sync point set, the reader stops publishing every interval bytes,
+ * waits until all algorithms have caught up and calls back while they are
+ * all idle at the same offset.
+ */
+class HashPipeline {
+public:
+    /// @brief Default size of one ring buffer block
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+    /// @brief Default number of blocks in the ring
+    static constexpr size_t DEFAULT_BLOCK_COUNT = 16;
+
+    /// @param algorithms Algorithms to feed (not owned, must outlive run())
+    /// @param workerCount Number of hashing threads (0 = one per hardware thread)
+    explicit HashPipeline(const std::vector<IHashAlgorithm*>& algorithms, size_t workerCount = 0);
+
+    HashPipeline(const HashPipeline&) = delete;
+    HashPipeline& operator=(const HashPipeline&) = delete;
+
+    /// @brief Set ring geometry (must be called before run())
+    void setBuffers(size_t blockSize, size_t blockCount);
+
+    /// @brief Called on the reading thread while every algorithm is idle
+    /// @param bytesFed Bytes fed to every algorithm so far in this run
+    using SyncCallback = std::function<void(uint64_t bytesFed)>;
+
+    /// @brief Drain the pipeline about every interval bytes and call onSync, e.g. to
+    ///        save the algorithms' states (must be called before run())
+    void setSyncPoint(uint64_t interval, SyncCallback onSync);
+
+    /// @brief Read the whole file and feed every block to all algorithms
+    /// @throws std::runtime_error on read error or cancellation; any exception
+    ///         thrown by an algorithm is rethrown on the calling thread
+    void run(FileReader& reader);
+
+    /// @return Worker count that run() will use
+    size_t getWorkerCount() const { return m_workerCount; }
+
+private:
+    std::vector<IHashAlgorithm*> m_algorithms;
+    size_t m_workerCount;
+    size_t m_blockSize;
+    size_t m_blockCount;
+    uint64_t m_syncInterval;
+    SyncCallback m_onSync;
+};
+
+} // namespace core
+
+#endif // HASH_PIPELINE_H
@@ -0,0 +1,132 @@
+#include "HashState.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace core {
+
+namespace {
+
+const uint8_t STATE_MAGIC[4] = { 'H', 'C', 'S', 'T' };
+
+[[noreturn]] void throwMalformed(const char* what) {
+    throw std::invalid_argument(std::string("Invalid hash state: ") + what);
+}
+
+} // namespace
+
+HashStateWriter::HashStateWriter(const std::string& algorithm, uint64_t offset) {
+    if (algorithm.size() > 0xFFFF) {
+        throw std::invalid_argument("Invalid hash state: algorithm name too long");
+    }
+    m_data.reserve(64);
+    putBytes(STATE_MAGIC, sizeof(STATE_MAGIC));
+    putU8(static_cast<uint8_t>(FORMAT_VERSION));
+    putU8(static_cast<uint8_t>(FORMAT_VERSION >> 8));
+    putU8(static_cast<uint8_t>(algorithm.size()));
+    putU8(static_cast<uint8_t>(algorithm.size() >> 8));
+    putBytes(algorithm.data(), algorithm.size());
+    putU64(offset);
+}
+
+void HashStateWriter::putU32(uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        m_data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void HashStateWriter::putU64(uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        m_data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void HashStateWriter::putBytes(const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    m_data.insert(m_data.end(), bytes, bytes + length);
+}
+
+void HashStateWriter::putWords(const uint32_t* words, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        putU32(words[i]);
+    }
+}
+
+void HashStateWriter::putWords(const uint64_t* words, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        putU64(words[i]);
+    }
+}
+
+HashStateReader::HashStateReader(const std::vector<uint8_t>& state)
+    : m_state(state),
+      m_pos(0),
+      m_offset(0) {
+    if (memcmp(take(sizeof(STATE_MAGIC)), STATE_MAGIC, sizeof(STATE_MAGIC)) != 0) {
+        throwMalformed("bad signature");
+    }
+    uint16_t version = getU8();
+    version |= static_cast<uint16_t>(getU8()) << 8;
+    if (version != HashStateWriter::FORMAT_VERSION) {
+        throwMalformed("unsupported version");
+    }
+    size_t nameLength = getU8();
+    nameLength |= static_cast<size_t>(getU8()) << 8;
+    const uint8_t* name = take(nameLength);
+    m_algorithm.assign(reinterpret_cast<const char*>(name), nameLength);
+    m_offset = getU64();
+}
+
+const uint8_t* HashStateReader::take(size_t length) {
+    if (length > m_state.size() - m_pos) {
+        throwMalformed("truncated");
+    }
+    const uint8_t* data = m_state.data() + m_pos;
+    m_pos += length;
+    return data;
+}
+
+uint8_t HashStateReader::getU8() {
+    return *take(1);
+}
+
+uint32_t HashStateReader::getU32() {
+    const uint8_t* bytes = take(4);
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t HashStateReader::getU64() {
+    const uint8_t* bytes = take(8);
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+void HashStateReader::getBytes(void* data, size_t length) {
+    memcpy(data, take(length), length);
+}
+
+void HashStateReader::getWords(uint32_t* words, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        words[i] = getU32();
+    }
+}
+
+void HashStateReader::getWords(uint64_t* words, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        words[i] = getU64();
+    }
+}
+
+void HashStateReader::finish() const {
+    if (m_pos != m_state.size()) {
+        throwMalformed("trailing data");
+    }
+}
+
+} // namespace core
@@ -0,0 +1,92 @@
+#ifndef HASH_STATE_H
+#define HASH_STATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief Builds a saved hash state (see IHashAlgorithm::saveState).
+ *
+ * A state blob is laid out as
+ *   "HCST" | u16 format version | u16 name length | name | u64 byte offset | payload
+ * with every integer little-endian. The header is written here; the payload
+ * (chaining values, buffered input, counters) is appended by the algorithm
+ * and only ever read back by the same algorithm. Any change to a payload
+ * layout must bump FORMAT_VERSION so older states are rejected, not misread.
+ *
+ * Usage:
+ *   HashStateWriter writer(getName(), bytesProcessed);
+ *   writer.putWords(m_state, 8);
+ *   return writer.take();
+ */
+class HashStateWriter {
+public:
+    /// @brief Current layout version of the header and of every payload
+    static constexpr uint16_t FORMAT_VERSION = 1;
+
+    /// @param algorithm Algorithm name (IHashAlgorithm::getName)
+    /// @param offset Number of input bytes the state has absorbed
+    HashStateWriter(const std::string& algorithm, uint64_t offset);
+
+    void putU8(uint8_t value) { m_data.push_back(value); }
+    void putU32(uint32_t value);
+    void putU64(uint64_t value);
+    void putBytes(const void* data, size_t length);
+
+    /// @brief Append an array of words, each little-endian
+    void putWords(const uint32_t* words, size_t count);
+    void putWords(const uint64_t* words, size_t count);
+
+    /// @return The finished blob (the writer is empty afterwards)
+    std::vector<uint8_t> take() { return std::move(m_data); }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+/**
+ * @brief Parses a saved hash state produced by HashStateWriter.
+ *
+ * The header is checked on construction; payload reads throw once they run
+ * past the end, and finish() rejects trailing bytes, so a truncated or
+ * padded blob never loads silently.
+ */
+class HashStateReader {
+public:
+    /// @throws std::invalid_argument if the header is malformed or of another version
+    explicit HashStateReader(const std::vector<uint8_t>& state);
+
+    /// @return Algorithm name recorded in the header
+    const std::string& getAlgorithm() const { return m_algorithm; }
+
+    /// @return Number of input bytes the state had absorbed
+    uint64_t getOffset() const { return m_offset; }
+
+    /// @throws std::invalid_argument if the payload is too short
+    uint8_t getU8();
+    uint32_t getU32();
+    uint64_t getU64();
+    void getBytes(void* data, size_t length);
+    void getWords(uint32_t* words, size_t count);
+    void getWords(uint64_t* words, size_t count);
+
+    /// @brief Check that the whole payload was consumed
+    /// @throws std::invalid_argument if bytes are left over
+    void finish() const;
+
+private:
+    const uint8_t* take(size_t length);
+
+    const std::vector<uint8_t>& m_state;
+    size_t m_pos;
+    std::string m_algorithm;
+    uint64_t m_offset;
+};
+
+} // namespace core
+
+#endif // HASH_STATE_H
@@ -0,0 +1,67 @@
+#ifndef IBATCH_HASH_ALGORITHM_H
+#define IBATCH_HASH_ALGORITHM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief Interface for hashing many independent, complete messages at once.
+ *
+ * Implementations interleave the messages across the lanes of SIMD
+ * registers (multi-buffer hashing): every lane runs the compression
+ * function of a different message, and a lane whose message is done takes
+ * the next one while the others carry on, so messages of any mix of
+ * lengths keep the lanes busy. Digests are identical to those of the
+ * IHashAlgorithm of the same name.
+ *
+ * Usage:
+ *   auto batch = HashAlgorithmFactory::createBatch("SHA-256");
+ *   if (batch) {
+ *       auto digests = batch->computeMany(messages);
+ *   }
+ */
+class IBatchHashAlgorithm {
+public:
+    /// @brief One message, not owned; must stay valid during computeMany()
+    struct Message {
+        const uint8_t* data;
+        size_t length;
+    };
+
+    virtual ~IBatchHashAlgorithm() = default;
+
+    /// @return Algorithm name (e.g., "SHA-256"), as given to HashAlgorithmFactory::create
+    virtual std::string getName() const = 0;
+
+    /// @return Digest size in bytes
+    virtual size_t getDigestSize() const = 0;
+
+    /// @return Number of messages hashed side by side
+    virtual size_t getLanes() const = 0;
+
+    /// @brief Hash count messages
+    /// @param digests count * getDigestSize() bytes; message i's digest goes to i * getDigestSize()
+    virtual void computeMany(const Message* messages, size_t count, uint8_t* digests) = 0;
+
+    /// @brief Hash messages, returning one digest per message in the same order
+    std::vector<std::vector<uint8_t>> computeMany(const std::vector<Message>& messages) {
+        const size_t digestSize = getDigestSize();
+        std::vector<uint8_t> flat(messages.size() * digestSize);
+        computeMany(messages.data(), messages.size(), flat.data());
+
+        std::vector<std::vector<uint8_t>> digests;
+        digests.reserve(messages.size());
+        for (size_t i = 0; i < messages.size(); i++) {
+            digests.emplace_back(flat.begin() + i * digestSize, flat.begin() + (i + 1) * digestSize);
+        }
+        return digests;
+    }
+};
+
+} // namespace core
+
+#endif // IBATCH_HASH_ALGORITHM_H
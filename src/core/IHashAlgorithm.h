@@ -1,6 +1,7 @@
 #ifndef IHASH_ALGORITHM_H
 #define IHASH_ALGORITHM_H
 
+#include "ReadOptions.h"
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -9,6 +10,8 @@
 
 namespace core {
 
+class ThreadPool;
+
 /**
  * @brief Abstract interface for hash algorithms.
  * 
@@ -48,6 +51,55 @@ public:
     /// @brief Reset hash state for reuse
     virtual void reset() = 0;
 
+    // ===== Forking =====
+
+    /// @brief Deep copy including the running state: hash a common prefix once,
+    ///        then continue each copy with its own data
+    /// @note Callbacks, read options and the thread pool (not owned) carry over to the copy
+    virtual std::unique_ptr<IHashAlgorithm> clone() const = 0;
+
+    /// @brief Digest of the data absorbed so far, without finalizing or resetting
+    /// @note Equal to what finalize() would return now; update() may go on afterwards
+    virtual std::vector<uint8_t> peekDigest() const = 0;
+
+    // ===== Checkpointing =====
+
+    /// @return true if saveState() and loadState() are implemented
+    virtual bool supportsState() const { return false; }
+
+    /// @brief Serialize the running state so hashing can continue in another process
+    /// @return Versioned blob holding the chaining state and the byte offset (see HashState.h)
+    /// @throws std::runtime_error if the algorithm cannot save its state
+    virtual std::vector<uint8_t> saveState() const;
+
+    /// @brief Replace the running state with one produced by saveState()
+    /// @throws std::invalid_argument if the blob is malformed or from another algorithm
+    /// @throws std::runtime_error if the algorithm cannot load a state
+    virtual void loadState(const std::vector<uint8_t>& state);
+
+    // ===== Parallelism =====
+
+    /// @return true if update() can spread large inputs over a ThreadPool (tree hashes, CRCs)
+    virtual bool supportsThreadPool() const { return false; }
+
+    /// @brief Let update() hash parts of large inputs on the pool's workers
+    /// @param pool Pool to use (not owned, must outlive its use), nullptr to stop using it
+    /// @note The digest does not depend on the pool; ignored unless supportsThreadPool()
+    virtual void setThreadPool(ThreadPool* pool) { (void)pool; }
+
+    // ===== Work sharing =====
+
+    /// @return Key shared by algorithms whose update() does identical work and which
+    ///         differ only in finalization (e.g. "HAVAL/3" for every HAVAL-n/Pass3);
+    ///         empty if the algorithm shares its work with no other
+    virtual std::string getSharedStateKey() const { return std::string(); }
+
+    /// @brief Take over the running state of another algorithm with the same
+    ///        getSharedStateKey(), as if this one had absorbed the same input
+    /// @throws std::invalid_argument if other has a different key
+    /// @throws std::runtime_error if the algorithm shares no state
+    virtual void copySharedState(const IHashAlgorithm& other);
+
     // ===== Convenience methods =====
 
     /// @brief Compute hash of a string
@@ -65,6 +117,9 @@ public:
     /// @param callback Function to report progress updates
     void setProgressCallback(ProgressCallback callback) { m_progressCallback = callback; }
 
+    /// @brief Set file input options (block size, reads in flight) used by computeFile
+    void setReadOptions(const ReadOptions& options) { m_readOptions = options; }
+
     /// @brief Convert digest to hex string
     static std::string toHexString(const std::vector<uint8_t>& digest, bool uppercase = false);
 
@@ -87,6 +142,9 @@ protected:
 
     /// @brief Callback for progress reporting
     ProgressCallback m_progressCallback;
+
+    /// @brief File input options for computeFile
+    ReadOptions m_readOptions;
 };
 
 } // namespace core
@@ -0,0 +1,253 @@
+#include "IoRing.h"
+#include <sstream>
+#include <stdexcept>
+#include <windows.h>
+
+namespace core {
+
+namespace {
+
+// Mirrors of the ioringapi.h declarations. The SDK header needs a Windows 11
+// target, so the types are repeated here and the functions are resolved at
+// run time; layouts match the SDK.
+
+typedef struct IoRingHandle* HIORING_;
+
+enum IoRingVersion { IORING_VERSION_1_ = 1 };
+enum IoRingOpCode { IORING_OP_READ_ = 1, IORING_OP_REGISTER_BUFFERS_ = 3 };
+enum IoRingRefKind { IORING_REF_RAW_ = 0, IORING_REF_REGISTERED_ = 1 };
+
+struct IoRingCapabilities {
+    int MaxVersion;
+    UINT32 MaxSubmissionQueueSize;
+    UINT32 MaxCompletionQueueSize;
+    int FeatureFlags;
+};
+
+struct IoRingCreateFlags {
+    int Required;
+    int Advisory;
+};
+
+struct IoRingHandleRef {
+    int Kind;
+    union {
+        HANDLE Handle;
+        UINT32 Index;
+    } Handle;
+};
+
+struct IoRingBufferRef {
+    int Kind;
+    union {
+        void* Address;
+        struct {
+            UINT32 BufferIndex;
+            UINT32 Offset;
+        } IndexAndOffset;
+    } Buffer;
+};
+
+struct IoRingBufferInfo {
+    void* Address;
+    UINT32 Length;
+};
+
+struct IoRingCqe {
+    UINT_PTR UserData;
+    HRESULT ResultCode;
+    ULONG_PTR Information;
+};
+
+typedef HRESULT (WINAPI *QueryIoRingCapabilitiesFn)(IoRingCapabilities*);
+typedef BOOL (WINAPI *IsIoRingOpSupportedFn)(HIORING_, int);
+typedef HRESULT (WINAPI *CreateIoRingFn)(int, IoRingCreateFlags, UINT32, UINT32, HIORING_*);
+typedef HRESULT (WINAPI *CloseIoRingFn)(HIORING_);
+typedef HRESULT (WINAPI *BuildIoRingRegisterBuffersFn)(HIORING_, UINT32, const IoRingBufferInfo*, UINT_PTR);
+typedef HRESULT (WINAPI *BuildIoRingReadFileFn)(HIORING_, IoRingHandleRef, IoRingBufferRef, UINT32, UINT64, UINT_PTR, int);
+typedef HRESULT (WINAPI *SubmitIoRingFn)(HIORING_, UINT32, UINT32, UINT32*);
+typedef HRESULT (WINAPI *PopIoRingCompletionFn)(HIORING_, IoRingCqe*);
+
+/// @brief I/O ring entry points, resolved once per process
+struct IoRingApi {
+    QueryIoRingCapabilitiesFn queryCapabilities;
+    IsIoRingOpSupportedFn isOpSupported;
+    CreateIoRingFn create;
+    CloseIoRingFn close;
+    BuildIoRingRegisterBuffersFn registerBuffers;
+    BuildIoRingReadFileFn readFile;
+    SubmitIoRingFn submit;
+    PopIoRingCompletionFn popCompletion;
+    bool loaded;
+};
+
+const IoRingApi& getApi() {
+    static const IoRingApi api = []() {
+        IoRingApi result = {};
+        HMODULE kernelBase = GetModuleHandleW(L"kernelbase.dll");
+        if (kernelBase == NULL) {
+            return result;
+        }
+        result.queryCapabilities = reinterpret_cast<QueryIoRingCapabilitiesFn>(
+            GetProcAddress(kernelBase, "QueryIoRingCapabilities"));
+        result.isOpSupported = reinterpret_cast<IsIoRingOpSupportedFn>(
+            GetProcAddress(kernelBase, "IsIoRingOpSupported"));
+        result.create = reinterpret_cast<CreateIoRingFn>(
+            GetProcAddress(kernelBase, "CreateIoRing"));
+        result.close = reinterpret_cast<CloseIoRingFn>(
+            GetProcAddress(kernelBase, "CloseIoRing"));
+        result.registerBuffers = reinterpret_cast<BuildIoRingRegisterBuffersFn>(
+            GetProcAddress(kernelBase, "BuildIoRingRegisterBuffers"));
+        result.readFile = reinterpret_cast<BuildIoRingReadFileFn>(
+            GetProcAddress(kernelBase, "BuildIoRingReadFile"));
+        result.submit = reinterpret_cast<SubmitIoRingFn>(
+            GetProcAddress(kernelBase, "SubmitIoRing"));
+        result.popCompletion = reinterpret_cast<PopIoRingCompletionFn>(
+            GetProcAddress(kernelBase, "PopIoRingCompletion"));
+        result.loaded = result.queryCapabilities && result.isOpSupported && result.create &&
+                        result.close && result.registerBuffers && result.readFile &&
+                        result.submit && result.popCompletion;
+        return result;
+    }();
+    return api;
+}
+
+unsigned long toWin32Error(HRESULT hr) {
+    if (HRESULT_FACILITY(hr) == FACILITY_WIN32) {
+        return HRESULT_CODE(hr);
+    }
+    return static_cast<unsigned long>(hr);
+}
+
+[[noreturn]] void throwRingError(const char* what, HRESULT hr) {
+    std::ostringstream oss;
+    oss << what << ". Error code: " << toWin32Error(hr);
+    throw std::runtime_error(oss.str());
+}
+
+} // namespace
+
+bool IoRing::isAvailable() {
+    const IoRingApi& api = getApi();
+    if (!api.loaded) {
+        return false;
+    }
+    IoRingCapabilities capabilities = {};
+    return SUCCEEDED(api.queryCapabilities(&capabilities)) &&
+           capabilities.MaxVersion >= IORING_VERSION_1_;
+}
+
+IoRing::IoRing(uint32_t queueDepth)
+    : m_ring(nullptr),
+      m_pending(0) {
+    const IoRingApi& api = getApi();
+    if (!api.loaded) {
+        throw std::runtime_error("I/O rings are not supported on this system");
+    }
+
+    // One extra submission entry for the buffer registration
+    IoRingCreateFlags flags = {};
+    HIORING_ ring = nullptr;
+    HRESULT hr = api.create(IORING_VERSION_1_, flags, queueDepth + 1, (queueDepth + 1) * 2, &ring);
+    if (FAILED(hr)) {
+        throwRingError("Cannot create I/O ring", hr);
+    }
+    m_ring = ring;
+
+    if (!api.isOpSupported(ring, IORING_OP_READ_) ||
+        !api.isOpSupported(ring, IORING_OP_REGISTER_BUFFERS_)) {
+        api.close(ring);
+        m_ring = nullptr;
+        throw std::runtime_error("I/O ring does not support buffered file reads");
+    }
+}
+
+IoRing::~IoRing() {
+    if (m_ring == nullptr) {
+        return;
+    }
+    const IoRingApi& api = getApi();
+    HIORING_ ring = static_cast<HIORING_>(m_ring);
+
+    // The kernel still owns buffers of reads in flight: let them finish first
+    if (m_pending > 0) {
+        UINT32 submitted = 0;
+        api.submit(ring, m_pending, INFINITE, &submitted);
+    }
+    api.close(ring);
+}
+
+void IoRing::registerBuffers(const std::vector<BufferInfo>& buffers) {
+    const IoRingApi& api = getApi();
+    HIORING_ ring = static_cast<HIORING_>(m_ring);
+
+    std::vector<IoRingBufferInfo> infos(buffers.size());
+    for (size_t i = 0; i < buffers.size(); i++) {
+        infos[i].Address = buffers[i].address;
+        infos[i].Length = buffers[i].length;
+    }
+
+    HRESULT hr = api.registerBuffers(ring, static_cast<UINT32>(infos.size()), infos.data(), 0);
+    if (FAILED(hr)) {
+        throwRingError("Cannot register I/O ring buffers", hr);
+    }
+
+    // Registration completes like any other operation; wait for it here so
+    // callers only ever see read completions
+    m_pending++;
+    submit(1);
+    Completion completion;
+    if (!popCompletion(completion)) {
+        throw std::runtime_error("I/O ring buffer registration did not complete");
+    }
+    if (completion.error != 0) {
+        std::ostringstream oss;
+        oss << "Cannot register I/O ring buffers. Error code: " << completion.error;
+        throw std::runtime_error(oss.str());
+    }
+}
+
+void IoRing::queueRead(void* hFile, uint32_t bufferIndex, uint32_t length, uint64_t offset, uintptr_t userData) {
+    const IoRingApi& api = getApi();
+
+    IoRingHandleRef fileRef = {};
+    fileRef.Kind = IORING_REF_RAW_;
+    fileRef.Handle.Handle = static_cast<HANDLE>(hFile);
+
+    IoRingBufferRef bufferRef = {};
+    bufferRef.Kind = IORING_REF_REGISTERED_;
+    bufferRef.Buffer.IndexAndOffset.BufferIndex = bufferIndex;
+    bufferRef.Buffer.IndexAndOffset.Offset = 0;
+
+    HRESULT hr = api.readFile(static_cast<HIORING_>(m_ring), fileRef, bufferRef,
+                              length, offset, userData, 0);
+    if (FAILED(hr)) {
+        throwRingError("Cannot queue I/O ring read", hr);
+    }
+    m_pending++;
+}
+
+void IoRing::submit(uint32_t waitCount) {
+    UINT32 submitted = 0;
+    HRESULT hr = getApi().submit(static_cast<HIORING_>(m_ring), waitCount, INFINITE, &submitted);
+    if (FAILED(hr)) {
+        throwRingError("Cannot submit I/O ring", hr);
+    }
+}
+
+bool IoRing::popCompletion(Completion& completion) {
+    IoRingCqe cqe = {};
+    HRESULT hr = getApi().popCompletion(static_cast<HIORING_>(m_ring), &cqe);
+    if (hr != S_OK) {
+        // S_FALSE: queue is empty
+        return false;
+    }
+    m_pending--;
+
+    completion.userData = cqe.UserData;
+    completion.bytesRead = static_cast<uint32_t>(cqe.Information);
+    completion.error = SUCCEEDED(cqe.ResultCode) ? 0 : toWin32Error(cqe.ResultCode);
+    return true;
+}
+
+} // namespace core
@@ -0,0 +1,82 @@
+#ifndef IO_RING_H
+#define IO_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief Thin wrapper over the Windows I/O ring API (ioringapi.h).
+ *
+ * The API exists only on Windows 11 and later, so every entry point is
+ * resolved from kernelbase.dll at run time; isAvailable() tells callers
+ * whether to use the ring or fall back to overlapped reads. Only what the
+ * file reader needs is wrapped: registered buffers, queued reads at explicit
+ * offsets and completion polling.
+ *
+ * The destructor waits for reads still in flight, so the registered buffers
+ * must outlive the ring.
+ *
+ * Usage:
+ *   IoRing ring(8);
+ *   ring.registerBuffers(buffers);
+ *   ring.queueRead(hFile, 0, 65536, 0, 0);
+ *   ring.submit(1);
+ *   IoRing::Completion completion;
+ *   while (ring.popCompletion(completion)) { ... }
+ */
+class IoRing {
+public:
+    /// @brief Memory region to register with the ring
+    struct BufferInfo {
+        void* address;
+        uint32_t length;
+    };
+
+    /// @brief Result of one finished read
+    struct Completion {
+        uintptr_t userData;  ///< Value passed to queueRead
+        uint32_t bytesRead;  ///< Bytes transferred
+        unsigned long error; ///< Win32 error code (0 on success)
+    };
+
+    /// @return true if the running system supports I/O rings with file reads
+    static bool isAvailable();
+
+    /// @param queueDepth Maximum number of reads in flight
+    /// @throws std::runtime_error if the ring cannot be created
+    explicit IoRing(uint32_t queueDepth);
+    ~IoRing();
+
+    IoRing(const IoRing&) = delete;
+    IoRing& operator=(const IoRing&) = delete;
+
+    /// @brief Pin buffers with the kernel so reads skip per-request probing and locking
+    /// @throws std::runtime_error on failure
+    void registerBuffers(const std::vector<BufferInfo>& buffers);
+
+    /// @brief Queue a read into a registered buffer (sent by the next submit())
+    /// @throws std::runtime_error if the submission queue is full
+    void queueRead(void* hFile, uint32_t bufferIndex, uint32_t length, uint64_t offset, uintptr_t userData);
+
+    /// @brief Submit queued reads and wait until at least waitCount have completed
+    /// @throws std::runtime_error on failure
+    void submit(uint32_t waitCount);
+
+    /// @brief Fetch the next completion without blocking
+    /// @return false if the completion queue is empty
+    bool popCompletion(Completion& completion);
+
+    /// @return Reads submitted or queued that have not been popped yet
+    uint32_t getPending() const { return m_pending; }
+
+private:
+    void* m_ring;
+    uint32_t m_pending;
+};
+
+} // namespace core
+
+#endif // IO_RING_H
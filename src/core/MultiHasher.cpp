@@ -0,0 +1,280 @@
+#include "MultiHasher.h"
+#include "AlignedBufferPool.h"
+#include "FileReader.h"
+#include "HashPipeline.h"
+#include "HashState.h"
+#include "ThreadPool.h"
+#include <stdexcept>
+
+namespace core {
+
+namespace {
+
+/// @brief Lends a thread pool to the algorithms that can split one update() over
+///        several threads (tree hashes, CRCs), for the lifetime of the object
+class TreePoolScope {
+public:
+    TreePoolScope(const std::vector<std::unique_ptr<IHashAlgorithm>>& algorithms, size_t threadCount)
+        : m_algorithms(algorithms) {
+        for (const auto& algorithm : m_algorithms) {
+            if (algorithm->supportsThreadPool()) {
+                if (!m_pool) {
+                    m_pool.reset(new ThreadPool(threadCount));
+                }
+                algorithm->setThreadPool(m_pool.get());
+            }
+        }
+    }
+
+    ~TreePoolScope() {
+        if (m_pool) {
+            for (const auto& algorithm : m_algorithms) {
+                algorithm->setThreadPool(nullptr);
+            }
+        }
+    }
+
+    TreePoolScope(const TreePoolScope&) = delete;
+    TreePoolScope& operator=(const TreePoolScope&) = delete;
+
+private:
+    const std::vector<std::unique_ptr<IHashAlgorithm>>& m_algorithms;
+    std::unique_ptr<ThreadPool> m_pool;
+};
+
+} // namespace
+
+size_t MultiHasher::add(std::unique_ptr<IHashAlgorithm> algorithm) {
+    if (!algorithm) {
+        throw std::invalid_argument("MultiHasher: null algorithm");
+    }
+    // The first algorithm of a shared state key does the work for all of them
+    const size_t index = m_algorithms.size();
+    const std::string key = algorithm->getSharedStateKey();
+    size_t owner = index;
+    if (!key.empty()) {
+        for (size_t i = 0; i < index && owner == index; i++) {
+            if (m_algorithms[i]->getSharedStateKey() == key) {
+                owner = i;
+            }
+        }
+    }
+    if (owner == index) {
+        m_fed.push_back(algorithm.get());
+    } else {
+        m_shared.emplace_back(index, owner);
+    }
+    m_algorithms.push_back(std::move(algorithm));
+    return index;
+}
+
+std::vector<std::vector<uint8_t>> MultiHasher::computeString(const std::string& str) {
+    return computeData(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+}
+
+std::vector<std::vector<uint8_t>> MultiHasher::computeData(const uint8_t* data, size_t length) {
+    resetAll();
+    if (m_threadCount != 1 && length >= PARALLEL_THRESHOLD) {
+        TreePoolScope treePool(m_algorithms, m_threadCount);
+        updateAll(data, length);
+    } else {
+        updateAll(data, length);
+    }
+    return finalizeAll();
+}
+
+std::vector<std::vector<uint8_t>> MultiHasher::computeFile(const std::wstring& filePath) {
+    return hashFile(filePath, nullptr);
+}
+
+std::vector<std::vector<uint8_t>> MultiHasher::resumeFile(const std::wstring& filePath,
+                                                          const Checkpoint& checkpoint) {
+    if (checkpoint.states.size() != m_algorithms.size()) {
+        throw std::invalid_argument("Checkpoint does not match the selected algorithms");
+    }
+    for (const std::vector<uint8_t>& state : checkpoint.states) {
+        if (HashStateReader(state).getOffset() != checkpoint.offset) {
+            throw std::invalid_argument("Checkpoint states were saved at different offsets");
+        }
+    }
+    return hashFile(filePath, &checkpoint);
+}
+
+bool MultiHasher::supportsState() const {
+    for (const auto& algorithm : m_algorithms) {
+        if (!algorithm->supportsState()) {
+            return false;
+        }
+    }
+    return !m_algorithms.empty();
+}
+
+std::vector<std::vector<uint8_t>> MultiHasher::hashFile(const std::wstring& filePath,
+                                                        const Checkpoint* resume) {
+    const bool checkpointing = m_checkpointCallback && m_checkpointInterval > 0 && supportsState();
+    m_appendOffset = 0;
+
+    DigestCache::FileKey key;
+    bool haveKey = false;
+    if (m_digestCache != nullptr || checkpointing || resume != nullptr) {
+        haveKey = DigestCache::queryFileKey(filePath, key);
+    }
+
+    const bool cacheable = haveKey && m_digestCache != nullptr && m_cacheNames.size() == m_algorithms.size();
+    if (cacheable) {
+        std::vector<std::vector<uint8_t>> cached;
+        if (m_digestCache->lookup(key, m_cacheNames, cached)) {
+            if (m_progressCallback) {
+                m_progressCallback(key.size, key.size);
+            }
+            return cached;
+        }
+    }
+
+    const bool appendable = cacheable && m_appendMode && supportsState();
+    uint64_t startOffset = 0;
+    if (resume != nullptr) {
+        if (!haveKey || key != resume->file) {
+            throw std::runtime_error("File was modified since the checkpoint was saved");
+        }
+        for (size_t i = 0; i < m_algorithms.size(); i++) {
+            m_algorithms[i]->loadState(resume->states[i]);
+        }
+        startOffset = resume->offset;
+    } else {
+        resetAll();
+        if (appendable) {
+            startOffset = m_appendOffset = loadTail(filePath, key);
+        }
+    }
+
+    if (checkpointing && !haveKey) {
+        throw std::runtime_error("Cannot identify file for checkpointing");
+    }
+
+    // Unbuffered reads cannot start mid-sector; an appended tail is small enough to stream
+    ReadOptions options = m_readOptions;
+    if (options.mode == ReadMode::Direct && startOffset % AlignedBufferPool::alignment() != 0) {
+        options.mode = ReadMode::Stream;
+    }
+    FileReader reader(filePath, options);
+    reader.setCancelCallback(m_cancelCallback);
+    reader.setProgressCallback(m_progressCallback);
+
+    if (startOffset > 0) {
+        reader.seek(startOffset);
+    }
+
+    // Every algorithm has absorbed the same bytes whenever this is called
+    auto saveCheckpoint = [&](uint64_t bytesFed) {
+        syncShared();
+        Checkpoint checkpoint;
+        checkpoint.file = key;
+        checkpoint.offset = startOffset + bytesFed;
+        checkpoint.states.reserve(m_algorithms.size());
+        for (auto& algorithm : m_algorithms) {
+            checkpoint.states.push_back(algorithm->saveState());
+        }
+        m_checkpointCallback(checkpoint);
+    };
+
+    // Large files: tree hashes also split each block over threads of their own
+    const bool parallel = m_threadCount != 1 && reader.getFileSize() - startOffset >= PARALLEL_THRESHOLD;
+    std::unique_ptr<TreePoolScope> treePool;
+    if (parallel) {
+        treePool.reset(new TreePoolScope(m_algorithms, m_threadCount));
+    }
+
+    if (m_fed.size() > 1 && parallel) {
+        HashPipeline pipeline(m_fed, m_threadCount);
+        if (checkpointing) {
+            pipeline.setSyncPoint(m_checkpointInterval, saveCheckpoint);
+        }
+        pipeline.run(reader);
+    } else {
+        uint64_t bytesFed = 0;
+        uint64_t nextCheckpoint = m_checkpointInterval;
+        reader.read([&](const uint8_t* data, size_t length) {
+            updateAll(data, length);
+            bytesFed += length;
+            if (checkpointing && bytesFed >= nextCheckpoint) {
+                saveCheckpoint(bytesFed);
+                nextCheckpoint = bytesFed - bytesFed % m_checkpointInterval + m_checkpointInterval;
+            }
+        });
+    }
+
+    DigestCache::Tail tail;
+    if (appendable) {
+        syncShared();
+        tail.key = key;
+        for (auto& algorithm : m_algorithms) {
+            tail.states.push_back(algorithm->saveState());
+        }
+    }
+    std::vector<std::vector<uint8_t>> digests = finalizeAll();
+
+    // Only cache the result if the file did not change while it was read
+    const bool haveTail = appendable && DigestCache::fingerprint(filePath, key.size, tail.fingerprint);
+    DigestCache::FileKey after;
+    if (cacheable && DigestCache::queryFileKey(filePath, after) && after == key) {
+        m_digestCache->store(key, m_cacheNames, digests, haveTail ? &tail : nullptr);
+    }
+    return digests;
+}
+
+uint64_t MultiHasher::loadTail(const std::wstring& filePath, const DigestCache::FileKey& key) {
+    // Same file, longer than when hashed, and its old last bytes unchanged
+    DigestCache::Tail tail;
+    uint64_t fingerprint = 0;
+    if (!m_digestCache->lookupTail(key, m_cacheNames, tail) ||
+        tail.key.size == 0 || tail.key.size >= key.size ||
+        !DigestCache::fingerprint(filePath, tail.key.size, fingerprint) || fingerprint != tail.fingerprint) {
+        return 0;
+    }
+
+    try {
+        for (size_t i = 0; i < m_algorithms.size(); i++) {
+            m_algorithms[i]->loadState(tail.states[i]);
+            if (HashStateReader(tail.states[i]).getOffset() != tail.key.size) {
+                throw std::invalid_argument("Cached state does not end at the cached size");
+            }
+        }
+    } catch (const std::invalid_argument&) {
+        // Saved by an incompatible version: hash the whole file instead
+        resetAll();
+        return 0;
+    }
+    return tail.key.size;
+}
+
+void MultiHasher::resetAll() {
+    for (auto& algorithm : m_algorithms) {
+        algorithm->reset();
+    }
+}
+
+void MultiHasher::syncShared() {
+    for (const auto& [index, owner] : m_shared) {
+        m_algorithms[index]->copySharedState(*m_algorithms[owner]);
+    }
+}
+
+void MultiHasher::updateAll(const uint8_t* data, size_t length) {
+    for (IHashAlgorithm* algorithm : m_fed) {
+        algorithm->update(data, length);
+    }
+}
+
+std::vector<std::vector<uint8_t>> MultiHasher::finalizeAll() {
+    // Fork shared states before their owners are finalized (and reset)
+    syncShared();
+    std::vector<std::vector<uint8_t>> digests;
+    digests.reserve(m_algorithms.size());
+    for (auto& algorithm : m_algorithms) {
+        digests.push_back(algorithm->finalize());
+    }
+    return digests;
+}
+
+} // namespace core
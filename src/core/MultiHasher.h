@@ -0,0 +1,175 @@
+#ifndef MULTI_HASHER_H
+#define MULTI_HASHER_H
+
+#include "IHashAlgorithm.h"
+#include "DigestCache.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief Computes several digests over one read of the input.
+ *
+ * The file is read exactly once regardless of how many algorithms are
+ * selected. With several algorithms and a large enough file the blocks are
+ * fanned out to a pool of worker threads (see HashPipeline); otherwise every
+ * block is fed to all algorithms in turn while it is still hot in cache.
+ * Tree hashes such as BLAKE3 and the CRCs additionally hash each large block
+ * on a thread pool (see IHashAlgorithm::setThreadPool), so one algorithm over one file
+ * still uses every core.
+ * Algorithms that absorb input identically (same getSharedStateKey(), e.g.
+ * every HAVAL size of one pass count) are fed as one: only the first is
+ * updated, and the others copy its state before they are finalized or saved.
+ * Progress and cancellation are reported as a single stream for the whole set.
+ * With a DigestCache attached, a file whose digests are all cached is not
+ * read at all, and freshly computed digests are added to the cache.
+ * With a checkpoint callback set, the state of every algorithm is saved at
+ * regular offsets so that resumeFile() can finish an interrupted run.
+ * In append mode the cache also keeps every algorithm's state at the end of
+ * the file; when the file has only grown since, just the new data is read.
+ *
+ * Usage:
+ *   MultiHasher hasher;
+ *   hasher.add(HashAlgorithmFactory::create("SHA-256"));
+ *   hasher.add(HashAlgorithmFactory::create("MD5"));
+ *   auto digests = hasher.computeFile(L"C:\\data.bin"); // in add() order
+ */
+class MultiHasher {
+public:
+    /// @brief Progress through one file, saved so that hashing can resume later
+    struct Checkpoint {
+        DigestCache::FileKey file;                ///< Identity and version of the file
+        uint64_t offset = 0;                      ///< Bytes absorbed by every algorithm
+        std::vector<std::vector<uint8_t>> states; ///< IHashAlgorithm::saveState() in add() order
+    };
+
+    /// @brief Receives each checkpoint; called between blocks on the reading thread
+    using CheckpointCallback = std::function<void(const Checkpoint& checkpoint)>;
+
+    /// @brief Default distance between checkpoints
+    static constexpr uint64_t DEFAULT_CHECKPOINT_INTERVAL = 1024ull * 1024 * 1024;
+
+    MultiHasher() : m_threadCount(0), m_digestCache(nullptr), m_appendMode(false), m_appendOffset(0),
+                    m_checkpointInterval(0) {}
+
+    MultiHasher(const MultiHasher&) = delete;
+    MultiHasher& operator=(const MultiHasher&) = delete;
+
+    /// @brief Add an algorithm to the set
+    /// @return Index of the algorithm's digest in the computed results
+    size_t add(std::unique_ptr<IHashAlgorithm> algorithm);
+
+    /// @return Number of algorithms in the set
+    size_t size() const { return m_algorithms.size(); }
+
+    /// @return true if no algorithm has been added
+    bool empty() const { return m_algorithms.empty(); }
+
+    /// @brief Set cancellation callback for the whole set
+    void setCancelCallback(IHashAlgorithm::CancelCallback callback) { m_cancelCallback = callback; }
+
+    /// @brief Set progress callback for the whole set
+    void setProgressCallback(IHashAlgorithm::ProgressCallback callback) { m_progressCallback = callback; }
+
+    /// @brief Set file input options (block size, reads in flight)
+    void setReadOptions(const ReadOptions& options) { m_readOptions = options; }
+
+    /// @brief Set number of hashing threads for large files and buffers
+    /// @param threadCount 0 = one per hardware thread, 1 = hash on the calling thread
+    void setThreadCount(size_t threadCount) { m_threadCount = threadCount; }
+
+    /// @brief Consult and update a digest cache in computeFile()
+    /// @param cache Cache to use (not owned), nullptr to disable
+    /// @param names Factory names of the algorithms, in add() order
+    void setDigestCache(DigestCache* cache, const std::vector<std::string>& names) {
+        m_digestCache = cache;
+        m_cacheNames = names;
+    }
+
+    /// @brief Hash only data appended since the file was last hashed (needs a digest cache)
+    ///
+    /// The state of every algorithm at the end of the file is kept in the cache with
+    /// a fingerprint of the last DigestCache::FINGERPRINT_SIZE bytes. A later
+    /// computeFile() on the same file, grown and with those bytes unchanged, loads
+    /// the states and reads from the old end on. Digests equal a full rehash for
+    /// files that are only ever appended to.
+    /// @note Has no effect unless supportsState() is true
+    void setAppendMode(bool enabled) { m_appendMode = enabled; }
+
+    /// @return Offset the last computeFile() continued from in append mode, 0 if it
+    ///         hashed the whole file or answered from the cache
+    uint64_t getAppendOffset() const { return m_appendOffset; }
+
+    /// @brief Save a checkpoint every interval bytes in computeFile() and resumeFile()
+    /// @note No checkpoints are taken unless supportsState() is true
+    void setCheckpointCallback(CheckpointCallback callback,
+                               uint64_t interval = DEFAULT_CHECKPOINT_INTERVAL) {
+        m_checkpointCallback = callback;
+        m_checkpointInterval = interval;
+    }
+
+    /// @return true if every algorithm in the set can save and load its state
+    bool supportsState() const;
+
+    /// @brief Minimum file size for which the parallel pipeline is used
+    static constexpr uint64_t PARALLEL_THRESHOLD = 1024 * 1024;
+
+    /// @brief Hash a string with every algorithm
+    /// @return Digests in add() order
+    std::vector<std::vector<uint8_t>> computeString(const std::string& str);
+
+    /// @brief Hash an in-memory buffer with every algorithm
+    /// @return Digests in add() order
+    std::vector<std::vector<uint8_t>> computeData(const uint8_t* data, size_t length);
+
+    /// @brief Hash a file with every algorithm, reading it only once
+    /// @return Digests in add() order
+    /// @throws std::runtime_error if file cannot be read or operation is cancelled
+    std::vector<std::vector<uint8_t>> computeFile(const std::wstring& filePath);
+
+    /// @brief Finish hashing a file from a checkpoint taken by an earlier run
+    /// @return Digests in add() order, the same as computeFile() would return
+    /// @throws std::invalid_argument if the checkpoint does not fit the algorithms
+    /// @throws std::runtime_error if the file changed since the checkpoint, cannot be
+    ///         read or the operation is cancelled
+    std::vector<std::vector<uint8_t>> resumeFile(const std::wstring& filePath, const Checkpoint& checkpoint);
+
+private:
+    std::vector<std::vector<uint8_t>> hashFile(const std::wstring& filePath, const Checkpoint* resume);
+
+    /// @brief Load the cached states of an appended-to file
+    /// @return Offset to continue hashing from, 0 if the file must be hashed in full
+    uint64_t loadTail(const std::wstring& filePath, const DigestCache::FileKey& key);
+    void resetAll();
+
+    /// @brief Bring every algorithm that shares another's work up to its state
+    void syncShared();
+    void updateAll(const uint8_t* data, size_t length);
+    std::vector<std::vector<uint8_t>> finalizeAll();
+
+    std::vector<std::unique_ptr<IHashAlgorithm>> m_algorithms;
+    std::vector<IHashAlgorithm*> m_fed;                // Algorithms that update() is called on
+    std::vector<std::pair<size_t, size_t>> m_shared;   // (algorithm, algorithm whose state it shares)
+    size_t m_threadCount;
+    ReadOptions m_readOptions;
+
+    DigestCache* m_digestCache;
+    std::vector<std::string> m_cacheNames;
+    bool m_appendMode;
+    uint64_t m_appendOffset;
+
+    CheckpointCallback m_checkpointCallback;
+    uint64_t m_checkpointInterval;
+
+    IHashAlgorithm::CancelCallback m_cancelCallback;
+    IHashAlgorithm::ProgressCallback m_progressCallback;
+};
+
+} // namespace core
+
+#endif // MULTI_HASHER_H
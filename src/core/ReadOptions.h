@@ -0,0 +1,55 @@
+#ifndef READ_OPTIONS_H
+#define READ_OPTIONS_H
+
+#include <cstddef>
+
+namespace core {
+
+/**
+ * @brief File input backend.
+ */
+enum class ReadMode {
+    Auto,   ///< Mapped for large files, streamed reads otherwise
+    Stream, ///< ReadFile into staging buffers (overlapped when queueDepth > 1)
+    Mapped, ///< MapViewOfFile in sliding windows, hashed straight from the page cache;
+            ///< Stream on compilers without structured exception handling (see FileReader)
+    Direct, ///< FILE_FLAG_NO_BUFFERING: bypass the file cache (bulk scans); never chosen by Auto
+    IoRing  ///< Windows 11 I/O ring with registered buffers; falls back to Stream when unavailable
+};
+
+/**
+ * @brief Tuning knobs for file input used by computeFile and MultiHasher.
+ */
+struct ReadOptions {
+    /// @brief Default size of one read request
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    /// @brief Default number of read requests kept in flight
+    static constexpr size_t DEFAULT_QUEUE_DEPTH = 2;
+
+    /// @brief Files at least this large are mapped in ReadMode::Auto
+    static constexpr unsigned long long MAPPED_THRESHOLD = 16ull * 1024 * 1024;
+
+    /// @brief Size of one mapped view (multiple of the allocation granularity)
+    static constexpr size_t MAPPED_WINDOW_SIZE = 64 * 1024 * 1024;
+
+    /// @brief Suggested block size for ReadMode::Direct (no cache read-ahead to lean on)
+    static constexpr size_t DIRECT_BLOCK_SIZE = 1024 * 1024;
+
+    /// @brief Suggested queue depth for ReadMode::Direct
+    static constexpr size_t DIRECT_QUEUE_DEPTH = 4;
+
+    /// @brief Suggested block size for ReadMode::IoRing
+    static constexpr size_t IORING_BLOCK_SIZE = 256 * 1024;
+
+    /// @brief Suggested queue depth for ReadMode::IoRing (NVMe needs 8-32 outstanding reads)
+    static constexpr size_t IORING_QUEUE_DEPTH = 16;
+
+    ReadMode mode = ReadMode::Auto;          ///< Input backend
+    size_t blockSize = DEFAULT_BLOCK_SIZE;   ///< Bytes per read request / per delivered block
+    size_t queueDepth = DEFAULT_QUEUE_DEPTH; ///< Reads in flight (1 = plain synchronous reads)
+};
+
+} // namespace core
+
+#endif // READ_OPTIONS_H
@@ -0,0 +1,233 @@
+#include "ThreadPool.h"
+#include <windows.h>
+
+namespace core {
+
+namespace {
+
+// Pool and worker index of the current thread (null/SIZE_MAX outside any pool)
+thread_local const ThreadPool* t_pool = nullptr;
+thread_local size_t t_workerIndex = SIZE_MAX;
+
+size_t countBits(ULONG_PTR mask) {
+    size_t count = 0;
+    while (mask != 0) {
+        mask &= mask - 1;
+        count++;
+    }
+    return count;
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : m_nextQueue(0),
+      m_queued(0),
+      m_pending(0),
+      m_stopping(false) {
+    if (threadCount == 0) {
+        threadCount = defaultThreadCount();
+    }
+
+    for (size_t i = 0; i < threadCount; i++) {
+        m_queues.emplace_back(new WorkQueue());
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    size_t index = currentWorkerIndex();
+    if (index == SIZE_MAX) {
+        index = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queued++;
+        m_pending++;
+    }
+    m_workAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_allDone.wait(lock, [this]() { return m_pending == 0; });
+
+    if (m_error) {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::join(const Task& first, const Task& second) {
+    // Whoever sets claimed runs second; the queued copy finds it set and does nothing
+    struct Shared {
+        std::atomic<bool> claimed{false};
+        std::mutex mutex;
+        std::condition_variable finished;
+        bool done = false;
+        std::exception_ptr error;
+    };
+    auto shared = std::make_shared<Shared>();
+
+    submit([shared, &second]() {
+        if (shared->claimed.exchange(true)) {
+            return;
+        }
+        try {
+            second();
+        } catch (...) {
+            shared->error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->done = true;
+        shared->finished.notify_one();
+    });
+
+    std::exception_ptr firstError;
+    try {
+        first();
+    } catch (...) {
+        firstError = std::current_exception();
+    }
+
+    if (!shared->claimed.exchange(true)) {
+        // Not started yet: run it here rather than wait for a worker to get to it
+        try {
+            second();
+        } catch (...) {
+            shared->error = std::current_exception();
+        }
+    } else {
+        // A worker is running it; second may reference this stack frame, so wait
+        std::unique_lock<std::mutex> lock(shared->mutex);
+        shared->finished.wait(lock, [&shared]() { return shared->done; });
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+    if (shared->error) {
+        std::rethrow_exception(shared->error);
+    }
+}
+
+size_t ThreadPool::currentWorkerIndex() const {
+    return t_pool == this ? t_workerIndex : SIZE_MAX;
+}
+
+size_t ThreadPool::defaultThreadCount() {
+    size_t count = 0;
+
+    // Honour the affinity mask the process was started with (start /affinity, job objects)
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+        count = countBits(processMask);
+    }
+    if (count == 0) {
+        count = std::thread::hardware_concurrency();
+    }
+
+    // A hard CPU rate cap on the job (Windows containers, CI runners) is the
+    // counterpart of a cgroup CPU quota: running more workers than it allows
+    // only adds contention
+    JOBOBJECT_CPU_RATE_CONTROL_INFORMATION rateControl = {};
+    if (QueryInformationJobObject(NULL, JobObjectCpuRateControlInformation,
+                                  &rateControl, sizeof(rateControl), NULL) &&
+        (rateControl.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_ENABLE) &&
+        (rateControl.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_HARD_CAP)) {
+        // CpuRate is in 1/100 percent of all processors in the system
+        size_t total = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+        size_t allowed = (total * rateControl.CpuRate + 9999) / 10000;
+        if (allowed > 0 && allowed < count) {
+            count = allowed;
+        }
+    }
+
+    return count > 0 ? count : 1;
+}
+
+bool ThreadPool::tryTake(size_t index, Task& task) {
+    // Own deque first, newest task (LIFO)
+    {
+        WorkQueue& own = *m_queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Steal the oldest task from another worker (FIFO)
+    for (size_t offset = 1; offset < m_queues.size(); offset++) {
+        WorkQueue& victim = *m_queues[(index + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    t_pool = this;
+    t_workerIndex = index;
+
+    while (true) {
+        {
+            // Claim one queued task; it is guaranteed to be in some deque
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [this]() { return m_stopping || m_queued > 0; });
+            if (m_queued == 0) {
+                return;
+            }
+            m_queued--;
+        }
+
+        Task task;
+        while (!tryTake(index, task)) {
+            // Another claimant is between its claim and its take; the task is in flight
+            std::this_thread::yield();
+        }
+
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_error) {
+                m_error = std::current_exception();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0) {
+            m_allDone.notify_all();
+        }
+    }
+}
+
+} // namespace core
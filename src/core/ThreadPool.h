@@ -0,0 +1,99 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+/**
+ * @brief Fixed-size work-stealing thread pool.
+ *
+ * Every worker owns a deque. Tasks submitted from a worker go to the back of
+ * its own deque and are taken LIFO, which keeps related work on the same
+ * core; tasks submitted from other threads are spread round-robin. A worker
+ * whose deque is empty steals from the front of the others, so one long task
+ * never leaves queued work stranded behind it.
+ *
+ * Usage:
+ *   ThreadPool pool;  // one worker per available CPU
+ *   for (auto& file : files) {
+ *       pool.submit([&file]() { hash(file); });
+ *   }
+ *   pool.wait();
+ *
+ * join() runs two tasks as a fork-join pair for recursive divide and
+ * conquer; it only waits for its own pair, so it may be called from a task.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /// @param threadCount Number of workers (0 = defaultThreadCount())
+    explicit ThreadPool(size_t threadCount = 0);
+
+    /// @brief Runs the remaining tasks, then joins the workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief Queue a task for execution
+    void submit(Task task);
+
+    /// @brief Block until every submitted task has finished
+    /// @throws The first exception thrown by a task since the last wait()
+    void wait();
+
+    /// @brief Run first on the calling thread and second on a worker, or also on the
+    ///        calling thread if no worker has started it by then
+    ///
+    /// Returns once both have finished. Unlike wait() this is safe to call from a
+    /// task, and nested calls make progress even when every worker is busy.
+    /// @throws The exception thrown by first, else the one thrown by second
+    void join(const Task& first, const Task& second);
+
+    /// @return Number of worker threads
+    size_t getThreadCount() const { return m_threads.size(); }
+
+    /// @return Index of the calling worker in [0, getThreadCount()), or SIZE_MAX
+    ///         when called from a thread that does not belong to this pool
+    size_t currentWorkerIndex() const;
+
+    /// @brief CPUs this process may actually use: the affinity mask, capped by
+    ///        any job object CPU rate limit (containers, CI runners)
+    static size_t defaultThreadCount();
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool tryTake(size_t index, Task& task);
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t> m_nextQueue;
+
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_allDone;
+    size_t m_queued;   // Tasks sitting in a deque and not yet claimed by a worker
+    size_t m_pending;  // Tasks submitted and not yet finished
+    bool m_stopping;
+    std::exception_ptr m_error;
+};
+
+} // namespace core
+
+#endif // THREAD_POOL_H
@@ -2,24 +2,75 @@
 #define CRYPTOPP_HASH_BASE_H
 
 #include "../../IHashAlgorithm.h"
+#include "../../HashState.h"
 #include <cryptopp/cryptlib.h>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace core {
 namespace impl {
 
+/// @brief Detects HashTransformation classes with SaveState(HashStateWriter&) and
+///        LoadState(HashStateReader&) members (the native implementations)
+template<typename HashImpl, typename = void>
+struct HasHashState : std::false_type {};
+
+template<typename HashImpl>
+struct HasHashState<HashImpl, decltype(
+    std::declval<const HashImpl&>().SaveState(std::declval<HashStateWriter&>()),
+    std::declval<HashImpl&>().LoadState(std::declval<HashStateReader&>()),
+    void())> : std::true_type {};
+
+/// @brief Detects HashTransformation classes with SetThreadPool(ThreadPool*) (BLAKE3, CRCs, MD6)
+template<typename HashImpl, typename = void>
+struct HasThreadPool : std::false_type {};
+
+template<typename HashImpl>
+struct HasThreadPool<HashImpl, decltype(
+    std::declval<HashImpl&>().SetThreadPool(std::declval<ThreadPool*>()),
+    void())> : std::true_type {};
+
+/// @brief Detects HashTransformation classes with a static SharedStateKey(): variants
+///        whose SaveState() payloads are interchangeable (see IHashAlgorithm::getSharedStateKey)
+template<typename HashImpl, typename = void>
+struct HasSharedState : std::false_type {};
+
+template<typename HashImpl>
+struct HasSharedState<HashImpl, decltype(HashImpl::SharedStateKey(), void())>
+    : HasHashState<HashImpl> {};
+
 /**
  * @brief Base class for Crypto++ based hash implementations.
- * 
+ *
  * Template wrapper that works with any CryptoPP::HashTransformation.
+ * saveState()/loadState() are available when HashImpl provides
+ * SaveState/LoadState; Crypto++'s own hashes keep their message length
+ * counters private and cannot be checkpointed. setThreadPool() is forwarded
+ * when HashImpl provides SetThreadPool, and copySharedState() goes through
+ * the saved state payload when HashImpl provides SharedStateKey(). An instance built from a configured
+ * HashImpl (e.g. MD6 with non-default parameters) is named after that
+ * instance's AlgorithmName(). clone() and peekDigest() copy HashImpl with its
+ * copy constructor; the native implementations hold their whole state in
+ * fixed arrays, so peekDigest() finalizes a copy on the stack without
+ * touching the heap.
  */
 template<typename HashImpl>
 class CryptoppHashBase : public IHashAlgorithm {
 public:
-    CryptoppHashBase() : m_hash(std::make_unique<HashImpl>()) {}
+    CryptoppHashBase()
+        : m_hash(std::make_unique<HashImpl>()),
+          m_name(HashImpl::StaticAlgorithmName()),
+          m_bytesProcessed(0) {}
+
+    explicit CryptoppHashBase(std::unique_ptr<HashImpl> hash)
+        : m_hash(std::move(hash)),
+          m_name(m_hash->AlgorithmName()),
+          m_bytesProcessed(0) {}
 
     std::string getName() const override {
-        return HashImpl::StaticAlgorithmName();
+        return m_name;
     }
 
     size_t getDigestSize() const override {
@@ -28,20 +79,121 @@ public:
 
     void update(const uint8_t* data, size_t length) override {
         m_hash->Update(data, length);
+        m_bytesProcessed += length;
     }
 
     std::vector<uint8_t> finalize() override {
         std::vector<uint8_t> digest(getDigestSize());
         m_hash->Final(digest.data());
+        m_bytesProcessed = 0;
         return digest;
     }
 
     void reset() override {
         m_hash->Restart();
+        m_bytesProcessed = 0;
+    }
+
+    std::unique_ptr<IHashAlgorithm> clone() const override {
+        return std::unique_ptr<IHashAlgorithm>(new CryptoppHashBase(*this));
+    }
+
+    std::vector<uint8_t> peekDigest() const override {
+        // Finalize a copy; the running state stays as it is
+        HashImpl hash(*m_hash);
+        std::vector<uint8_t> digest(getDigestSize());
+        hash.Final(digest.data());
+        return digest;
+    }
+
+    bool supportsState() const override {
+        return HasHashState<HashImpl>::value;
+    }
+
+    std::vector<uint8_t> saveState() const override {
+        if constexpr (HasHashState<HashImpl>::value) {
+            HashStateWriter writer(getName(), m_bytesProcessed);
+            m_hash->SaveState(writer);
+            return writer.take();
+        } else {
+            return IHashAlgorithm::saveState();
+        }
+    }
+
+    void loadState(const std::vector<uint8_t>& state) override {
+        if constexpr (HasHashState<HashImpl>::value) {
+            HashStateReader reader(state);
+            if (reader.getAlgorithm() != getName()) {
+                throw std::invalid_argument("Invalid hash state: saved by " + reader.getAlgorithm() +
+                                            ", not " + getName());
+            }
+            loadPayload(reader);
+        } else {
+            IHashAlgorithm::loadState(state);
+        }
+    }
+
+    std::string getSharedStateKey() const override {
+        if constexpr (HasSharedState<HashImpl>::value) {
+            return HashImpl::SharedStateKey();
+        } else {
+            return std::string();
+        }
+    }
+
+    void copySharedState(const IHashAlgorithm& other) override {
+        if constexpr (HasSharedState<HashImpl>::value) {
+            if (other.getSharedStateKey() != HashImpl::SharedStateKey()) {
+                throw std::invalid_argument("Cannot share the state of " + other.getName() +
+                                            " with " + getName());
+            }
+            // Same payload layout, only the name in the header differs
+            const std::vector<uint8_t> state = other.saveState();
+            HashStateReader reader(state);
+            loadPayload(reader);
+        } else {
+            IHashAlgorithm::copySharedState(other);
+        }
+    }
+
+    bool supportsThreadPool() const override {
+        return HasThreadPool<HashImpl>::value;
+    }
+
+    void setThreadPool(ThreadPool* pool) override {
+        if constexpr (HasThreadPool<HashImpl>::value) {
+            m_hash->SetThreadPool(pool);
+        }
     }
 
 private:
+    /// @brief Deep copy for clone()
+    CryptoppHashBase(const CryptoppHashBase& other)
+        : IHashAlgorithm(other),
+          m_hash(std::make_unique<HashImpl>(*other.m_hash)),
+          m_name(other.m_name),
+          m_bytesProcessed(other.m_bytesProcessed) {}
+
+    CryptoppHashBase& operator=(const CryptoppHashBase&) = delete;
+
+    /// @brief Load the payload following a checked header
+    void loadPayload(HashStateReader& reader) {
+        if constexpr (HasHashState<HashImpl>::value) {
+            try {
+                m_hash->LoadState(reader);
+                reader.finish();
+            } catch (...) {
+                // Never leave a half-loaded state behind
+                reset();
+                throw;
+            }
+            m_bytesProcessed = reader.getOffset();
+        }
+    }
+
     std::unique_ptr<HashImpl> m_hash;
+    std::string m_name;
+    uint64_t m_bytesProcessed;
 };
 
 } // namespace impl
@@ -10,8 +10,6 @@
 #include <cryptopp/md2.h>
 #include <cryptopp/md4.h>
 #include <cryptopp/ripemd.h>
-#include <cryptopp/crc.h>
-#include <cryptopp/adler32.h>
 
 namespace core {
 namespace impl {
@@ -31,30 +29,6 @@ using RIPEMD160Hash = CryptoppHashBase<CryptoPP::RIPEMD160>;
 using RIPEMD256Hash = CryptoppHashBase<CryptoPP::RIPEMD256>;
 using RIPEMD320Hash = CryptoppHashBase<CryptoPP::RIPEMD320>;
 
-// CRC32 with proper byte order handling
-class CRC32Hash : public IHashAlgorithm {
-public:
-    CRC32Hash();
-
-    std::string getName() const override {
-        return "CRC32";
-    }
-
-    size_t getDigestSize() const override {
-        return 4;
-    }
-
-    void update(const uint8_t* data, size_t length) override;
-    std::vector<uint8_t> finalize() override;
-    void reset() override;
-
-private:
-    std::unique_ptr<CryptoPP::CRC32> m_hash;
-};
-
-// Adler32
-using Adler32Hash = CryptoppHashBase<CryptoPP::Adler32>;
-
 } // namespace impl
 } // namespace core
 
@@ -0,0 +1,14 @@
+#include "Adler32.h"
+#include "../../HashAlgorithmFactory.h"
+
+namespace core {
+namespace impl {
+
+// ============================================================================
+// Algorithm Registration
+// ============================================================================
+
+static HashAlgorithmRegistrar<Adler32Hash> reg_adler32("Adler32");
+
+} // namespace impl
+} // namespace core
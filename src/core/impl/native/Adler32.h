@@ -0,0 +1,97 @@
+#ifndef ADLER32_H
+#define ADLER32_H
+
+#include "../cryptopp/CryptoppHashBase.h"
+#include "Adler32Kernels.h"
+#include <cryptopp/cryptlib.h>
+#include <stdexcept>
+#include <string>
+
+namespace core {
+namespace impl {
+
+/**
+ * @brief Adler-32 checksum (RFC 1950, zlib) as a HashTransformation.
+ *
+ * Replaces CryptoPP::Adler32 with the SIMD kernels of Adler32Kernels.h. The
+ * digest is s2 followed by s1, big-endian, as zlib and Crypto++ write it.
+ *
+ * Large Update() inputs can be split over a ThreadPool and merged with
+ * Combine().
+ *
+ * Usage:
+ *   Adler32 adler;
+ *   adler.Update(data, length);
+ *   adler.Final(digest);  // 4 bytes
+ */
+class Adler32 : public CryptoPP::HashTransformation {
+public:
+    CRYPTOPP_CONSTANT(DIGESTSIZE = 4);
+    CRYPTOPP_CONSTANT(BLOCKSIZE = 1);
+
+    Adler32() { Restart(); }
+
+    std::string AlgorithmName() const override {
+        return StaticAlgorithmName();
+    }
+
+    static std::string StaticAlgorithmName() {
+        return "Adler32";
+    }
+
+    unsigned int DigestSize() const override { return DIGESTSIZE; }
+    unsigned int BlockSize() const override { return BLOCKSIZE; }
+
+    void Update(const CryptoPP::byte *input, size_t length) override {
+        m_adler = adler::updateParallel(m_adler, input, length, m_pool);
+    }
+
+    void TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) override {
+        ThrowIfInvalidTruncatedSize(digestSize);
+
+        for (size_t i = 0; i < digestSize; ++i) {
+            digest[i] = static_cast<CryptoPP::byte>(m_adler >> (8 * (DIGESTSIZE - 1 - i)));
+        }
+
+        Restart();
+    }
+
+    void Restart() override {
+        m_adler = adler::INIT;
+    }
+
+    /// @brief Append the running state to a saved hash state (see IHashAlgorithm::saveState)
+    void SaveState(HashStateWriter& writer) const {
+        writer.putU32(m_adler);
+    }
+
+    /// @brief Restore a state written by SaveState()
+    /// @throws std::invalid_argument if the state is inconsistent
+    void LoadState(HashStateReader& reader) {
+        const uint32_t adler = reader.getU32();
+        if ((adler & 0xFFFF) >= adler::BASE || (adler >> 16) >= adler::BASE) {
+            throw std::invalid_argument("Invalid hash state: Adler32 sums out of range");
+        }
+        m_adler = adler;
+    }
+
+    /// @brief Hash large Update() inputs on the pool's workers as well
+    /// @param pool Pool to use (not owned), nullptr to hash on the calling thread only
+    void SetThreadPool(ThreadPool* pool) { m_pool = pool; }
+
+    /// @return Checksum of a message A followed by B, from the checksums of A and B and the length of B
+    static uint32_t Combine(uint32_t adlerA, uint32_t adlerB, uint64_t lengthB) {
+        return adler::combine(adlerA, adlerB, lengthB);
+    }
+
+private:
+    uint32_t m_adler;
+    ThreadPool* m_pool = nullptr;  // Workers for large inputs (not owned)
+};
+
+using Adler32Hash = CryptoppHashBase<Adler32>;
+
+} // namespace impl
+} // namespace core
+
+#endif // ADLER32_H
@@ -0,0 +1,74 @@
+#include "Adler32Kernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <immintrin.h>
+
+namespace core {
+namespace impl {
+namespace adler {
+
+namespace {
+
+#define AVX2 HASHCALC_TARGET("avx2")
+
+/// @brief Bytes per step
+constexpr size_t STEP = 64;
+
+AVX2 inline uint32_t sum32(__m256i v) {
+    __m128i x = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+    x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(x));
+}
+
+} // namespace
+
+AVX2 uint32_t adler32Avx2(uint32_t adler, const uint8_t* data, size_t length) {
+    uint32_t s1 = adler & 0xFFFF;
+    uint32_t s2 = adler >> 16;
+
+    // Weight of each byte of a step in s2: 64 for the first down to 1 for the last
+    const __m256i tapHigh = _mm256_setr_epi8(64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49,
+                                             48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33);
+    const __m256i tapLow = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+                                            16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+
+    size_t steps = length / STEP;
+    length -= steps * STEP;
+    while (steps > 0) {
+        const size_t n = steps < NMAX / STEP ? steps : NMAX / STEP;
+        steps -= n;
+
+        // vPrev sums s1 as it was before each step; s2 gains STEP times that
+        __m256i vPrev = _mm256_setr_epi32(static_cast<int>(s1 * n), 0, 0, 0, 0, 0, 0, 0);
+        __m256i vS1 = zero;
+        __m256i vS2 = _mm256_setr_epi32(static_cast<int>(s2), 0, 0, 0, 0, 0, 0, 0);
+        for (size_t i = 0; i < n; i++) {
+            const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+            const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32));
+            vPrev = _mm256_add_epi32(vPrev, vS1);
+            vS1 = _mm256_add_epi32(vS1, _mm256_sad_epu8(b0, zero));
+            vS1 = _mm256_add_epi32(vS1, _mm256_sad_epu8(b1, zero));
+            vS2 = _mm256_add_epi32(vS2, _mm256_madd_epi16(_mm256_maddubs_epi16(b0, tapHigh), ones));
+            vS2 = _mm256_add_epi32(vS2, _mm256_madd_epi16(_mm256_maddubs_epi16(b1, tapLow), ones));
+            data += STEP;
+        }
+        vS2 = _mm256_add_epi32(vS2, _mm256_slli_epi32(vPrev, 6));
+
+        s1 = (s1 + sum32(vS1)) % BASE;
+        s2 = sum32(vS2) % BASE;
+    }
+
+    return length > 0 ? adler32Portable((s2 << 16) | s1, data, length) : (s2 << 16) | s1;
+}
+
+#undef AVX2
+
+} // namespace adler
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
@@ -0,0 +1,94 @@
+#include "Adler32Kernels.h"
+#include "../../ThreadPool.h"
+
+namespace core {
+namespace impl {
+namespace adler {
+
+namespace {
+
+using Adler32Fn = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+/// @return Fastest Adler-32 kernel for this CPU
+Adler32Fn selectAdler32() {
+#if defined(HASHCALC_X86)
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (cpu.avx2) {
+        return adler32Avx2;
+    }
+    if (cpu.ssse3) {
+        return adler32Ssse3;
+    }
+#endif
+    return adler32Portable;
+}
+
+} // namespace
+
+uint32_t adler32(uint32_t adler, const uint8_t* data, size_t length) {
+    static const Adler32Fn kernel = selectAdler32();
+    return kernel(adler, data, length);
+}
+
+uint32_t adler32Portable(uint32_t adler, const uint8_t* data, size_t length) {
+    uint32_t s1 = adler & 0xFFFF;
+    uint32_t s2 = adler >> 16;
+
+    while (length > 0) {
+        size_t n = length < NMAX ? length : NMAX;
+        length -= n;
+        for (; n >= 8; n -= 8) {
+            s1 += data[0]; s2 += s1;
+            s1 += data[1]; s2 += s1;
+            s1 += data[2]; s2 += s1;
+            s1 += data[3]; s2 += s1;
+            s1 += data[4]; s2 += s1;
+            s1 += data[5]; s2 += s1;
+            s1 += data[6]; s2 += s1;
+            s1 += data[7]; s2 += s1;
+            data += 8;
+        }
+        for (; n > 0; n--) {
+            s1 += *data++;
+            s2 += s1;
+        }
+        s1 %= BASE;
+        s2 %= BASE;
+    }
+    return (s2 << 16) | s1;
+}
+
+uint32_t combine(uint32_t adlerA, uint32_t adlerB, uint64_t lengthB) {
+    // B's s1 started from 1 instead of A's s1, and every byte of B added that
+    // difference to s2 once more: s2 = s2A + s2B + lengthB * (s1A - 1)
+    const uint32_t rem = static_cast<uint32_t>(lengthB % BASE);
+    const uint32_t s1A = adlerA & 0xFFFF;
+    uint32_t s1 = s1A + (adlerB & 0xFFFF) + BASE - 1;
+    uint32_t s2 = static_cast<uint32_t>((static_cast<uint64_t>(rem) * s1A) % BASE);
+    s2 += (adlerA >> 16) + (adlerB >> 16) + BASE - rem;
+
+    if (s1 >= BASE) s1 -= BASE;
+    if (s1 >= BASE) s1 -= BASE;
+    if (s2 >= 2 * BASE) s2 -= 2 * BASE;
+    if (s2 >= BASE) s2 -= BASE;
+    return (s2 << 16) | s1;
+}
+
+uint32_t updateParallel(uint32_t adler, const uint8_t* data, size_t length, ThreadPool* pool) {
+    if (pool == nullptr || length < 2 * MIN_PARALLEL_LEN) {
+        return adler32(adler, data, length);
+    }
+
+    // The right half starts from INIT; keep the split on a cache line
+    const size_t leftLen = (length / 2) & ~static_cast<size_t>(63);
+    const size_t rightLen = length - leftLen;
+    uint32_t left = 0;
+    uint32_t right = 0;
+    pool->join([&]() { left = updateParallel(adler, data, leftLen, pool); },
+               [&]() { right = updateParallel(INIT, data + leftLen, rightLen, pool); });
+    return combine(left, right, rightLen);
+}
+
+} // namespace adler
+} // namespace impl
+} // namespace core
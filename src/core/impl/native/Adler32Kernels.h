@@ -0,0 +1,72 @@
+#ifndef ADLER32_KERNELS_H
+#define ADLER32_KERNELS_H
+
+#include "../../CpuFeatures.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+
+class ThreadPool;
+
+namespace impl {
+namespace adler {
+
+/**
+ * @brief Adler-32 kernels (RFC 1950).
+ *
+ * The checksum is two sums modulo 65521: s1 = 1 + every byte, and s2 = the
+ * sum of s1 after every byte, which weights each byte by its distance from
+ * the end. Both are kept in 32 bits and only reduced every NMAX bytes, the
+ * longest run that cannot overflow.
+ *
+ * The SIMD kernels take 32 (SSSE3) or 64 (AVX2) bytes per step: psadbw adds
+ * the bytes into s1, pmaddubsw/pmaddwd form the weighted dot product for s2,
+ * and the s1 carried into each step is multiplied by the step length once
+ * per NMAX run instead of once per step.
+ *
+ * combine() joins the checksums of two adjacent pieces from their lengths
+ * alone, which lets updateParallel() hash the halves of a large input on a
+ * ThreadPool.
+ */
+
+/// @brief Largest prime below 2^16, the modulus of both sums
+constexpr uint32_t BASE = 65521;
+
+/// @brief Largest n with 255 n (n + 1) / 2 + (n + 1) (BASE - 1) < 2^32
+constexpr size_t NMAX = 5552;
+
+/// @brief Checksum of the empty message
+constexpr uint32_t INIT = 1;
+
+/// @brief Inputs shorter than this are not split across threads by updateParallel()
+constexpr size_t MIN_PARALLEL_LEN = 1024 * 1024;
+
+/// @brief Update an Adler-32 checksum (s2 << 16 | s1)
+uint32_t adler32(uint32_t adler, const uint8_t* data, size_t length);
+
+/// @brief Checksum of a message A followed by a message B
+/// @param adlerA Checksum of A
+/// @param adlerB Checksum of B, started from INIT
+/// @param lengthB Length of B in bytes
+uint32_t combine(uint32_t adlerA, uint32_t adlerB, uint64_t lengthB);
+
+/// @brief adler32() over data, hashing the halves of inputs of MIN_PARALLEL_LEN
+///        bytes and more on pool's workers and merging them with combine()
+/// @param pool Workers to share the input with, nullptr to update on the calling thread
+uint32_t updateParallel(uint32_t adler, const uint8_t* data, size_t length, ThreadPool* pool);
+
+// Portable and instruction set specific kernels, chosen by adler32()
+
+uint32_t adler32Portable(uint32_t adler, const uint8_t* data, size_t length);
+
+#if defined(HASHCALC_X86)
+uint32_t adler32Ssse3(uint32_t adler, const uint8_t* data, size_t length);
+uint32_t adler32Avx2(uint32_t adler, const uint8_t* data, size_t length);
+#endif
+
+} // namespace adler
+} // namespace impl
+} // namespace core
+
+#endif // ADLER32_KERNELS_H
@@ -0,0 +1,71 @@
+#include "Adler32Kernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <tmmintrin.h>
+
+namespace core {
+namespace impl {
+namespace adler {
+
+namespace {
+
+#define SSSE3 HASHCALC_TARGET("ssse3")
+
+/// @brief Bytes per step
+constexpr size_t STEP = 32;
+
+SSSE3 inline uint32_t sum32(__m128i v) {
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+}
+
+} // namespace
+
+SSSE3 uint32_t adler32Ssse3(uint32_t adler, const uint8_t* data, size_t length) {
+    uint32_t s1 = adler & 0xFFFF;
+    uint32_t s2 = adler >> 16;
+
+    // Weight of each byte of a step in s2: 32 for the first down to 1 for the last
+    const __m128i tapHigh = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+    const __m128i tapLow = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+
+    size_t steps = length / STEP;
+    length -= steps * STEP;
+    while (steps > 0) {
+        const size_t n = steps < NMAX / STEP ? steps : NMAX / STEP;
+        steps -= n;
+
+        // vPrev sums s1 as it was before each step; s2 gains STEP times that
+        __m128i vPrev = _mm_cvtsi32_si128(static_cast<int>(s1 * n));
+        __m128i vS1 = zero;
+        __m128i vS2 = _mm_cvtsi32_si128(static_cast<int>(s2));
+        for (size_t i = 0; i < n; i++) {
+            const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+            vPrev = _mm_add_epi32(vPrev, vS1);
+            vS1 = _mm_add_epi32(vS1, _mm_sad_epu8(b0, zero));
+            vS1 = _mm_add_epi32(vS1, _mm_sad_epu8(b1, zero));
+            vS2 = _mm_add_epi32(vS2, _mm_madd_epi16(_mm_maddubs_epi16(b0, tapHigh), ones));
+            vS2 = _mm_add_epi32(vS2, _mm_madd_epi16(_mm_maddubs_epi16(b1, tapLow), ones));
+            data += STEP;
+        }
+        vS2 = _mm_add_epi32(vS2, _mm_slli_epi32(vPrev, 5));
+
+        s1 = (s1 + sum32(vS1)) % BASE;
+        s2 = sum32(vS2) % BASE;
+    }
+
+    return length > 0 ? adler32Portable((s2 << 16) | s1, data, length) : (s2 << 16) | s1;
+}
+
+#undef SSSE3
+
+} // namespace adler
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
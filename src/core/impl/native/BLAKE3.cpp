@@ -2,29 +2,11 @@
 #include "../../HashAlgorithmFactory.h"
 #include <algorithm>
 #include <cstring>
+#include <stdexcept>
 
 namespace core {
 namespace impl {
 
-// BLAKE3 IV (same as BLAKE2)
-template<unsigned int DIGEST_BITS>
-const uint32_t BLAKE3<DIGEST_BITS>::IV[8] = {
-    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
-    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
-};
-
-// Message schedule permutation for 7 rounds
-template<unsigned int DIGEST_BITS>
-const uint8_t BLAKE3<DIGEST_BITS>::MSG_SCHEDULE[7][16] = {
-    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
-    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
-    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
-    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
-    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
-    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
-    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
-};
-
 // ============================================================================
 // Utility Functions
 // ============================================================================
@@ -79,103 +61,17 @@ unsigned int BLAKE3<DIGEST_BITS>::popcnt(uint64_t x) {
 // Core Compression Functions
 // ============================================================================
 
-template<unsigned int DIGEST_BITS>
-void BLAKE3<DIGEST_BITS>::g(uint32_t state[16], size_t a, size_t b, size_t c, size_t d,
-                            uint32_t mx, uint32_t my) {
-    state[a] = state[a] + state[b] + mx;
-    state[d] = rotr32(state[d] ^ state[a], 16);
-    state[c] = state[c] + state[d];
-    state[b] = rotr32(state[b] ^ state[c], 12);
-    state[a] = state[a] + state[b] + my;
-    state[d] = rotr32(state[d] ^ state[a], 8);
-    state[c] = state[c] + state[d];
-    state[b] = rotr32(state[b] ^ state[c], 7);
-}
-
-template<unsigned int DIGEST_BITS>
-void BLAKE3<DIGEST_BITS>::roundFunction(uint32_t state[16], const uint32_t m[16], size_t round) {
-    // Select message schedule for this round
-    const uint8_t* schedule = MSG_SCHEDULE[round % 7];
-    
-    // Column step
-    g(state, 0, 4, 8,  12, m[schedule[0]], m[schedule[1]]);
-    g(state, 1, 5, 9,  13, m[schedule[2]], m[schedule[3]]);
-    g(state, 2, 6, 10, 14, m[schedule[4]], m[schedule[5]]);
-    g(state, 3, 7, 11, 15, m[schedule[6]], m[schedule[7]]);
-    
-    // Diagonal step
-    g(state, 0, 5, 10, 15, m[schedule[8]],  m[schedule[9]]);
-    g(state, 1, 6, 11, 12, m[schedule[10]], m[schedule[11]]);
-    g(state, 2, 7, 8,  13, m[schedule[12]], m[schedule[13]]);
-    g(state, 3, 4, 9,  14, m[schedule[14]], m[schedule[15]]);
-}
-
 template<unsigned int DIGEST_BITS>
 void BLAKE3<DIGEST_BITS>::compress(uint32_t cv[8], const uint8_t block[BLOCK_LEN],
                                    uint8_t block_len, uint64_t counter, uint8_t flags) {
-    // Load message words
-    uint32_t m[16];
-    for (size_t i = 0; i < 16; i++) {
-        m[i] = load32(&block[i * 4]);
-    }
-
-    // Initialize state
-    uint32_t state[16] = {
-        cv[0], cv[1], cv[2], cv[3],
-        cv[4], cv[5], cv[6], cv[7],
-        IV[0], IV[1], IV[2], IV[3],
-        static_cast<uint32_t>(counter),
-        static_cast<uint32_t>(counter >> 32),
-        static_cast<uint32_t>(block_len),
-        static_cast<uint32_t>(flags)
-    };
-
-    // 7 rounds
-    for (size_t round = 0; round < 7; round++) {
-        roundFunction(state, m, round);
-    }
-
-    // Finalize: XOR the two halves of the state
-    for (size_t i = 0; i < 8; i++) {
-        cv[i] = state[i] ^ state[i + 8];
-    }
+    blake3::compressInPlace(cv, block, block_len, counter, flags);
 }
 
 template<unsigned int DIGEST_BITS>
 void BLAKE3<DIGEST_BITS>::compressXof(const uint32_t cv[8], const uint8_t block[BLOCK_LEN],
                                       uint8_t block_len, uint64_t counter, uint8_t flags,
                                       uint8_t out[64]) {
-    // Load message words
-    uint32_t m[16];
-    for (size_t i = 0; i < 16; i++) {
-        m[i] = load32(&block[i * 4]);
-    }
-
-    // Initialize state
-    uint32_t state[16] = {
-        cv[0], cv[1], cv[2], cv[3],
-        cv[4], cv[5], cv[6], cv[7],
-        IV[0], IV[1], IV[2], IV[3],
-        static_cast<uint32_t>(counter),
-        static_cast<uint32_t>(counter >> 32),
-        static_cast<uint32_t>(block_len),
-        static_cast<uint32_t>(flags)
-    };
-
-    // 7 rounds
-    for (size_t round = 0; round < 7; round++) {
-        roundFunction(state, m, round);
-    }
-
-    // Output full 64 bytes (16 words) - XOF mode
-    // First 8 words: state[i] ^ state[i+8]
-    for (size_t i = 0; i < 8; i++) {
-        store32(&out[i * 4], state[i] ^ state[i + 8]);
-    }
-    // Last 8 words: state[i+8] ^ cv[i]
-    for (size_t i = 0; i < 8; i++) {
-        store32(&out[(i + 8) * 4], state[i + 8] ^ cv[i]);
-    }
+    blake3::compressXof(cv, block, block_len, counter, flags, out);
 }
 
 // ============================================================================
@@ -353,11 +249,46 @@ void BLAKE3<DIGEST_BITS>::hasherPushCv(const uint8_t new_cv[OUT_LEN], uint64_t c
 
 template<unsigned int DIGEST_BITS>
 void BLAKE3<DIGEST_BITS>::Restart() {
-    std::memcpy(m_key, IV, 32);
+    std::memcpy(m_key, blake3::IV, 32);
     m_chunk.init(m_key, 0);
     m_cv_stack_len = 0;
 }
 
+template<unsigned int DIGEST_BITS>
+void BLAKE3<DIGEST_BITS>::SaveState(HashStateWriter& writer) const {
+    writer.putWords(m_key, 8);
+    writer.putWords(m_chunk.cv, 8);
+    writer.putU64(m_chunk.chunk_counter);
+    writer.putU8(m_chunk.blocks_compressed);
+    writer.putU8(m_chunk.flags);
+    writer.putU8(m_chunk.buf_len);
+    writer.putBytes(m_chunk.buf, m_chunk.buf_len);
+    writer.putU8(m_cv_stack_len);
+    writer.putBytes(m_cv_stack, static_cast<size_t>(m_cv_stack_len) * OUT_LEN);
+}
+
+template<unsigned int DIGEST_BITS>
+void BLAKE3<DIGEST_BITS>::LoadState(HashStateReader& reader) {
+    reader.getWords(m_key, 8);
+    reader.getWords(m_chunk.cv, 8);
+    m_chunk.chunk_counter = reader.getU64();
+    m_chunk.blocks_compressed = reader.getU8();
+    m_chunk.flags = reader.getU8();
+    m_chunk.buf_len = reader.getU8();
+    if (m_chunk.buf_len > BLOCK_LEN || m_chunk.len() > CHUNK_LEN) {
+        throw std::invalid_argument("Invalid hash state: corrupt BLAKE3 chunk");
+    }
+    // Bytes past buf_len must be zero: a partial block is compressed as is
+    std::memset(m_chunk.buf, 0, BLOCK_LEN);
+    reader.getBytes(m_chunk.buf, m_chunk.buf_len);
+
+    m_cv_stack_len = reader.getU8();
+    if (m_cv_stack_len > MAX_DEPTH) {
+        throw std::invalid_argument("Invalid hash state: corrupt BLAKE3 chaining value stack");
+    }
+    reader.getBytes(m_cv_stack, static_cast<size_t>(m_cv_stack_len) * OUT_LEN);
+}
+
 template<unsigned int DIGEST_BITS>
 void BLAKE3<DIGEST_BITS>::Update(const CryptoPP::byte* input, size_t length) {
     if (length == 0) {
@@ -388,18 +319,38 @@ void BLAKE3<DIGEST_BITS>::Update(const CryptoPP::byte* input, size_t length) {
         }
     }
     
-    // Process complete chunks
+    // Hash whole chunks as the largest subtrees that keep the tree aligned: a
+    // subtree of 2^k chunks must start at a multiple of 2^k chunks. Leave at
+    // least one byte for m_chunk since the last chunk may need the ROOT flag.
     while (length > CHUNK_LEN) {
-        // For simplicity, process one chunk at a time
-        // A more optimized version would use SIMD and process multiple chunks
-        m_chunk.update(input_bytes, CHUNK_LEN);
-        Output output = chunkOutput(m_chunk);
-        uint8_t chunk_cv[32];
-        output.chainingValue(chunk_cv);
-        hasherPushCv(chunk_cv, m_chunk.chunk_counter);
-        m_chunk.reset(m_key, m_chunk.chunk_counter + 1);
-        input_bytes += CHUNK_LEN;
-        length -= CHUNK_LEN;
+        size_t subtree_len = static_cast<size_t>(blake3::roundDownToPowerOf2(length));
+        uint64_t count_so_far = m_chunk.chunk_counter * CHUNK_LEN;
+        while ((static_cast<uint64_t>(subtree_len - 1) & count_so_far) != 0) {
+            subtree_len /= 2;
+        }
+        uint64_t subtree_chunks = subtree_len / CHUNK_LEN;
+
+        if (subtree_len <= CHUNK_LEN) {
+            ChunkState chunk_state;
+            chunk_state.init(m_key, m_chunk.flags);
+            chunk_state.chunk_counter = m_chunk.chunk_counter;
+            chunk_state.update(input_bytes, subtree_len);
+            Output output = chunkOutput(chunk_state);
+            uint8_t chunk_cv[OUT_LEN];
+            output.chainingValue(chunk_cv);
+            hasherPushCv(chunk_cv, chunk_state.chunk_counter);
+        } else {
+            // The subtree's top parent is pushed as its two children, so that
+            // merging happens in the stack like for single chunks
+            uint8_t cv_pair[2 * OUT_LEN];
+            blake3::compressSubtreeToParentNode(input_bytes, subtree_len, m_key,
+                                                m_chunk.chunk_counter, m_chunk.flags, cv_pair, m_pool);
+            hasherPushCv(cv_pair, m_chunk.chunk_counter);
+            hasherPushCv(&cv_pair[OUT_LEN], m_chunk.chunk_counter + (subtree_chunks / 2));
+        }
+        m_chunk.chunk_counter += subtree_chunks;
+        input_bytes += subtree_len;
+        length -= subtree_len;
     }
     
     // Add remaining bytes to chunk state
@@ -419,6 +370,7 @@ void BLAKE3<DIGEST_BITS>::TruncatedFinal(CryptoPP::byte* digest, size_t digestSi
     if (m_cv_stack_len == 0) {
         Output output = chunkOutput(m_chunk);
         output.rootBytes(0, digest, digestSize);
+        Restart();
         return;
     }
     
@@ -431,12 +383,9 @@ void BLAKE3<DIGEST_BITS>::TruncatedFinal(CryptoPP::byte* digest, size_t digestSi
         output = chunkOutput(m_chunk);
     } else {
         // There are always at least 2 CVs in the stack in this case
-        cvs_remaining = m_cv_stack_len - 1;
+        cvs_remaining = m_cv_stack_len - 2;
         // Build parent block from last two CVs on stack
-        uint8_t parent_block[BLOCK_LEN];
-        std::memcpy(parent_block, &m_cv_stack[(cvs_remaining - 1) * 32], 32);
-        std::memcpy(parent_block + 32, &m_cv_stack[cvs_remaining * 32], 32);
-        output = parentOutput(parent_block, m_key, m_chunk.flags);
+        output = parentOutput(&m_cv_stack[cvs_remaining * 32], m_key, m_chunk.flags);
     }
 
     while (cvs_remaining > 0) {
@@ -448,6 +397,7 @@ void BLAKE3<DIGEST_BITS>::TruncatedFinal(CryptoPP::byte* digest, size_t digestSi
     }
     
     output.rootBytes(0, digest, digestSize);
+    Restart();
 }
 
 // ============================================================================
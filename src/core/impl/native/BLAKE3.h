@@ -2,6 +2,7 @@
 #define BLAKE3_H_CRYPTOPP
 
 #include "../cryptopp/CryptoppHashBase.h"
+#include "BLAKE3Kernels.h"
 #include <cryptopp/cryptlib.h>
 #include <cryptopp/secblock.h>
 #include <cryptopp/misc.h>
@@ -20,6 +21,8 @@ namespace impl {
  * yet is at least as secure as the latest standard SHA-3.
  * 
  * This is a pure C++ implementation independent of the reference C code.
+ * Runs of whole chunks are hashed as aligned subtrees with the SIMD kernels
+ * of BLAKE3Kernels.h (SSE4.1/AVX2/AVX-512, chosen at run time).
  * 
  * Features:
  * - Extremely fast (faster than SHA-1, SHA-2, SHA-3)
@@ -72,6 +75,10 @@ public:
         return "BLAKE3-" + std::to_string(DIGEST_BITS);
     }
 
+    /// @return Key shared by every output length: they hash the same tree and
+    ///         differ only in how many root output bytes are extracted
+    static std::string SharedStateKey() { return "BLAKE3"; }
+
     unsigned int DigestSize() const override { return DIGESTSIZE; }
     unsigned int BlockSize() const override { return BLOCKSIZE; }
 
@@ -79,13 +86,18 @@ public:
     void TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) override;
     void Restart() override;
 
+    /// @brief Hash large Update() inputs on the pool's workers as well
+    /// @param pool Pool to use (not owned), nullptr to hash on the calling thread only
+    void SetThreadPool(ThreadPool* pool) { m_pool = pool; }
+
+    /// @brief Append the running state to a saved hash state (see IHashAlgorithm::saveState)
+    void SaveState(HashStateWriter& writer) const;
+
+    /// @brief Restore a state written by SaveState()
+    /// @throws std::invalid_argument if the state is inconsistent
+    void LoadState(HashStateReader& reader);
+
 private:
-    // BLAKE3 IV (same as BLAKE2 IV)
-    static const uint32_t IV[8];
-    
-    // Message schedule (permutation)
-    static const uint8_t MSG_SCHEDULE[7][16];
-    
     // Internal state structures
     struct ChunkState {
         uint32_t cv[8];              // Chaining value
@@ -119,6 +131,7 @@ private:
     ChunkState m_chunk;                               // Current chunk state
     uint8_t m_cv_stack[(MAX_DEPTH + 1) * OUT_LEN];   // Chaining value stack
     uint8_t m_cv_stack_len;                          // Stack length
+    ThreadPool* m_pool = nullptr;                    // Workers for large subtrees (not owned)
     
     // Core compression functions
     static void compress(uint32_t cv[8], const uint8_t block[BLOCK_LEN],
@@ -127,12 +140,6 @@ private:
                            uint8_t block_len, uint64_t counter, uint8_t flags,
                            uint8_t out[64]);
     
-    // Helper functions
-    static void g(uint32_t state[16], size_t a, size_t b, size_t c, size_t d,
-                 uint32_t mx, uint32_t my);
-    static void roundFunction(uint32_t state[16], const uint32_t m[16], size_t round);
-    static void permute(uint32_t m[16]);
-    
     static Output makeOutput(const uint32_t input_cv[8], const uint8_t block[BLOCK_LEN],
                             uint8_t block_len, uint64_t counter, uint8_t flags);
     static Output chunkOutput(const ChunkState& cs);
@@ -148,9 +155,6 @@ private:
     static void loadKeyWords(const uint8_t key[KEY_LEN], uint32_t key_words[8]);
     static void store32(void* dst, uint32_t w);
     static void storeCvWords(uint8_t bytes_out[32], const uint32_t cv_words[8]);
-    static inline uint32_t rotr32(uint32_t x, int n) {
-        return (x >> n) | (x << (32 - n));
-    }
     static unsigned int popcnt(uint64_t x);
 };
 
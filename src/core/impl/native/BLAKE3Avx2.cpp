@@ -0,0 +1,175 @@
+#include "BLAKE3Kernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <immintrin.h>
+
+namespace core {
+namespace impl {
+namespace blake3 {
+
+namespace {
+
+#define AVX2 HASHCALC_TARGET("avx2")
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+AVX2 inline __m256i loadu(const void* src) {
+    return _mm256_loadu_si256(static_cast<const __m256i*>(src));
+}
+
+AVX2 inline void storeu(void* dest, __m256i src) {
+    _mm256_storeu_si256(static_cast<__m256i*>(dest), src);
+}
+
+AVX2 inline __m256i addv(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+AVX2 inline __m256i xorv(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+AVX2 inline __m256i set1(uint32_t x) { return _mm256_set1_epi32(static_cast<int32_t>(x)); }
+
+AVX2 inline __m256i rot16(__m256i x) {
+    return _mm256_shuffle_epi8(x, _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                                                  13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2));
+}
+
+AVX2 inline __m256i rot12(__m256i x) {
+    return xorv(_mm256_srli_epi32(x, 12), _mm256_slli_epi32(x, 32 - 12));
+}
+
+AVX2 inline __m256i rot8(__m256i x) {
+    return _mm256_shuffle_epi8(x, _mm256_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1,
+                                                  12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1));
+}
+
+AVX2 inline __m256i rot7(__m256i x) {
+    return xorv(_mm256_srli_epi32(x, 7), _mm256_slli_epi32(x, 32 - 7));
+}
+
+// ============================================================================
+// Eight Inputs: one state word of all eight inputs per vector
+// ============================================================================
+
+AVX2 inline void g(__m256i v[16], size_t a, size_t b, size_t c, size_t d, __m256i mx, __m256i my) {
+    v[a] = addv(addv(v[a], v[b]), mx);
+    v[d] = rot16(xorv(v[d], v[a]));
+    v[c] = addv(v[c], v[d]);
+    v[b] = rot12(xorv(v[b], v[c]));
+    v[a] = addv(addv(v[a], v[b]), my);
+    v[d] = rot8(xorv(v[d], v[a]));
+    v[c] = addv(v[c], v[d]);
+    v[b] = rot7(xorv(v[b], v[c]));
+}
+
+AVX2 inline void roundFn(__m256i v[16], const __m256i m[16], size_t round) {
+    const uint8_t* s = MSG_SCHEDULE[round];
+
+    // Column step
+    g(v, 0, 4, 8,  12, m[s[0]], m[s[1]]);
+    g(v, 1, 5, 9,  13, m[s[2]], m[s[3]]);
+    g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+    g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+
+    // Diagonal step
+    g(v, 0, 5, 10, 15, m[s[8]],  m[s[9]]);
+    g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+    g(v, 2, 7, 8,  13, m[s[12]], m[s[13]]);
+    g(v, 3, 4, 9,  14, m[s[14]], m[s[15]]);
+}
+
+/// @brief Transpose an 8x8 matrix of 32-bit words held as eight row vectors
+AVX2 inline void transpose8(__m256i v[8]) {
+    const __m256i ab0145 = _mm256_unpacklo_epi32(v[0], v[1]);
+    const __m256i ab2367 = _mm256_unpackhi_epi32(v[0], v[1]);
+    const __m256i cd0145 = _mm256_unpacklo_epi32(v[2], v[3]);
+    const __m256i cd2367 = _mm256_unpackhi_epi32(v[2], v[3]);
+    const __m256i ef0145 = _mm256_unpacklo_epi32(v[4], v[5]);
+    const __m256i ef2367 = _mm256_unpackhi_epi32(v[4], v[5]);
+    const __m256i gh0145 = _mm256_unpacklo_epi32(v[6], v[7]);
+    const __m256i gh2367 = _mm256_unpackhi_epi32(v[6], v[7]);
+
+    const __m256i abcd04 = _mm256_unpacklo_epi64(ab0145, cd0145);
+    const __m256i abcd15 = _mm256_unpackhi_epi64(ab0145, cd0145);
+    const __m256i abcd26 = _mm256_unpacklo_epi64(ab2367, cd2367);
+    const __m256i abcd37 = _mm256_unpackhi_epi64(ab2367, cd2367);
+    const __m256i efgh04 = _mm256_unpacklo_epi64(ef0145, gh0145);
+    const __m256i efgh15 = _mm256_unpackhi_epi64(ef0145, gh0145);
+    const __m256i efgh26 = _mm256_unpacklo_epi64(ef2367, gh2367);
+    const __m256i efgh37 = _mm256_unpackhi_epi64(ef2367, gh2367);
+
+    v[0] = _mm256_permute2x128_si256(abcd04, efgh04, 0x20);
+    v[1] = _mm256_permute2x128_si256(abcd15, efgh15, 0x20);
+    v[2] = _mm256_permute2x128_si256(abcd26, efgh26, 0x20);
+    v[3] = _mm256_permute2x128_si256(abcd37, efgh37, 0x20);
+    v[4] = _mm256_permute2x128_si256(abcd04, efgh04, 0x31);
+    v[5] = _mm256_permute2x128_si256(abcd15, efgh15, 0x31);
+    v[6] = _mm256_permute2x128_si256(abcd26, efgh26, 0x31);
+    v[7] = _mm256_permute2x128_si256(abcd37, efgh37, 0x31);
+}
+
+/// @brief Load one block of each input with message word i of every input in m[i]
+AVX2 inline void loadMessages(const uint8_t* const* inputs, size_t offset, __m256i m[16]) {
+    for (size_t half = 0; half < 2; half++) {
+        for (size_t lane = 0; lane < 8; lane++) {
+            m[half * 8 + lane] = loadu(inputs[lane] + offset + half * 32);
+        }
+        transpose8(&m[half * 8]);
+    }
+}
+
+} // namespace
+
+AVX2 void hash8Avx2(const uint8_t* const* inputs, size_t blocks, const uint32_t key[8], uint64_t counter,
+                    bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out) {
+    __m256i h[8];
+    for (size_t i = 0; i < 8; i++) {
+        h[i] = set1(key[i]);
+    }
+
+    uint32_t counterLow[8];
+    uint32_t counterHigh[8];
+    for (size_t lane = 0; lane < 8; lane++) {
+        const uint64_t laneCounter = counter + (incrementCounter ? lane : 0);
+        counterLow[lane] = static_cast<uint32_t>(laneCounter);
+        counterHigh[lane] = static_cast<uint32_t>(laneCounter >> 32);
+    }
+    const __m256i low = loadu(counterLow);
+    const __m256i high = loadu(counterHigh);
+
+    uint8_t blockFlags = flags | flagsStart;
+    for (size_t block = 0; block < blocks; block++) {
+        if (block + 1 == blocks) {
+            blockFlags |= flagsEnd;
+        }
+
+        __m256i m[16];
+        loadMessages(inputs, block * BLOCK_LEN, m);
+
+        __m256i v[16] = {
+            h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+            set1(IV[0]), set1(IV[1]), set1(IV[2]), set1(IV[3]),
+            low, high, set1(static_cast<uint32_t>(BLOCK_LEN)), set1(blockFlags),
+        };
+        for (size_t round = 0; round < 7; round++) {
+            roundFn(v, m, round);
+        }
+        for (size_t i = 0; i < 8; i++) {
+            h[i] = xorv(v[i], v[i + 8]);
+        }
+        blockFlags = flags;
+    }
+
+    // Back from one word per vector to one chaining value per input
+    transpose8(h);
+    for (size_t lane = 0; lane < 8; lane++) {
+        storeu(&out[lane * OUT_LEN], h[lane]);
+    }
+}
+
+#undef AVX2
+
+} // namespace blake3
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
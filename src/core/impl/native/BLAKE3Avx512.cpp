@@ -0,0 +1,163 @@
+#include "BLAKE3Kernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <immintrin.h>
+
+namespace core {
+namespace impl {
+namespace blake3 {
+
+namespace {
+
+#define AVX512 HASHCALC_TARGET("avx512f,avx512vl")
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+AVX512 inline __m512i loadu(const void* src) {
+    return _mm512_loadu_si512(src);
+}
+
+AVX512 inline __m512i addv(__m512i a, __m512i b) { return _mm512_add_epi32(a, b); }
+AVX512 inline __m512i xorv(__m512i a, __m512i b) { return _mm512_xor_si512(a, b); }
+AVX512 inline __m512i set1(uint32_t x) { return _mm512_set1_epi32(static_cast<int32_t>(x)); }
+
+// ============================================================================
+// Sixteen Inputs: one state word of all sixteen inputs per vector
+// ============================================================================
+
+AVX512 inline void g(__m512i v[16], size_t a, size_t b, size_t c, size_t d, __m512i mx, __m512i my) {
+    v[a] = addv(addv(v[a], v[b]), mx);
+    v[d] = _mm512_ror_epi32(xorv(v[d], v[a]), 16);
+    v[c] = addv(v[c], v[d]);
+    v[b] = _mm512_ror_epi32(xorv(v[b], v[c]), 12);
+    v[a] = addv(addv(v[a], v[b]), my);
+    v[d] = _mm512_ror_epi32(xorv(v[d], v[a]), 8);
+    v[c] = addv(v[c], v[d]);
+    v[b] = _mm512_ror_epi32(xorv(v[b], v[c]), 7);
+}
+
+AVX512 inline void roundFn(__m512i v[16], const __m512i m[16], size_t round) {
+    const uint8_t* s = MSG_SCHEDULE[round];
+
+    // Column step
+    g(v, 0, 4, 8,  12, m[s[0]], m[s[1]]);
+    g(v, 1, 5, 9,  13, m[s[2]], m[s[3]]);
+    g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+    g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+
+    // Diagonal step
+    g(v, 0, 5, 10, 15, m[s[8]],  m[s[9]]);
+    g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+    g(v, 2, 7, 8,  13, m[s[12]], m[s[13]]);
+    g(v, 3, 4, 9,  14, m[s[14]], m[s[15]]);
+}
+
+// Gather 128-bit lanes 0 and 2 (lo) or 1 and 3 (hi) of a, then of b
+AVX512 inline __m512i unpackLo128(__m512i a, __m512i b) {
+    return _mm512_shuffle_i32x4(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+AVX512 inline __m512i unpackHi128(__m512i a, __m512i b) {
+    return _mm512_shuffle_i32x4(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+/// @brief Transpose a 16x16 matrix of 32-bit words held as sixteen row vectors
+AVX512 void transpose16(__m512i v[16]) {
+    // Interleave 32-bit words of row pairs
+    __m512i pairs[16];
+    for (size_t i = 0; i < 16; i += 2) {
+        pairs[i] = _mm512_unpacklo_epi32(v[i], v[i + 1]);
+        pairs[i + 1] = _mm512_unpackhi_epi32(v[i], v[i + 1]);
+    }
+
+    // Interleave 64-bit words: quads[4q + k] holds word k of each 128-bit lane of rows 4q..4q+3
+    __m512i quads[16];
+    for (size_t q = 0; q < 4; q++) {
+        const __m512i* p = &pairs[q * 4];
+        quads[q * 4 + 0] = _mm512_unpacklo_epi64(p[0], p[2]);
+        quads[q * 4 + 1] = _mm512_unpackhi_epi64(p[0], p[2]);
+        quads[q * 4 + 2] = _mm512_unpacklo_epi64(p[1], p[3]);
+        quads[q * 4 + 3] = _mm512_unpackhi_epi64(p[1], p[3]);
+    }
+
+    // Interleave 128-bit lanes of rows 0-7 and of rows 8-15, then of both halves
+    __m512i octs[16];
+    for (size_t half = 0; half < 2; half++) {
+        const __m512i* q = &quads[half * 8];
+        for (size_t k = 0; k < 4; k++) {
+            octs[half * 8 + k] = unpackLo128(q[k], q[k + 4]);
+            octs[half * 8 + k + 4] = unpackHi128(q[k], q[k + 4]);
+        }
+    }
+    for (size_t k = 0; k < 8; k++) {
+        v[k] = unpackLo128(octs[k], octs[k + 8]);
+        v[k + 8] = unpackHi128(octs[k], octs[k + 8]);
+    }
+}
+
+} // namespace
+
+AVX512 void hash16Avx512(const uint8_t* const* inputs, size_t blocks, const uint32_t key[8], uint64_t counter,
+                         bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out) {
+    __m512i h[16];
+    for (size_t i = 0; i < 8; i++) {
+        h[i] = set1(key[i]);
+    }
+
+    uint32_t counterLow[16];
+    uint32_t counterHigh[16];
+    for (size_t lane = 0; lane < 16; lane++) {
+        const uint64_t laneCounter = counter + (incrementCounter ? lane : 0);
+        counterLow[lane] = static_cast<uint32_t>(laneCounter);
+        counterHigh[lane] = static_cast<uint32_t>(laneCounter >> 32);
+    }
+    const __m512i low = loadu(counterLow);
+    const __m512i high = loadu(counterHigh);
+
+    uint8_t blockFlags = flags | flagsStart;
+    for (size_t block = 0; block < blocks; block++) {
+        if (block + 1 == blocks) {
+            blockFlags |= flagsEnd;
+        }
+
+        // A vector holds a whole block, so one transpose yields all sixteen message words
+        __m512i m[16];
+        for (size_t lane = 0; lane < 16; lane++) {
+            m[lane] = loadu(inputs[lane] + block * BLOCK_LEN);
+        }
+        transpose16(m);
+
+        __m512i v[16] = {
+            h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+            set1(IV[0]), set1(IV[1]), set1(IV[2]), set1(IV[3]),
+            low, high, set1(static_cast<uint32_t>(BLOCK_LEN)), set1(blockFlags),
+        };
+        for (size_t round = 0; round < 7; round++) {
+            roundFn(v, m, round);
+        }
+        for (size_t i = 0; i < 8; i++) {
+            h[i] = xorv(v[i], v[i + 8]);
+        }
+        blockFlags = flags;
+    }
+
+    // Back to one chaining value per input; rows 8-15 only pad the matrix
+    for (size_t i = 8; i < 16; i++) {
+        h[i] = _mm512_setzero_si512();
+    }
+    transpose16(h);
+    for (size_t lane = 0; lane < 16; lane++) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[lane * OUT_LEN]), _mm512_castsi512_si256(h[lane]));
+    }
+}
+
+#undef AVX512
+
+} // namespace blake3
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
@@ -0,0 +1,386 @@
+#include "BLAKE3Kernels.h"
+#include "../../ThreadPool.h"
+#include <cstring>
+
+namespace core {
+namespace impl {
+namespace blake3 {
+
+// BLAKE3 IV (same as BLAKE2)
+const uint32_t IV[8] = {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+};
+
+// Message schedule permutation for 7 rounds
+const uint8_t MSG_SCHEDULE[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+};
+
+namespace {
+
+// ============================================================================
+// Portable Compression
+// ============================================================================
+
+inline uint32_t rotr32(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t load32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 0)  |
+           (static_cast<uint32_t>(p[1]) << 8)  |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline void store32(uint8_t* p, uint32_t w) {
+    p[0] = static_cast<uint8_t>(w >> 0);
+    p[1] = static_cast<uint8_t>(w >> 8);
+    p[2] = static_cast<uint8_t>(w >> 16);
+    p[3] = static_cast<uint8_t>(w >> 24);
+}
+
+inline void g(uint32_t state[16], size_t a, size_t b, size_t c, size_t d, uint32_t mx, uint32_t my) {
+    state[a] = state[a] + state[b] + mx;
+    state[d] = rotr32(state[d] ^ state[a], 16);
+    state[c] = state[c] + state[d];
+    state[b] = rotr32(state[b] ^ state[c], 12);
+    state[a] = state[a] + state[b] + my;
+    state[d] = rotr32(state[d] ^ state[a], 8);
+    state[c] = state[c] + state[d];
+    state[b] = rotr32(state[b] ^ state[c], 7);
+}
+
+inline void roundFunction(uint32_t state[16], const uint32_t m[16], size_t round) {
+    // Select message schedule for this round
+    const uint8_t* schedule = MSG_SCHEDULE[round];
+
+    // Column step
+    g(state, 0, 4, 8,  12, m[schedule[0]], m[schedule[1]]);
+    g(state, 1, 5, 9,  13, m[schedule[2]], m[schedule[3]]);
+    g(state, 2, 6, 10, 14, m[schedule[4]], m[schedule[5]]);
+    g(state, 3, 7, 11, 15, m[schedule[6]], m[schedule[7]]);
+
+    // Diagonal step
+    g(state, 0, 5, 10, 15, m[schedule[8]],  m[schedule[9]]);
+    g(state, 1, 6, 11, 12, m[schedule[10]], m[schedule[11]]);
+    g(state, 2, 7, 8,  13, m[schedule[12]], m[schedule[13]]);
+    g(state, 3, 4, 9,  14, m[schedule[14]], m[schedule[15]]);
+}
+
+/// @brief Run the 7 rounds over the initial state built from cv and the block
+void compressRounds(uint32_t state[16], const uint32_t cv[8], const uint8_t block[BLOCK_LEN],
+                    uint8_t blockLen, uint64_t counter, uint8_t flags) {
+    uint32_t m[16];
+    for (size_t i = 0; i < 16; i++) {
+        m[i] = load32(&block[i * 4]);
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+        state[i] = cv[i];
+    }
+    state[8] = IV[0];
+    state[9] = IV[1];
+    state[10] = IV[2];
+    state[11] = IV[3];
+    state[12] = static_cast<uint32_t>(counter);
+    state[13] = static_cast<uint32_t>(counter >> 32);
+    state[14] = static_cast<uint32_t>(blockLen);
+    state[15] = static_cast<uint32_t>(flags);
+
+    for (size_t round = 0; round < 7; round++) {
+        roundFunction(state, m, round);
+    }
+}
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+using CompressInPlaceFn = void (*)(uint32_t*, const uint8_t*, uint8_t, uint64_t, uint8_t);
+using CompressXofFn = void (*)(const uint32_t*, const uint8_t*, uint8_t, uint64_t, uint8_t, uint8_t*);
+
+CompressInPlaceFn selectCompressInPlace() {
+#if defined(HASHCALC_X86)
+    if (CpuFeatures::get().sse41) {
+        return compressInPlaceSse41;
+    }
+#endif
+    return compressInPlacePortable;
+}
+
+CompressXofFn selectCompressXof() {
+#if defined(HASHCALC_X86)
+    if (CpuFeatures::get().sse41) {
+        return compressXofSse41;
+    }
+#endif
+    return compressXofPortable;
+}
+
+/// @brief hashMany() for a single input, one block at a time
+void hashOne(const uint8_t* input, size_t blocks, const uint32_t key[8], uint64_t counter,
+             uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t out[OUT_LEN]) {
+    uint32_t cv[8];
+    std::memcpy(cv, key, sizeof(cv));
+    uint8_t blockFlags = flags | flagsStart;
+    while (blocks > 0) {
+        if (blocks == 1) {
+            blockFlags |= flagsEnd;
+        }
+        compressInPlace(cv, input, BLOCK_LEN, counter, blockFlags);
+        input += BLOCK_LEN;
+        blocks -= 1;
+        blockFlags = flags;
+    }
+    for (size_t i = 0; i < 8; i++) {
+        store32(&out[i * 4], cv[i]);
+    }
+}
+
+// ============================================================================
+// Subtrees
+// ============================================================================
+
+/// @brief Bytes in the left subtree of content: the largest power of two number of
+///        whole chunks that still leaves at least one byte for the right side
+size_t leftLength(size_t contentLength) {
+    size_t fullChunks = (contentLength - 1) / CHUNK_LEN;
+    return static_cast<size_t>(roundDownToPowerOf2(fullChunks)) * CHUNK_LEN;
+}
+
+/// @brief Hash up to simdDegree() chunks side by side
+/// @return Number of chaining values written (the last one may be a partial chunk)
+size_t compressChunksParallel(const uint8_t* input, size_t length, const uint32_t key[8],
+                              uint64_t chunkCounter, uint8_t flags, uint8_t* out) {
+    const uint8_t* chunks[MAX_SIMD_DEGREE];
+    size_t chunkCount = 0;
+    size_t position = 0;
+    while (length - position >= CHUNK_LEN) {
+        chunks[chunkCount++] = input + position;
+        position += CHUNK_LEN;
+    }
+    hashMany(chunks, chunkCount, CHUNK_LEN / BLOCK_LEN, key, chunkCounter, true, flags,
+             CHUNK_START, CHUNK_END, out);
+
+    if (length == position) {
+        return chunkCount;
+    }
+
+    // Trailing partial chunk
+    compressChunk(input + position, length - position, key, chunkCounter + chunkCount, flags,
+                  out + chunkCount * OUT_LEN);
+    return chunkCount + 1;
+}
+
+/// @brief Hash pairs of chaining values into parents side by side; an odd one is passed through
+/// @return Number of chaining values written
+size_t compressParentsParallel(const uint8_t* childCvs, size_t cvCount, const uint32_t key[8],
+                               uint8_t flags, uint8_t* out) {
+    const uint8_t* parents[MAX_SIMD_DEGREE];
+    size_t parentCount = 0;
+    while (cvCount - 2 * parentCount >= 2) {
+        parents[parentCount] = childCvs + 2 * parentCount * OUT_LEN;
+        parentCount++;
+    }
+    hashMany(parents, parentCount, 1, key, 0, false, flags | PARENT, 0, 0, out);
+
+    if (cvCount > 2 * parentCount) {
+        std::memcpy(out + parentCount * OUT_LEN, childCvs + 2 * parentCount * OUT_LEN, OUT_LEN);
+        return parentCount + 1;
+    }
+    return parentCount;
+}
+
+/// @brief Hash a subtree down to at most MAX_SIMD_DEGREE (at least two) chaining values
+/// @return Number of chaining values written
+size_t compressSubtreeWide(const uint8_t* input, size_t length, const uint32_t key[8],
+                           uint64_t chunkCounter, uint8_t flags, uint8_t* out, ThreadPool* pool) {
+    size_t degree = simdDegree();
+    if (length <= degree * CHUNK_LEN) {
+        return compressChunksParallel(input, length, key, chunkCounter, flags, out);
+    }
+
+    // Split into left and right subtrees; the left is a power of two number of chunks
+    const size_t leftLen = leftLength(length);
+    const size_t rightLen = length - leftLen;
+    const uint64_t rightCounter = chunkCounter + leftLen / CHUNK_LEN;
+
+    // Without SIMD each side returns one value at the chunk level; make parents
+    // return two so that the caller always gets at least two
+    if (leftLen > CHUNK_LEN && degree == 1) {
+        degree = 2;
+    }
+    uint8_t cvs[2 * MAX_SIMD_DEGREE * OUT_LEN];
+    uint8_t* rightCvs = cvs + degree * OUT_LEN;
+
+    size_t leftCount = 0;
+    size_t rightCount = 0;
+    auto hashLeft = [&]() {
+        leftCount = compressSubtreeWide(input, leftLen, key, chunkCounter, flags, cvs, pool);
+    };
+    auto hashRight = [&]() {
+        rightCount = compressSubtreeWide(input + leftLen, rightLen, key, rightCounter, flags, rightCvs, pool);
+    };
+    // The right half is never longer than the left one
+    if (pool != nullptr && rightLen >= MIN_PARALLEL_LEN) {
+        pool->join(hashLeft, hashRight);
+    } else {
+        hashLeft();
+        hashRight();
+    }
+
+    if (leftCount == 1) {
+        std::memcpy(out, cvs, 2 * OUT_LEN);
+        return 2;
+    }
+    return compressParentsParallel(cvs, leftCount + rightCount, key, flags, out);
+}
+
+} // namespace
+
+void compressInPlacePortable(uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                             uint64_t counter, uint8_t flags) {
+    uint32_t state[16];
+    compressRounds(state, cv, block, blockLen, counter, flags);
+
+    // Finalize: XOR the two halves of the state
+    for (size_t i = 0; i < 8; i++) {
+        cv[i] = state[i] ^ state[i + 8];
+    }
+}
+
+void compressXofPortable(const uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                         uint64_t counter, uint8_t flags, uint8_t out[64]) {
+    uint32_t state[16];
+    compressRounds(state, cv, block, blockLen, counter, flags);
+
+    // Output full 64 bytes (16 words) - XOF mode
+    // First 8 words: state[i] ^ state[i+8]
+    for (size_t i = 0; i < 8; i++) {
+        store32(&out[i * 4], state[i] ^ state[i + 8]);
+    }
+    // Last 8 words: state[i+8] ^ cv[i]
+    for (size_t i = 0; i < 8; i++) {
+        store32(&out[(i + 8) * 4], state[i + 8] ^ cv[i]);
+    }
+}
+
+size_t simdDegree() {
+#if defined(HASHCALC_X86)
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (cpu.avx512f && cpu.avx512vl) {
+        return 16;
+    }
+    if (cpu.avx2) {
+        return 8;
+    }
+    if (cpu.sse41) {
+        return 4;
+    }
+#endif
+    return 1;
+}
+
+void compressInPlace(uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                     uint64_t counter, uint8_t flags) {
+    static const CompressInPlaceFn kernel = selectCompressInPlace();
+    kernel(cv, block, blockLen, counter, flags);
+}
+
+void compressXof(const uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                 uint64_t counter, uint8_t flags, uint8_t out[64]) {
+    static const CompressXofFn kernel = selectCompressXof();
+    kernel(cv, block, blockLen, counter, flags, out);
+}
+
+void hashMany(const uint8_t* const* inputs, size_t count, size_t blocks, const uint32_t key[8],
+              uint64_t counter, bool incrementCounter, uint8_t flags, uint8_t flagsStart,
+              uint8_t flagsEnd, uint8_t* out) {
+    // Widest kernel first, narrower ones for what is left over
+    auto runGroups = [&](size_t width, void (*kernel)(const uint8_t* const*, size_t, const uint32_t*, uint64_t,
+                                                      bool, uint8_t, uint8_t, uint8_t, uint8_t*)) {
+        while (count >= width) {
+            kernel(inputs, blocks, key, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+            inputs += width;
+            count -= width;
+            if (incrementCounter) {
+                counter += width;
+            }
+            out += width * OUT_LEN;
+        }
+    };
+
+#if defined(HASHCALC_X86)
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (cpu.avx512f && cpu.avx512vl) {
+        runGroups(16, hash16Avx512);
+    }
+    if (cpu.avx2) {
+        runGroups(8, hash8Avx2);
+    }
+    if (cpu.sse41) {
+        runGroups(4, hash4Sse41);
+    }
+#else
+    (void)runGroups;
+#endif
+
+    while (count > 0) {
+        hashOne(*inputs, blocks, key, counter, flags, flagsStart, flagsEnd, out);
+        inputs++;
+        count--;
+        if (incrementCounter) {
+            counter++;
+        }
+        out += OUT_LEN;
+    }
+}
+
+void compressChunk(const uint8_t* input, size_t length, const uint32_t key[8], uint64_t chunkCounter,
+                   uint8_t flags, uint8_t out[OUT_LEN], bool root) {
+    // Compressed block by block with the last block zero padded
+    uint32_t cv[8];
+    std::memcpy(cv, key, sizeof(cv));
+    uint8_t blockFlags = flags | CHUNK_START;
+    size_t position = 0;
+    while (length - position > BLOCK_LEN) {
+        compressInPlace(cv, input + position, BLOCK_LEN, chunkCounter, blockFlags);
+        position += BLOCK_LEN;
+        blockFlags = flags;
+    }
+    uint8_t block[BLOCK_LEN] = {};
+    const size_t blockLen = length - position;
+    std::memcpy(block, input + position, blockLen);
+    blockFlags |= CHUNK_END | (root ? ROOT : 0);
+    compressInPlace(cv, block, static_cast<uint8_t>(blockLen), chunkCounter, blockFlags);
+    for (size_t i = 0; i < 8; i++) {
+        store32(&out[i * 4], cv[i]);
+    }
+}
+
+void compressSubtreeToParentNode(const uint8_t* input, size_t length, const uint32_t key[8],
+                                 uint64_t chunkCounter, uint8_t flags, uint8_t out[2 * OUT_LEN],
+                                 ThreadPool* pool) {
+    uint8_t cvs[MAX_SIMD_DEGREE * OUT_LEN];
+    size_t cvCount = compressSubtreeWide(input, length, key, chunkCounter, flags, cvs, pool);
+
+    // Condense to a single pair by forming parents repeatedly
+    uint8_t parents[MAX_SIMD_DEGREE * OUT_LEN / 2];
+    while (cvCount > 2) {
+        cvCount = compressParentsParallel(cvs, cvCount, key, flags, parents);
+        std::memcpy(cvs, parents, cvCount * OUT_LEN);
+    }
+    std::memcpy(out, cvs, 2 * OUT_LEN);
+}
+
+} // namespace blake3
+} // namespace impl
+} // namespace core
@@ -0,0 +1,122 @@
+#ifndef BLAKE3_KERNELS_H
+#define BLAKE3_KERNELS_H
+
+#include "../../CpuFeatures.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+
+class ThreadPool;
+
+namespace impl {
+namespace blake3 {
+
+/**
+ * @brief BLAKE3 compression kernels shared by every BLAKE3 output size.
+ *
+ * compressInPlace()/compressXof() compress one block; hashMany() compresses
+ * the same number of blocks from several independent inputs (chunks or
+ * parent nodes) side by side, one input per SIMD lane. The entry points pick
+ * the widest kernel the CPU supports on every call: AVX-512 (16 lanes),
+ * AVX2 (8), SSE4.1 (4), or the portable code.
+ *
+ * compressSubtreeToParentNode() hashes a whole aligned subtree of chunks
+ * with hashMany() level by level, which is where the SIMD parallelism of
+ * BLAKE3::Update comes from. Given a ThreadPool it also hashes the two
+ * halves of large subtrees on different threads; the tree and therefore
+ * the digest are the same either way.
+ */
+
+constexpr size_t BLOCK_LEN = 64;
+constexpr size_t CHUNK_LEN = 1024;
+constexpr size_t OUT_LEN = 32;
+
+/// @brief Widest kernel: inputs hashed per hashMany() step
+constexpr size_t MAX_SIMD_DEGREE = 16;
+
+/// @brief Subtree halves at least this long are hashed on separate threads
+constexpr size_t MIN_PARALLEL_LEN = 128 * CHUNK_LEN;
+
+enum Flags : uint8_t {
+    CHUNK_START         = 1 << 0,
+    CHUNK_END           = 1 << 1,
+    PARENT              = 1 << 2,
+    ROOT                = 1 << 3,
+    KEYED_HASH          = 1 << 4,
+    DERIVE_KEY_CONTEXT  = 1 << 5,
+    DERIVE_KEY_MATERIAL = 1 << 6,
+};
+
+extern const uint32_t IV[8];
+extern const uint8_t MSG_SCHEDULE[7][16];
+
+/// @return Largest power of two not above x (x > 0)
+inline uint64_t roundDownToPowerOf2(uint64_t x) {
+    while ((x & (x - 1)) != 0) {
+        x &= x - 1;
+    }
+    return x;
+}
+
+/// @return Inputs the best available hashMany() kernel processes at once (1 without SIMD)
+size_t simdDegree();
+
+/// @brief Compress one block into the chaining value
+void compressInPlace(uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                     uint64_t counter, uint8_t flags);
+
+/// @brief Compress one block and write all 64 output bytes (root output / XOF)
+void compressXof(const uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                 uint64_t counter, uint8_t flags, uint8_t out[64]);
+
+/// @brief Hash count inputs of exactly blocks * BLOCK_LEN bytes each
+/// @param counter Counter of the first input; incremented per input if incrementCounter
+/// @param flagsStart Extra flags of each input's first block, flagsEnd of its last
+/// @param out Receives count chaining values of OUT_LEN bytes
+void hashMany(const uint8_t* const* inputs, size_t count, size_t blocks, const uint32_t key[8],
+              uint64_t counter, bool incrementCounter, uint8_t flags, uint8_t flagsStart,
+              uint8_t flagsEnd, uint8_t* out);
+
+/// @brief Hash one chunk of at most CHUNK_LEN bytes
+/// @param root true if the chunk is the whole message: out receives its digest
+///        (the first OUT_LEN bytes) instead of its chaining value
+void compressChunk(const uint8_t* input, size_t length, const uint32_t key[8], uint64_t chunkCounter,
+                   uint8_t flags, uint8_t out[OUT_LEN], bool root = false);
+
+/// @brief Hash a subtree of more than one chunk down to the two chaining values of
+///        its top parent node, which is left uncompressed (it may be the root)
+/// @param length Bytes in the subtree; a power of two number of whole chunks when
+///        called from Update so that the subtree is aligned within the message
+/// @param pool Workers to share large subtrees with, nullptr to hash on the calling thread
+void compressSubtreeToParentNode(const uint8_t* input, size_t length, const uint32_t key[8],
+                                 uint64_t chunkCounter, uint8_t flags, uint8_t out[2 * OUT_LEN],
+                                 ThreadPool* pool = nullptr);
+
+// Portable and instruction set specific kernels, chosen by the functions above
+
+void compressInPlacePortable(uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                             uint64_t counter, uint8_t flags);
+void compressXofPortable(const uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                         uint64_t counter, uint8_t flags, uint8_t out[64]);
+
+#if defined(HASHCALC_X86)
+void compressInPlaceSse41(uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                          uint64_t counter, uint8_t flags);
+void compressXofSse41(const uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                      uint64_t counter, uint8_t flags, uint8_t out[64]);
+
+/// @brief hashMany() for exactly 4, 8 or 16 inputs
+void hash4Sse41(const uint8_t* const* inputs, size_t blocks, const uint32_t key[8], uint64_t counter,
+                bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out);
+void hash8Avx2(const uint8_t* const* inputs, size_t blocks, const uint32_t key[8], uint64_t counter,
+               bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out);
+void hash16Avx512(const uint8_t* const* inputs, size_t blocks, const uint32_t key[8], uint64_t counter,
+                  bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out);
+#endif
+
+} // namespace blake3
+} // namespace impl
+} // namespace core
+
+#endif // BLAKE3_KERNELS_H
@@ -0,0 +1,342 @@
+#include "BLAKE3Kernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <immintrin.h>
+#include <cstring>
+
+namespace core {
+namespace impl {
+namespace blake3 {
+
+namespace {
+
+#define SSE41 HASHCALC_TARGET("sse4.1")
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+SSE41 inline __m128i loadu(const void* src) {
+    return _mm_loadu_si128(static_cast<const __m128i*>(src));
+}
+
+SSE41 inline void storeu(void* dest, __m128i src) {
+    _mm_storeu_si128(static_cast<__m128i*>(dest), src);
+}
+
+SSE41 inline __m128i addv(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+SSE41 inline __m128i xorv(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+SSE41 inline __m128i set1(uint32_t x) { return _mm_set1_epi32(static_cast<int32_t>(x)); }
+
+SSE41 inline __m128i set4(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    return _mm_setr_epi32(static_cast<int32_t>(a), static_cast<int32_t>(b),
+                          static_cast<int32_t>(c), static_cast<int32_t>(d));
+}
+
+SSE41 inline __m128i rot16(__m128i x) {
+    return _mm_shuffle_epi8(x, _mm_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2));
+}
+
+SSE41 inline __m128i rot12(__m128i x) {
+    return xorv(_mm_srli_epi32(x, 12), _mm_slli_epi32(x, 32 - 12));
+}
+
+SSE41 inline __m128i rot8(__m128i x) {
+    return _mm_shuffle_epi8(x, _mm_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1));
+}
+
+SSE41 inline __m128i rot7(__m128i x) {
+    return xorv(_mm_srli_epi32(x, 7), _mm_slli_epi32(x, 32 - 7));
+}
+
+// Two-source 32-bit shuffle, like SHUFPS on integer vectors
+#define SHUFFLE2(a, b, c)                                                     \
+    (_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), (c))))
+
+// ============================================================================
+// Single Block: one row of the state per vector
+// ============================================================================
+
+SSE41 inline void g1(__m128i* row0, __m128i* row1, __m128i* row2, __m128i* row3, __m128i m) {
+    *row0 = addv(addv(*row0, m), *row1);
+    *row3 = xorv(*row3, *row0);
+    *row3 = rot16(*row3);
+    *row2 = addv(*row2, *row3);
+    *row1 = xorv(*row1, *row2);
+    *row1 = rot12(*row1);
+}
+
+SSE41 inline void g2(__m128i* row0, __m128i* row1, __m128i* row2, __m128i* row3, __m128i m) {
+    *row0 = addv(addv(*row0, m), *row1);
+    *row3 = xorv(*row3, *row0);
+    *row3 = rot8(*row3);
+    *row2 = addv(*row2, *row3);
+    *row1 = xorv(*row1, *row2);
+    *row1 = rot7(*row1);
+}
+
+// Rotate the rows so that the diagonals become columns, and back. Row 1 stays
+// in place, which keeps the message words in the order the shuffles produce.
+SSE41 inline void diagonalize(__m128i* row0, __m128i* row2, __m128i* row3) {
+    *row0 = _mm_shuffle_epi32(*row0, _MM_SHUFFLE(2, 1, 0, 3));
+    *row3 = _mm_shuffle_epi32(*row3, _MM_SHUFFLE(1, 0, 3, 2));
+    *row2 = _mm_shuffle_epi32(*row2, _MM_SHUFFLE(0, 3, 2, 1));
+}
+
+SSE41 inline void undiagonalize(__m128i* row0, __m128i* row2, __m128i* row3) {
+    *row0 = _mm_shuffle_epi32(*row0, _MM_SHUFFLE(0, 3, 2, 1));
+    *row3 = _mm_shuffle_epi32(*row3, _MM_SHUFFLE(1, 0, 3, 2));
+    *row2 = _mm_shuffle_epi32(*row2, _MM_SHUFFLE(2, 1, 0, 3));
+}
+
+SSE41 void compressPre(__m128i rows[4], const uint32_t cv[8], const uint8_t block[BLOCK_LEN],
+                       uint8_t blockLen, uint64_t counter, uint8_t flags) {
+    rows[0] = loadu(&cv[0]);
+    rows[1] = loadu(&cv[4]);
+    rows[2] = set4(IV[0], IV[1], IV[2], IV[3]);
+    rows[3] = set4(static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32),
+                   static_cast<uint32_t>(blockLen), static_cast<uint32_t>(flags));
+
+    __m128i m0 = loadu(&block[0]);
+    __m128i m1 = loadu(&block[16]);
+    __m128i m2 = loadu(&block[32]);
+    __m128i m3 = loadu(&block[48]);
+
+    __m128i t0, t1, t2, t3, tt;
+
+    // Round 1. The first round permutes the message words from their
+    // original order.
+    t0 = SHUFFLE2(m0, m1, _MM_SHUFFLE(2, 0, 2, 0));
+    g1(&rows[0], &rows[1], &rows[2], &rows[3], t0);
+    t1 = SHUFFLE2(m0, m1, _MM_SHUFFLE(3, 1, 3, 1));
+    g2(&rows[0], &rows[1], &rows[2], &rows[3], t1);
+    diagonalize(&rows[0], &rows[2], &rows[3]);
+    t2 = SHUFFLE2(m2, m3, _MM_SHUFFLE(2, 0, 2, 0));
+    t2 = _mm_shuffle_epi32(t2, _MM_SHUFFLE(2, 1, 0, 3));
+    g1(&rows[0], &rows[1], &rows[2], &rows[3], t2);
+    t3 = SHUFFLE2(m2, m3, _MM_SHUFFLE(3, 1, 3, 1));
+    t3 = _mm_shuffle_epi32(t3, _MM_SHUFFLE(2, 1, 0, 3));
+    g2(&rows[0], &rows[1], &rows[2], &rows[3], t3);
+    undiagonalize(&rows[0], &rows[2], &rows[3]);
+    m0 = t0;
+    m1 = t1;
+    m2 = t2;
+    m3 = t3;
+
+    // Rounds 2-7. Each one permutes the previous round's message words the same way.
+    for (int round = 1; round < 7; round++) {
+        t0 = SHUFFLE2(m0, m1, _MM_SHUFFLE(3, 1, 1, 2));
+        t0 = _mm_shuffle_epi32(t0, _MM_SHUFFLE(0, 3, 2, 1));
+        g1(&rows[0], &rows[1], &rows[2], &rows[3], t0);
+        t1 = SHUFFLE2(m2, m3, _MM_SHUFFLE(3, 3, 2, 2));
+        tt = _mm_shuffle_epi32(m0, _MM_SHUFFLE(0, 0, 3, 3));
+        t1 = _mm_blend_epi16(tt, t1, 0xCC);
+        g2(&rows[0], &rows[1], &rows[2], &rows[3], t1);
+        diagonalize(&rows[0], &rows[2], &rows[3]);
+        t2 = _mm_unpacklo_epi64(m3, m1);
+        tt = _mm_blend_epi16(t2, m2, 0xC0);
+        t2 = _mm_shuffle_epi32(tt, _MM_SHUFFLE(1, 3, 2, 0));
+        g1(&rows[0], &rows[1], &rows[2], &rows[3], t2);
+        t3 = _mm_unpackhi_epi32(m1, m3);
+        tt = _mm_unpacklo_epi32(m2, t3);
+        t3 = _mm_shuffle_epi32(tt, _MM_SHUFFLE(0, 1, 3, 2));
+        g2(&rows[0], &rows[1], &rows[2], &rows[3], t3);
+        undiagonalize(&rows[0], &rows[2], &rows[3]);
+        m0 = t0;
+        m1 = t1;
+        m2 = t2;
+        m3 = t3;
+    }
+}
+
+// ============================================================================
+// Four Inputs: one state word of all four inputs per vector
+// ============================================================================
+
+SSE41 inline void roundFn(__m128i v[16], const __m128i m[16], size_t round) {
+    const uint8_t* s = MSG_SCHEDULE[round];
+
+    // Column step
+    v[0] = addv(v[0], m[s[0]]);
+    v[1] = addv(v[1], m[s[2]]);
+    v[2] = addv(v[2], m[s[4]]);
+    v[3] = addv(v[3], m[s[6]]);
+    v[0] = addv(v[0], v[4]);
+    v[1] = addv(v[1], v[5]);
+    v[2] = addv(v[2], v[6]);
+    v[3] = addv(v[3], v[7]);
+    v[12] = rot16(xorv(v[12], v[0]));
+    v[13] = rot16(xorv(v[13], v[1]));
+    v[14] = rot16(xorv(v[14], v[2]));
+    v[15] = rot16(xorv(v[15], v[3]));
+    v[8] = addv(v[8], v[12]);
+    v[9] = addv(v[9], v[13]);
+    v[10] = addv(v[10], v[14]);
+    v[11] = addv(v[11], v[15]);
+    v[4] = rot12(xorv(v[4], v[8]));
+    v[5] = rot12(xorv(v[5], v[9]));
+    v[6] = rot12(xorv(v[6], v[10]));
+    v[7] = rot12(xorv(v[7], v[11]));
+    v[0] = addv(v[0], m[s[1]]);
+    v[1] = addv(v[1], m[s[3]]);
+    v[2] = addv(v[2], m[s[5]]);
+    v[3] = addv(v[3], m[s[7]]);
+    v[0] = addv(v[0], v[4]);
+    v[1] = addv(v[1], v[5]);
+    v[2] = addv(v[2], v[6]);
+    v[3] = addv(v[3], v[7]);
+    v[12] = rot8(xorv(v[12], v[0]));
+    v[13] = rot8(xorv(v[13], v[1]));
+    v[14] = rot8(xorv(v[14], v[2]));
+    v[15] = rot8(xorv(v[15], v[3]));
+    v[8] = addv(v[8], v[12]);
+    v[9] = addv(v[9], v[13]);
+    v[10] = addv(v[10], v[14]);
+    v[11] = addv(v[11], v[15]);
+    v[4] = rot7(xorv(v[4], v[8]));
+    v[5] = rot7(xorv(v[5], v[9]));
+    v[6] = rot7(xorv(v[6], v[10]));
+    v[7] = rot7(xorv(v[7], v[11]));
+
+    // Diagonal step
+    v[0] = addv(v[0], m[s[8]]);
+    v[1] = addv(v[1], m[s[10]]);
+    v[2] = addv(v[2], m[s[12]]);
+    v[3] = addv(v[3], m[s[14]]);
+    v[0] = addv(v[0], v[5]);
+    v[1] = addv(v[1], v[6]);
+    v[2] = addv(v[2], v[7]);
+    v[3] = addv(v[3], v[4]);
+    v[15] = rot16(xorv(v[15], v[0]));
+    v[12] = rot16(xorv(v[12], v[1]));
+    v[13] = rot16(xorv(v[13], v[2]));
+    v[14] = rot16(xorv(v[14], v[3]));
+    v[10] = addv(v[10], v[15]);
+    v[11] = addv(v[11], v[12]);
+    v[8] = addv(v[8], v[13]);
+    v[9] = addv(v[9], v[14]);
+    v[5] = rot12(xorv(v[5], v[10]));
+    v[6] = rot12(xorv(v[6], v[11]));
+    v[7] = rot12(xorv(v[7], v[8]));
+    v[4] = rot12(xorv(v[4], v[9]));
+    v[0] = addv(v[0], m[s[9]]);
+    v[1] = addv(v[1], m[s[11]]);
+    v[2] = addv(v[2], m[s[13]]);
+    v[3] = addv(v[3], m[s[15]]);
+    v[0] = addv(v[0], v[5]);
+    v[1] = addv(v[1], v[6]);
+    v[2] = addv(v[2], v[7]);
+    v[3] = addv(v[3], v[4]);
+    v[15] = rot8(xorv(v[15], v[0]));
+    v[12] = rot8(xorv(v[12], v[1]));
+    v[13] = rot8(xorv(v[13], v[2]));
+    v[14] = rot8(xorv(v[14], v[3]));
+    v[10] = addv(v[10], v[15]);
+    v[11] = addv(v[11], v[12]);
+    v[8] = addv(v[8], v[13]);
+    v[9] = addv(v[9], v[14]);
+    v[5] = rot7(xorv(v[5], v[10]));
+    v[6] = rot7(xorv(v[6], v[11]));
+    v[7] = rot7(xorv(v[7], v[8]));
+    v[4] = rot7(xorv(v[4], v[9]));
+}
+
+SSE41 inline void transpose4(__m128i v[4]) {
+    const __m128i ab01 = _mm_unpacklo_epi32(v[0], v[1]);
+    const __m128i ab23 = _mm_unpackhi_epi32(v[0], v[1]);
+    const __m128i cd01 = _mm_unpacklo_epi32(v[2], v[3]);
+    const __m128i cd23 = _mm_unpackhi_epi32(v[2], v[3]);
+    v[0] = _mm_unpacklo_epi64(ab01, cd01);
+    v[1] = _mm_unpackhi_epi64(ab01, cd01);
+    v[2] = _mm_unpacklo_epi64(ab23, cd23);
+    v[3] = _mm_unpackhi_epi64(ab23, cd23);
+}
+
+/// @brief Load one block of each input with message word i of every input in m[i]
+SSE41 inline void loadMessages(const uint8_t* const* inputs, size_t offset, __m128i m[16]) {
+    for (size_t quarter = 0; quarter < 4; quarter++) {
+        for (size_t lane = 0; lane < 4; lane++) {
+            m[quarter * 4 + lane] = loadu(inputs[lane] + offset + quarter * 16);
+        }
+        transpose4(&m[quarter * 4]);
+    }
+}
+
+} // namespace
+
+SSE41 void compressInPlaceSse41(uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                          uint64_t counter, uint8_t flags) {
+    __m128i rows[4];
+    compressPre(rows, cv, block, blockLen, counter, flags);
+    storeu(&cv[0], xorv(rows[0], rows[2]));
+    storeu(&cv[4], xorv(rows[1], rows[3]));
+}
+
+SSE41 void compressXofSse41(const uint32_t cv[8], const uint8_t block[BLOCK_LEN], uint8_t blockLen,
+                      uint64_t counter, uint8_t flags, uint8_t out[64]) {
+    __m128i rows[4];
+    compressPre(rows, cv, block, blockLen, counter, flags);
+    storeu(&out[0], xorv(rows[0], rows[2]));
+    storeu(&out[16], xorv(rows[1], rows[3]));
+    storeu(&out[32], xorv(rows[2], loadu(&cv[0])));
+    storeu(&out[48], xorv(rows[3], loadu(&cv[4])));
+}
+
+SSE41 void hash4Sse41(const uint8_t* const* inputs, size_t blocks, const uint32_t key[8], uint64_t counter,
+                bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out) {
+    __m128i h[8];
+    for (size_t i = 0; i < 8; i++) {
+        h[i] = set1(key[i]);
+    }
+
+    uint32_t counterLow[4];
+    uint32_t counterHigh[4];
+    for (size_t lane = 0; lane < 4; lane++) {
+        const uint64_t laneCounter = counter + (incrementCounter ? lane : 0);
+        counterLow[lane] = static_cast<uint32_t>(laneCounter);
+        counterHigh[lane] = static_cast<uint32_t>(laneCounter >> 32);
+    }
+    const __m128i low = loadu(counterLow);
+    const __m128i high = loadu(counterHigh);
+
+    uint8_t blockFlags = flags | flagsStart;
+    for (size_t block = 0; block < blocks; block++) {
+        if (block + 1 == blocks) {
+            blockFlags |= flagsEnd;
+        }
+
+        __m128i m[16];
+        loadMessages(inputs, block * BLOCK_LEN, m);
+
+        __m128i v[16] = {
+            h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+            set1(IV[0]), set1(IV[1]), set1(IV[2]), set1(IV[3]),
+            low, high, set1(static_cast<uint32_t>(BLOCK_LEN)), set1(blockFlags),
+        };
+        for (size_t round = 0; round < 7; round++) {
+            roundFn(v, m, round);
+        }
+        for (size_t i = 0; i < 8; i++) {
+            h[i] = xorv(v[i], v[i + 8]);
+        }
+        blockFlags = flags;
+    }
+
+    // Back from one word per vector to one chaining value per input
+    transpose4(&h[0]);
+    transpose4(&h[4]);
+    for (size_t lane = 0; lane < 4; lane++) {
+        storeu(&out[lane * OUT_LEN], h[lane]);
+        storeu(&out[lane * OUT_LEN + 16], h[lane + 4]);
+    }
+}
+
+#undef SHUFFLE2
+#undef SSE41
+
+} // namespace blake3
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
@@ -2,154 +2,122 @@
 #define CRC_H
 
 #include "../cryptopp/CryptoppHashBase.h"
+#include "CRCCatalogue.h"
 #include <cryptopp/cryptlib.h>
 #include <cryptopp/secblock.h>
-#include <array>
-#include <sstream>
+#include <stdexcept>
+#include <string>
 
 namespace core {
 namespace impl {
 
 /**
- * @brief CRC-8 implementation (CRC-8/CCITT variant)
- * Polynomial: 0x07
- * Initial value: 0x00
- * No final XOR, no reflection
+ * @brief Any CRC of the catalogue (CRCCatalogue.h) as a HashTransformation.
+ *
+ * Model gives the parameters and the name; crc::Engine<Model> supplies the
+ * compile-time tables and picks the kernel. The digest is the final CRC in
+ * big-endian order, the usual way CRC values are displayed.
+ *
+ * Large Update() inputs can be split over a ThreadPool and merged with
+ * Combine(), and UpdateZeros() feeds a run of zero bytes in O(log n).
+ *
+ * Usage:
+ *   CRC<crc::Crc16Modbus> modbus;
+ *   modbus.Update(data, length);
+ *   modbus.Final(digest);  // 2 bytes
  */
-class CRC8 : public CryptoPP::HashTransformation {
+template<typename Model>
+class CRC : public CryptoPP::HashTransformation {
 public:
-    CRYPTOPP_CONSTANT(DIGESTSIZE = 1);  // 8 bits = 1 byte
+    using Engine = crc::Engine<Model>;
+    using Register = typename Model::Register;
+
+    CRYPTOPP_CONSTANT(DIGESTSIZE = Model::WIDTH / 8);
     CRYPTOPP_CONSTANT(BLOCKSIZE = 1);
 
-    CRC8() : m_tableInitialized(false) { Restart(); }
+    CRC() { Restart(); }
 
     std::string AlgorithmName() const override {
-        return "CRC-8";
+        return Model::name();
     }
 
     static std::string StaticAlgorithmName() {
-        return "CRC-8";
+        return Model::name();
     }
 
     unsigned int DigestSize() const override { return DIGESTSIZE; }
     unsigned int BlockSize() const override { return BLOCKSIZE; }
 
-    void Update(const CryptoPP::byte *input, size_t length) override;
-    void TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) override;
-    void Restart() override;
-
-private:
-    void InitTable();
-    uint8_t m_crc;
-    std::array<uint8_t, 256> m_table;
-    bool m_tableInitialized;
-};
-
-/**
- * @brief CRC-16 implementation (CRC-16/CCITT-FALSE variant)
- * Polynomial: 0x1021
- * Initial value: 0xFFFF
- * No final XOR, no reflection
- */
-class CRC16 : public CryptoPP::HashTransformation {
-public:
-    CRYPTOPP_CONSTANT(DIGESTSIZE = 2);  // 16 bits = 2 bytes
-    CRYPTOPP_CONSTANT(BLOCKSIZE = 1);
-
-    CRC16() : m_tableInitialized(false) { Restart(); }
-
-    std::string AlgorithmName() const override {
-        return "CRC-16";
-    }
-    
-    static std::string StaticAlgorithmName() {
-        return "CRC-16";
+    void Update(const CryptoPP::byte *input, size_t length) override {
+        m_crc = static_cast<Register>(crc::updateParallel(Engine::POLYNOMIAL, Engine::updateWide, m_crc,
+                                                          input, length, m_pool));
     }
 
-    unsigned int DigestSize() const override { return DIGESTSIZE; }
-    unsigned int BlockSize() const override { return BLOCKSIZE; }
+    void TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) override {
+        ThrowIfInvalidTruncatedSize(digestSize);
 
-    void Update(const CryptoPP::byte *input, size_t length) override;
-    void TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) override;
-    void Restart() override;
+        const Register value = Engine::finalize(m_crc);
+        for (size_t i = 0; i < digestSize; ++i) {
+            digest[i] = static_cast<CryptoPP::byte>(value >> (8 * (DIGESTSIZE - 1 - i)));
+        }
 
-private:
-    void InitTable();
-    uint16_t m_crc;
-    std::array<uint16_t, 256> m_table;
-    bool m_tableInitialized;
-};
+        Restart();
+    }
 
-/**
- * @brief CRC-32C implementation (Castagnoli)
- * Polynomial: 0x1EDC6F41
- * Initial value: 0xFFFFFFFF
- * Final XOR: 0xFFFFFFFF
- * Used in iSCSI, SCTP, etc.
- */
-class CRC32C : public CryptoPP::HashTransformation {
-public:
-    CRYPTOPP_CONSTANT(DIGESTSIZE = 4);  // 32 bits = 4 bytes
-    CRYPTOPP_CONSTANT(BLOCKSIZE = 1);
+    void Restart() override {
+        m_crc = Engine::INIT;
+    }
 
-    CRC32C() : m_tableInitialized(false) { Restart(); }
+    /// @brief Append the running state to a saved hash state (see IHashAlgorithm::saveState)
+    void SaveState(HashStateWriter& writer) const {
+        writer.putU64(m_crc);
+    }
 
-    std::string AlgorithmName() const override {
-        return "CRC-32C";
+    /// @brief Restore a state written by SaveState()
+    /// @throws std::invalid_argument if the state is inconsistent
+    void LoadState(HashStateReader& reader) {
+        const uint64_t crc = reader.getU64();
+        if ((crc & ~crc::widthMask(Model::WIDTH)) != 0) {
+            throw std::invalid_argument(std::string("Invalid hash state: ") + Model::name() +
+                                        " register out of range");
+        }
+        m_crc = static_cast<Register>(crc);
     }
-    
-    static std::string StaticAlgorithmName() {
-        return "CRC-32C";
+
+    /// @brief Feed count zero bytes without reading them, in O(log count)
+    void UpdateZeros(uint64_t count) {
+        m_crc = static_cast<Register>(crc::shiftZeros(Engine::POLYNOMIAL, m_crc, count));
     }
 
-    unsigned int DigestSize() const override { return DIGESTSIZE; }
-    unsigned int BlockSize() const override { return BLOCKSIZE; }
+    /// @brief Hash large Update() inputs on the pool's workers as well
+    /// @param pool Pool to use (not owned), nullptr to hash on the calling thread only
+    void SetThreadPool(ThreadPool* pool) { m_pool = pool; }
 
-    void Update(const CryptoPP::byte *input, size_t length) override;
-    void TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) override;
-    void Restart() override;
+    /// @return CRC of a message A followed by B, from the CRCs of A and B and the length of B
+    static Register Combine(Register crcA, Register crcB, uint64_t lengthB) {
+        return Engine::combine(crcA, crcB, lengthB);
+    }
 
 private:
-    void InitTable();
-    uint32_t m_crc;
-    std::array<uint32_t, 256> m_table;
-    bool m_tableInitialized;
+    Register m_crc;
+    ThreadPool* m_pool = nullptr;  // Workers for large inputs (not owned)
 };
 
-/**
- * @brief CRC-64 implementation (ECMA-182 variant)
- * Polynomial: 0x42F0E1EBA9EA3693
- * Initial value: 0x0000000000000000
- * No final XOR, no reflection
- */
-class CRC64 : public CryptoPP::HashTransformation {
-public:
-    CRYPTOPP_CONSTANT(DIGESTSIZE = 8);  // 64 bits = 8 bytes
-    CRYPTOPP_CONSTANT(BLOCKSIZE = 1);
-
-    CRC64() : m_tableInitialized(false) { Restart(); }
+/// @brief CRC-8/SMBUS: polynomial 0x07, init 0x00, no reflection, no final XOR
+using CRC8 = CRC<crc::Crc8>;
 
-    std::string AlgorithmName() const override {
-        return "CRC-64";
-    }
-    
-    static std::string StaticAlgorithmName() {
-        return "CRC-64";
-    }
+/// @brief CRC-16/CCITT-FALSE: polynomial 0x1021, init 0xFFFF, no reflection, no final XOR
+using CRC16 = CRC<crc::Crc16>;
 
-    unsigned int DigestSize() const override { return DIGESTSIZE; }
-    unsigned int BlockSize() const override { return BLOCKSIZE; }
+/// @brief CRC-32 (zlib, PNG, Ethernet): polynomial 0x04C11DB7, reflected, init and final XOR 0xFFFFFFFF
+using CRC32 = CRC<crc::Crc32>;
 
-    void Update(const CryptoPP::byte *input, size_t length) override;
-    void TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) override;
-    void Restart() override;
+/// @brief CRC-32C (Castagnoli): polynomial 0x1EDC6F41, reflected, init and final XOR 0xFFFFFFFF;
+///        runs on the SSE4.2 or ARMv8 crc32c instructions where available
+using CRC32C = CRC<crc::Crc32c>;
 
-private:
-    void InitTable();
-    uint64_t m_crc;
-    std::array<uint64_t, 256> m_table;
-    bool m_tableInitialized;
-};
+/// @brief CRC-64/ECMA-182: polynomial 0x42F0E1EBA9EA3693, init 0, no reflection, no final XOR
+using CRC64 = CRC<crc::Crc64>;
 
 // Wrapper types for registration
 template<typename CRCImpl>
@@ -0,0 +1,129 @@
+#include "CRCKernels.h"
+
+#if defined(HASHCALC_ARM64)
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <arm_acle.h>
+#endif
+#include <arm_neon.h>
+#include <cstring>
+
+namespace core {
+namespace impl {
+namespace crc {
+
+namespace {
+
+#define ARMCRC HASHCALC_TARGET("+crc")
+#define PMULL HASHCALC_TARGET("+aes")
+
+ARMCRC inline uint64_t load64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/// @brief Hash blocks of three streams of streamLen bytes while they last
+ARMCRC inline uint32_t crc3Way(uint32_t crc0, const uint8_t*& data, size_t& length, size_t streamLen,
+                               uint32_t (*shiftStream)(uint32_t)) {
+    while (length >= 3 * streamLen) {
+        uint32_t crc1 = 0;
+        uint32_t crc2 = 0;
+        for (size_t i = 0; i < streamLen; i += 8) {
+            crc0 = __crc32cd(crc0, load64(data + i));
+            crc1 = __crc32cd(crc1, load64(data + streamLen + i));
+            crc2 = __crc32cd(crc2, load64(data + 2 * streamLen + i));
+        }
+        crc0 = shiftStream(crc0) ^ crc1;
+        crc0 = shiftStream(crc0) ^ crc2;
+        data += 3 * streamLen;
+        length -= 3 * streamLen;
+    }
+    return crc0;
+}
+
+/// @brief Multiply both halves of x by their constants: x moved forward by the fold distance
+PMULL inline uint8x16_t fold(uint8x16_t x, uint64x2_t k) {
+    const poly64x2_t xp = vreinterpretq_p64_u8(x);
+    const poly64x2_t kp = vreinterpretq_p64_u64(k);
+    const uint8x16_t low = vreinterpretq_u8_p128(vmull_p64(vgetq_lane_p64(xp, 0), vgetq_lane_p64(kp, 0)));
+    const uint8x16_t high = vreinterpretq_u8_p128(vmull_high_p64(xp, kp));
+    return veorq_u8(low, high);
+}
+
+PMULL inline uint64x2_t loadConstants(const uint64_t k[2]) {
+    return vld1q_u64(k);
+}
+
+/// @brief Reverses the bytes of a block so that MSB-first CRCs see x^127 in the top bit
+PMULL inline uint8x16_t orderBlock(uint8x16_t x, bool reflected) {
+    if (reflected) {
+        return x;
+    }
+    const uint8x16_t halves = vrev64q_u8(x);
+    return vextq_u8(halves, halves, 8);
+}
+
+PMULL inline uint8x16_t loadBlock(const uint8_t* p, bool reflected) {
+    return orderBlock(vld1q_u8(p), reflected);
+}
+
+} // namespace
+
+ARMCRC uint32_t crc32cArm64(uint32_t crc, const uint8_t* data, size_t length) {
+    crc = crc3Way(crc, data, length, CRC32C_LONG, crc32cShiftLong);
+    crc = crc3Way(crc, data, length, CRC32C_SHORT, crc32cShiftShort);
+    while (length >= 8) {
+        crc = __crc32cd(crc, load64(data));
+        data += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        crc = __crc32cb(crc, *data);
+        data++;
+        length--;
+    }
+    return crc;
+}
+
+PMULL void foldPmull(const FoldConstants& k, const uint8_t seed[16], const uint8_t* data, size_t length,
+                     uint8_t out[16]) {
+    const bool reflected = k.reflected;
+
+    // Four blocks in flight hide the multiplier latency
+    uint8x16_t x0 = orderBlock(veorq_u8(vld1q_u8(data), vld1q_u8(seed)), reflected);
+    uint8x16_t x1 = loadBlock(data + 16, reflected);
+    uint8x16_t x2 = loadBlock(data + 32, reflected);
+    uint8x16_t x3 = loadBlock(data + 48, reflected);
+    size_t position = 64;
+
+    const uint64x2_t k512 = loadConstants(k.k512);
+    while (length - position >= 64) {
+        x0 = veorq_u8(fold(x0, k512), loadBlock(data + position, reflected));
+        x1 = veorq_u8(fold(x1, k512), loadBlock(data + position + 16, reflected));
+        x2 = veorq_u8(fold(x2, k512), loadBlock(data + position + 32, reflected));
+        x3 = veorq_u8(fold(x3, k512), loadBlock(data + position + 48, reflected));
+        position += 64;
+    }
+
+    const uint64x2_t k128 = loadConstants(k.k128);
+    uint8x16_t x = veorq_u8(veorq_u8(fold(x0, loadConstants(k.k384)), fold(x1, loadConstants(k.k256))),
+                            veorq_u8(fold(x2, k128), x3));
+    while (position < length) {
+        x = veorq_u8(fold(x, k128), loadBlock(data + position, reflected));
+        position += 16;
+    }
+
+    vst1q_u8(out, orderBlock(x, reflected));
+}
+
+#undef PMULL
+#undef ARMCRC
+
+} // namespace crc
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_ARM64
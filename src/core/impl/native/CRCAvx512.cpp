@@ -0,0 +1,104 @@
+#include "CRCKernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <immintrin.h>
+
+namespace core {
+namespace impl {
+namespace crc {
+
+namespace {
+
+#define AVX512 HASHCALC_TARGET("avx512f,avx512bw,vpclmulqdq,pclmul,ssse3")
+
+// Four 128-bit blocks per register, each folded by the same distance
+
+AVX512 inline __m512i fold(__m512i x, __m512i k) {
+    return _mm512_xor_si512(_mm512_clmulepi64_epi128(x, k, 0x00), _mm512_clmulepi64_epi128(x, k, 0x11));
+}
+
+AVX512 inline __m128i fold(__m128i x, __m128i k) {
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+AVX512 inline __m128i loadConstants(const uint64_t k[2]) {
+    return _mm_set_epi64x(static_cast<long long>(k[1]), static_cast<long long>(k[0]));
+}
+
+AVX512 inline __m512i broadcastConstants(const uint64_t k[2]) {
+    return _mm512_broadcast_i32x4(loadConstants(k));
+}
+
+AVX512 inline __m128i byteReverse() {
+    return _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+}
+
+AVX512 inline __m512i orderBlocks(__m512i x, bool reflected) {
+    return reflected ? x : _mm512_shuffle_epi8(x, _mm512_broadcast_i32x4(byteReverse()));
+}
+
+AVX512 inline __m128i orderBlock(__m128i x, bool reflected) {
+    return reflected ? x : _mm_shuffle_epi8(x, byteReverse());
+}
+
+AVX512 inline __m512i loadBlocks(const uint8_t* p, bool reflected) {
+    return orderBlocks(_mm512_loadu_si512(p), reflected);
+}
+
+} // namespace
+
+AVX512 void foldAvx512(const FoldConstants& k, const uint8_t seed[16], const uint8_t* data, size_t length,
+                       uint8_t out[16]) {
+    if (length < 256) {
+        foldPclmul(k, seed, data, length, out);
+        return;
+    }
+
+    const bool reflected = k.reflected;
+    const __m512i first = _mm512_xor_si512(
+        _mm512_loadu_si512(data),
+        _mm512_zextsi128_si512(_mm_loadu_si128(reinterpret_cast<const __m128i*>(seed))));
+
+    // Sixteen blocks in flight
+    __m512i z0 = orderBlocks(first, reflected);
+    __m512i z1 = loadBlocks(data + 64, reflected);
+    __m512i z2 = loadBlocks(data + 128, reflected);
+    __m512i z3 = loadBlocks(data + 192, reflected);
+    size_t position = 256;
+
+    const __m512i k2048 = broadcastConstants(k.k2048);
+    while (length - position >= 256) {
+        z0 = _mm512_xor_si512(fold(z0, k2048), loadBlocks(data + position, reflected));
+        z1 = _mm512_xor_si512(fold(z1, k2048), loadBlocks(data + position + 64, reflected));
+        z2 = _mm512_xor_si512(fold(z2, k2048), loadBlocks(data + position + 128, reflected));
+        z3 = _mm512_xor_si512(fold(z3, k2048), loadBlocks(data + position + 192, reflected));
+        position += 256;
+    }
+
+    // Four registers into the last one, its four blocks into the last block
+    __m512i z = _mm512_xor_si512(
+        _mm512_xor_si512(fold(z0, broadcastConstants(k.k1536)), fold(z1, broadcastConstants(k.k1024))),
+        _mm512_xor_si512(fold(z2, broadcastConstants(k.k512)), z3));
+
+    const __m128i k128 = loadConstants(k.k128);
+    __m128i x = _mm_xor_si128(
+        _mm_xor_si128(fold(_mm512_extracti32x4_epi32(z, 0), loadConstants(k.k384)),
+                      fold(_mm512_extracti32x4_epi32(z, 1), loadConstants(k.k256))),
+        _mm_xor_si128(fold(_mm512_extracti32x4_epi32(z, 2), k128), _mm512_extracti32x4_epi32(z, 3)));
+    while (position < length) {
+        __m128i block = orderBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position)), reflected);
+        x = _mm_xor_si128(fold(x, k128), block);
+        position += 16;
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), orderBlock(x, reflected));
+}
+
+#undef AVX512
+
+} // namespace crc
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
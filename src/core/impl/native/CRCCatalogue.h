@@ -0,0 +1,131 @@
+#ifndef CRC_CATALOGUE_H
+#define CRC_CATALOGUE_H
+
+#include "CRCEngine.h"
+
+namespace core {
+namespace impl {
+namespace crc {
+
+// CRC models registered with the factory, with the parameters and names of
+// the CRC catalogue of Greg Cook's CRC RevEng. Parameters: register type,
+// width, polynomial, init, reflect in, reflect out, final XOR, check value.
+// The first five keep the names HashCalc has always used.
+
+/// @brief CRC-8/SMBUS
+struct Crc8 : Model<uint8_t, 8, 0x07, 0x00, false, false, 0x00, 0xF4> {
+    static const char* name() { return "CRC-8"; }
+};
+
+/// @brief CRC-16/IBM-3740, also known as CRC-16/CCITT-FALSE
+struct Crc16 : Model<uint16_t, 16, 0x1021, 0xFFFF, false, false, 0x0000, 0x29B1> {
+    static const char* name() { return "CRC-16"; }
+};
+
+/// @brief CRC-32/ISO-HDLC: zlib, PNG, Ethernet
+struct Crc32 : Model<uint32_t, 32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xCBF43926> {
+    static const char* name() { return "CRC32"; }
+};
+
+/// @brief CRC-32/ISCSI (Castagnoli): iSCSI, SCTP, ext4, Btrfs
+struct Crc32c : Model<uint32_t, 32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283> {
+    static const char* name() { return "CRC-32C"; }
+
+    /// @brief SSE4.2 or ARMv8 crc32c instructions where available
+    static uint32_t kernel(uint32_t crc, const uint8_t* data, size_t length) {
+        return crc32c(crc, data, length);
+    }
+};
+
+/// @brief CRC-64/ECMA-182
+struct Crc64 : Model<uint64_t, 64, 0x42F0E1EBA9EA3693ULL, 0, false, false, 0, 0x6C40DF5F0B497347ULL> {
+    static const char* name() { return "CRC-64"; }
+};
+
+struct Crc8MaximDow : Model<uint8_t, 8, 0x31, 0x00, true, true, 0x00, 0xA1> {
+    static const char* name() { return "CRC-8/MAXIM-DOW"; }
+};
+
+struct Crc8Autosar : Model<uint8_t, 8, 0x2F, 0xFF, false, false, 0xFF, 0xDF> {
+    static const char* name() { return "CRC-8/AUTOSAR"; }
+};
+
+struct Crc8Bluetooth : Model<uint8_t, 8, 0xA7, 0x00, true, true, 0x00, 0x26> {
+    static const char* name() { return "CRC-8/BLUETOOTH"; }
+};
+
+struct Crc16Arc : Model<uint16_t, 16, 0x8005, 0x0000, true, true, 0x0000, 0xBB3D> {
+    static const char* name() { return "CRC-16/ARC"; }
+};
+
+struct Crc16Modbus : Model<uint16_t, 16, 0x8005, 0xFFFF, true, true, 0x0000, 0x4B37> {
+    static const char* name() { return "CRC-16/MODBUS"; }
+};
+
+struct Crc16Usb : Model<uint16_t, 16, 0x8005, 0xFFFF, true, true, 0xFFFF, 0xB4C8> {
+    static const char* name() { return "CRC-16/USB"; }
+};
+
+struct Crc16Kermit : Model<uint16_t, 16, 0x1021, 0x0000, true, true, 0x0000, 0x2189> {
+    static const char* name() { return "CRC-16/KERMIT"; }
+};
+
+struct Crc16Xmodem : Model<uint16_t, 16, 0x1021, 0x0000, false, false, 0x0000, 0x31C3> {
+    static const char* name() { return "CRC-16/XMODEM"; }
+};
+
+/// @brief CRC-16/IBM-SDLC, also known as CRC-16/X-25
+struct Crc16IbmSdlc : Model<uint16_t, 16, 0x1021, 0xFFFF, true, true, 0xFFFF, 0x906E> {
+    static const char* name() { return "CRC-16/IBM-SDLC"; }
+};
+
+struct Crc16Genibus : Model<uint16_t, 16, 0x1021, 0xFFFF, false, false, 0xFFFF, 0xD64E> {
+    static const char* name() { return "CRC-16/GENIBUS"; }
+};
+
+struct Crc24OpenPgp : Model<uint32_t, 24, 0x864CFB, 0xB704CE, false, false, 0x000000, 0x21CF02> {
+    static const char* name() { return "CRC-24/OPENPGP"; }
+};
+
+struct Crc32Bzip2 : Model<uint32_t, 32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF, 0xFC891918> {
+    static const char* name() { return "CRC-32/BZIP2"; }
+};
+
+struct Crc32Mpeg2 : Model<uint32_t, 32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0x00000000, 0x0376E6E7> {
+    static const char* name() { return "CRC-32/MPEG-2"; }
+};
+
+/// @brief POSIX cksum without the length suffix
+struct Crc32Cksum : Model<uint32_t, 32, 0x04C11DB7, 0x00000000, false, false, 0xFFFFFFFF, 0x765E7680> {
+    static const char* name() { return "CRC-32/CKSUM"; }
+};
+
+struct Crc32Jamcrc : Model<uint32_t, 32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0x00000000, 0x340BC6D9> {
+    static const char* name() { return "CRC-32/JAMCRC"; }
+};
+
+struct Crc32Autosar : Model<uint32_t, 32, 0xF4ACFB13, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0x1697D06A> {
+    static const char* name() { return "CRC-32/AUTOSAR"; }
+};
+
+struct Crc64Xz : Model<uint64_t, 64, 0x42F0E1EBA9EA3693ULL, ~0ULL, true, true, ~0ULL, 0x995DC9BBDF1939FAULL> {
+    static const char* name() { return "CRC-64/XZ"; }
+};
+
+struct Crc64GoIso : Model<uint64_t, 64, 0x1B, ~0ULL, true, true, ~0ULL, 0xB90956C775A41001ULL> {
+    static const char* name() { return "CRC-64/GO-ISO"; }
+};
+
+struct Crc64We : Model<uint64_t, 64, 0x42F0E1EBA9EA3693ULL, ~0ULL, false, false, ~0ULL, 0x62EC59E3F1A4F00AULL> {
+    static const char* name() { return "CRC-64/WE"; }
+};
+
+struct Crc64Nvme : Model<uint64_t, 64, 0xAD93D23594C93659ULL, ~0ULL, true, true, ~0ULL, 0xAE8B14860A799888ULL> {
+    static const char* name() { return "CRC-64/NVME"; }
+};
+
+} // namespace crc
+} // namespace impl
+} // namespace core
+
+#endif // CRC_CATALOGUE_H
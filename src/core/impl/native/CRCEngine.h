@@ -0,0 +1,330 @@
+#ifndef CRC_ENGINE_H
+#define CRC_ENGINE_H
+
+#include "CRCKernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace core {
+namespace impl {
+namespace crc {
+
+/**
+ * @brief Compile-time CRC engine for any CRC of the Rocksoft parameter model.
+ *
+ * A Model names the register type and the usual catalogue parameters:
+ * width, polynomial (MSB-first, without the x^width term), initial value,
+ * input and output reflection, final XOR, and the check value, the CRC of
+ * "123456789". Engine<Model> checks the check value with a static_assert and
+ * builds its slicing tables (16 slices up to 32 bits, 8 above) and its fold
+ * constants as constexpr data, so every instantiation shares one read-only
+ * copy and nothing is computed at start-up.
+ *
+ * The register is kept in the input bit order: reflected CRCs shift right
+ * from bit 0, MSB-first CRCs keep it in the low width bits. update() folds
+ * inputs of MIN_FOLD_LEN bytes and more with the carry-less multiply kernel
+ * of CRCKernels.h and finishes with the tables. A Model may provide a static
+ * kernel() with the signature of update() (CRC-32C: the crc32c instruction)
+ * to be used instead.
+ *
+ * Usage:
+ *   struct Crc16Xmodem : Model<uint16_t, 16, 0x1021, 0x0000, false, false, 0x0000, 0x31C3> {
+ *       static const char* name() { return "CRC-16/XMODEM"; }
+ *   };
+ *   uint16_t reg = Engine<Crc16Xmodem>::INIT;
+ *   reg = Engine<Crc16Xmodem>::update(reg, data, length);
+ *   uint16_t crc = Engine<Crc16Xmodem>::finalize(reg);
+ */
+template<typename Word, unsigned Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut,
+         uint64_t XorOut, uint64_t Check>
+struct Model {
+    using Register = Word;
+    static constexpr unsigned WIDTH = Width;
+    static constexpr uint64_t POLY = Poly;
+    static constexpr uint64_t INIT = Init;
+    static constexpr bool REF_IN = RefIn;
+    static constexpr bool REF_OUT = RefOut;
+    static constexpr uint64_t XOR_OUT = XorOut;
+    static constexpr uint64_t CHECK = Check;
+};
+
+// ============================================================================
+// Polynomial Arithmetic
+// ============================================================================
+
+constexpr uint64_t widthMask(unsigned width) {
+    return width == 64 ? ~0ULL : (1ULL << width) - 1;
+}
+
+/// @return The low width bits of x in reverse order
+constexpr uint64_t reflect(uint64_t x, unsigned width) {
+    uint64_t result = 0;
+    for (unsigned i = 0; i < width; i++) {
+        result = (result << 1) | (x & 1);
+        x >>= 1;
+    }
+    return result;
+}
+
+constexpr uint64_t reverseBits(uint64_t x) {
+    return reflect(x, 64);
+}
+
+/// @return x^n mod P for P = x^width + poly, bit k holding the coefficient of x^k
+constexpr uint64_t xPowMod(size_t n, uint64_t poly, unsigned width) {
+    const uint64_t top = 1ULL << (width - 1);
+    const uint64_t mask = widthMask(width);
+    uint64_t result = 1;
+    for (size_t i = 0; i < n; i++) {
+        const bool carry = (result & top) != 0;
+        result = (result << 1) & mask;
+        if (carry) {
+            result ^= poly;
+        }
+    }
+    return result;
+}
+
+/// @brief Multipliers moving a block distance bits forward
+///
+/// MSB-first: the high half (first 8 bytes after byte reversal) is x^64
+/// above the low one. LSB-first blocks are bit-reversed polynomials whose
+/// low half comes first, and a carry-less product of bit-reversed values
+/// comes out one bit too high, hence the exponents one lower.
+constexpr void foldPair(uint64_t out[2], size_t distance, uint64_t poly, unsigned width, bool reflected) {
+    if (reflected) {
+        out[0] = reverseBits(xPowMod(distance + 64 - 1, poly, width));
+        out[1] = reverseBits(xPowMod(distance - 1, poly, width));
+    } else {
+        out[0] = xPowMod(distance, poly, width);
+        out[1] = xPowMod(distance + 64, poly, width);
+    }
+}
+
+constexpr FoldConstants buildFoldConstants(uint64_t poly, unsigned width, bool reflected) {
+    FoldConstants k{};
+    k.reflected = reflected;
+    foldPair(k.k128, 128, poly, width, reflected);
+    foldPair(k.k256, 256, poly, width, reflected);
+    foldPair(k.k384, 384, poly, width, reflected);
+    foldPair(k.k512, 512, poly, width, reflected);
+    foldPair(k.k1024, 1024, poly, width, reflected);
+    foldPair(k.k1536, 1536, poly, width, reflected);
+    foldPair(k.k2048, 2048, poly, width, reflected);
+    return k;
+}
+
+// ============================================================================
+// Tables
+// ============================================================================
+
+/// @brief slicing[k][n]: register after byte n and k zero bytes, from zero
+template<typename Word, size_t Slices>
+struct SlicingTables {
+    Word slicing[Slices][256] = {};
+};
+
+/// @brief Polynomial in the register's bit order
+template<typename M>
+constexpr uint64_t registerPoly = M::REF_IN ? reflect(M::POLY, M::WIDTH) : M::POLY;
+
+/// @return Register after one message bit has been shifted through reg
+template<typename M>
+constexpr uint64_t shiftBit(uint64_t reg) {
+    if (M::REF_IN) {
+        return (reg & 1) ? (reg >> 1) ^ registerPoly<M> : reg >> 1;
+    }
+    const bool carry = ((reg >> (M::WIDTH - 1)) & 1) != 0;
+    reg = (reg << 1) & widthMask(M::WIDTH);
+    return carry ? reg ^ registerPoly<M> : reg;
+}
+
+template<typename M>
+constexpr uint64_t shiftByte(uint64_t reg, uint8_t byte) {
+    reg ^= M::REF_IN ? byte : static_cast<uint64_t>(byte) << (M::WIDTH - 8);
+    for (int i = 0; i < 8; i++) {
+        reg = shiftBit<M>(reg);
+    }
+    return reg;
+}
+
+template<typename M, size_t Slices>
+constexpr SlicingTables<typename M::Register, Slices> buildSlicingTables() {
+    using Word = typename M::Register;
+    SlicingTables<Word, Slices> tables{};
+    for (unsigned n = 0; n < 256; n++) {
+        tables.slicing[0][n] = static_cast<Word>(shiftByte<M>(0, static_cast<uint8_t>(n)));
+    }
+    // One more zero byte per slice, by table lookup to keep compile-time evaluation short
+    for (size_t k = 1; k < Slices; k++) {
+        for (unsigned n = 0; n < 256; n++) {
+            const uint64_t reg = tables.slicing[k - 1][n];
+            const uint64_t next = M::REF_IN
+                ? (reg >> 8) ^ tables.slicing[0][reg & 0xFF]
+                : ((reg << 8) & widthMask(M::WIDTH)) ^ tables.slicing[0][(reg >> (M::WIDTH - 8)) & 0xFF];
+            tables.slicing[k][n] = static_cast<Word>(next);
+        }
+    }
+    return tables;
+}
+
+/// @brief Register to final CRC: output reflection and final XOR
+template<typename M>
+constexpr uint64_t finalizeRegister(uint64_t reg) {
+    return ((M::REF_OUT != M::REF_IN ? reflect(reg, M::WIDTH) : reg) ^ M::XOR_OUT) & widthMask(M::WIDTH);
+}
+
+template<typename M>
+constexpr uint64_t initialRegister() {
+    return M::REF_IN ? reflect(M::INIT, M::WIDTH) : M::INIT & widthMask(M::WIDTH);
+}
+
+/// @return CRC of "123456789" computed bit by bit, to check the model and the engine
+template<typename M>
+constexpr uint64_t checkValue() {
+    const char message[] = "123456789";
+    uint64_t reg = initialRegister<M>();
+    for (size_t i = 0; i < 9; i++) {
+        reg = shiftByte<M>(reg, static_cast<uint8_t>(message[i]));
+    }
+    return finalizeRegister<M>(reg);
+}
+
+/// @brief Detects models with a static kernel(Register, const uint8_t*, size_t) (CRC-32C)
+template<typename M, typename = void>
+struct HasKernel : std::false_type {};
+
+template<typename M>
+struct HasKernel<M, decltype(
+    M::kernel(std::declval<typename M::Register>(), std::declval<const uint8_t*>(), size_t()),
+    void())> : std::true_type {};
+
+// ============================================================================
+// Engine
+// ============================================================================
+
+template<typename M>
+struct Engine {
+    using Word = typename M::Register;
+
+    static_assert(M::WIDTH >= 8 && M::WIDTH <= 64 && M::WIDTH % 8 == 0,
+                  "CRC width must be a whole number of bytes up to 64 bits");
+    static_assert(M::WIDTH <= 8 * sizeof(Word), "CRC register type too narrow");
+    static_assert(checkValue<M>() == M::CHECK, "CRC model does not reproduce its check value");
+
+    /// @brief Bytes consumed per table step
+    static constexpr size_t SLICES = M::WIDTH <= 32 ? 16 : 8;
+
+    static constexpr Word INIT = static_cast<Word>(initialRegister<M>());
+    static constexpr Polynomial POLYNOMIAL = {M::POLY, M::WIDTH, M::REF_IN};
+    static constexpr SlicingTables<Word, SLICES> TABLES = buildSlicingTables<M, SLICES>();
+    static constexpr FoldConstants FOLD = buildFoldConstants(M::POLY, M::WIDTH, M::REF_IN);
+
+    /// @brief Feed data through the register with the tables only
+    static Word slicing(Word crc, const uint8_t* data, size_t length) {
+        const Word (*t)[256] = TABLES.slicing;
+        uint64_t reg = crc;
+        while (length >= SLICES) {
+            // The register overlaps the first bytes of the step
+            const uint64_t first = load(data) ^ (M::REF_IN ? reg : reg << (64 - M::WIDTH));
+            if constexpr (SLICES == 16) {
+                reg = lookup8<8>(t, first) ^ lookup8<0>(t, load(data + 8));
+            } else {
+                reg = lookup8<0>(t, first);
+            }
+            data += SLICES;
+            length -= SLICES;
+        }
+        while (length > 0) {
+            if (M::REF_IN) {
+                reg = (reg >> 8) ^ t[0][(reg ^ *data) & 0xFF];
+            } else {
+                reg = ((reg << 8) & widthMask(M::WIDTH)) ^ t[0][((reg >> (M::WIDTH - 8)) ^ *data) & 0xFF];
+            }
+            data++;
+            length--;
+        }
+        return static_cast<Word>(reg);
+    }
+
+    /// @brief Feed data through the register with the fastest code for this CPU
+    static Word update(Word crc, const uint8_t* data, size_t length) {
+        if constexpr (HasKernel<M>::value) {
+            return M::kernel(crc, data, length);
+        } else {
+            const FoldFn fold = foldKernel();
+            if (fold != nullptr && length >= MIN_FOLD_LEN) {
+                // The register enters as the first message bytes
+                uint8_t seed[16] = {};
+                for (size_t i = 0; i < M::WIDTH / 8; i++) {
+                    seed[i] = static_cast<uint8_t>(M::REF_IN ? crc >> (8 * i) : crc >> (M::WIDTH - 8 - 8 * i));
+                }
+                uint8_t folded[16];
+                const size_t body = length & ~static_cast<size_t>(15);
+                fold(FOLD, seed, data, body, folded);
+                crc = slicing(0, folded, sizeof(folded));
+                data += body;
+                length -= body;
+            }
+            return slicing(crc, data, length);
+        }
+    }
+
+    /// @brief update() on a register widened to 64 bits, for updateParallel()
+    static uint64_t updateWide(uint64_t crc, const uint8_t* data, size_t length) {
+        return update(static_cast<Word>(crc), data, length);
+    }
+
+    static Word finalize(Word reg) {
+        return static_cast<Word>(finalizeRegister<M>(reg));
+    }
+
+    /// @brief Final CRC back to its register (undoes finalize())
+    static Word unfinalize(Word crc) {
+        const uint64_t reg = (crc ^ M::XOR_OUT) & widthMask(M::WIDTH);
+        return static_cast<Word>(M::REF_OUT != M::REF_IN ? reflect(reg, M::WIDTH) : reg);
+    }
+
+    /// @return Final CRC of A followed by B
+    static Word combine(Word crcA, Word crcB, uint64_t lengthB) {
+        return finalize(static_cast<Word>(crc::combine(POLYNOMIAL, INIT, 0, unfinalize(crcA),
+                                                       unfinalize(crcB), lengthB)));
+    }
+
+private:
+    /// @brief Eight message bytes, the first one where the register's next byte is
+    static uint64_t load(const uint8_t* p) {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));  // Little-endian targets
+        if (!M::REF_IN) {
+            value = (value >> 56) | ((value >> 40) & 0xFF00) | ((value >> 24) & 0xFF0000) |
+                    ((value >> 8) & 0xFF000000) | ((value << 8) & 0xFF00000000ULL) |
+                    ((value << 24) & 0xFF0000000000ULL) | ((value << 40) & 0xFF000000000000ULL) |
+                    (value << 56);
+        }
+        return value;
+    }
+
+    /// @return Message byte I of a load()ed word
+    template<size_t I>
+    static size_t byteAt(uint64_t value) {
+        return static_cast<size_t>(value >> (M::REF_IN ? 8 * I : 56 - 8 * I)) & 0xFF;
+    }
+
+    /// @brief Eight bytes through slices Base + 7 (first byte) down to Base (last byte)
+    template<size_t Base>
+    static uint64_t lookup8(const Word (*t)[256], uint64_t value) {
+        return t[Base + 7][byteAt<0>(value)] ^ t[Base + 6][byteAt<1>(value)] ^
+               t[Base + 5][byteAt<2>(value)] ^ t[Base + 4][byteAt<3>(value)] ^
+               t[Base + 3][byteAt<4>(value)] ^ t[Base + 2][byteAt<5>(value)] ^
+               t[Base + 1][byteAt<6>(value)] ^ t[Base][byteAt<7>(value)];
+    }
+};
+
+} // namespace crc
+} // namespace impl
+} // namespace core
+
+#endif // CRC_ENGINE_H
@@ -0,0 +1,243 @@
+#include "CRCKernels.h"
+#include "CRCCatalogue.h"
+#include "../../ThreadPool.h"
+
+namespace core {
+namespace impl {
+namespace crc {
+
+namespace {
+
+// Reflected CRC-32C polynomial
+constexpr uint32_t CRC32C_POLY = 0x82F63B78;
+
+// ============================================================================
+// Tables
+// ============================================================================
+
+struct Crc32cTables {
+    uint32_t zerosLong[4][256];  // Shift by CRC32C_LONG zero bytes, one table per register byte
+    uint32_t zerosShort[4][256]; // Shift by CRC32C_SHORT zero bytes
+};
+
+/// @brief Multiply a GF(2) 32x32 matrix by a vector
+uint32_t gf2MatrixTimes(const uint32_t* matrix, uint32_t vector) {
+    uint32_t sum = 0;
+    while (vector != 0) {
+        if (vector & 1) {
+            sum ^= *matrix;
+        }
+        vector >>= 1;
+        matrix++;
+    }
+    return sum;
+}
+
+void gf2MatrixSquare(uint32_t square[32], const uint32_t matrix[32]) {
+    for (size_t n = 0; n < 32; n++) {
+        square[n] = gf2MatrixTimes(matrix, matrix[n]);
+    }
+}
+
+/// @brief Operator that feeds length zero bytes (length > 0) through the register
+void zerosOperator(uint32_t result[32], size_t length) {
+    uint32_t odd[32];
+    uint32_t even[32];
+
+    // One zero bit
+    odd[0] = CRC32C_POLY;
+    uint32_t row = 1;
+    for (size_t n = 1; n < 32; n++) {
+        odd[n] = row;
+        row <<= 1;
+    }
+    gf2MatrixSquare(even, odd); // Two zero bits
+    gf2MatrixSquare(odd, even); // Four zero bits
+
+    // Square up to one zero byte, then multiply in the powers of two set in length
+    bool first = true;
+    uint32_t* current = odd;
+    uint32_t* next = even;
+    while (length != 0) {
+        gf2MatrixSquare(next, current);
+        uint32_t* swap = current;
+        current = next;
+        next = swap;
+        if (length & 1) {
+            if (first) {
+                for (size_t n = 0; n < 32; n++) {
+                    result[n] = current[n];
+                }
+                first = false;
+            } else {
+                uint32_t product[32];
+                for (size_t n = 0; n < 32; n++) {
+                    product[n] = gf2MatrixTimes(current, result[n]);
+                }
+                for (size_t n = 0; n < 32; n++) {
+                    result[n] = product[n];
+                }
+            }
+        }
+        length >>= 1;
+    }
+}
+
+void buildZerosTable(uint32_t table[4][256], size_t length) {
+    uint32_t op[32];
+    zerosOperator(op, length);
+    for (uint32_t n = 0; n < 256; n++) {
+        table[0][n] = gf2MatrixTimes(op, n);
+        table[1][n] = gf2MatrixTimes(op, n << 8);
+        table[2][n] = gf2MatrixTimes(op, n << 16);
+        table[3][n] = gf2MatrixTimes(op, n << 24);
+    }
+}
+
+Crc32cTables buildTables() {
+    Crc32cTables tables;
+    buildZerosTable(tables.zerosLong, CRC32C_LONG);
+    buildZerosTable(tables.zerosShort, CRC32C_SHORT);
+    return tables;
+}
+
+const Crc32cTables& tables() {
+    static const Crc32cTables instance = buildTables();
+    return instance;
+}
+
+// ============================================================================
+// Zero Runs
+// ============================================================================
+
+/// @return a * b mod P for polynomials of degree below width, MSB-first
+uint64_t mulMod(uint64_t a, uint64_t b, const Polynomial& poly) {
+    const uint64_t top = 1ULL << (poly.width - 1);
+    const uint64_t mask = widthMask(poly.width);
+    uint64_t result = 0;
+    for (unsigned i = poly.width; i-- > 0;) {
+        const bool carry = (result & top) != 0;
+        result = (result << 1) & mask;
+        if (carry) {
+            result ^= poly.normal;
+        }
+        if ((b >> i) & 1) {
+            result ^= a;
+        }
+    }
+    return result;
+}
+
+/// @brief Convert between a register and its MSB-first polynomial (an involution)
+uint64_t toPolynomial(const Polynomial& poly, uint64_t crc) {
+    return poly.reflected ? reflect(crc, poly.width) : crc & widthMask(poly.width);
+}
+
+inline uint32_t shift(const uint32_t table[4][256], uint32_t crc) {
+    return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^
+           table[2][(crc >> 16) & 0xFF] ^ table[3][crc >> 24];
+}
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+using Crc32cFn = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+Crc32cFn selectCrc32c() {
+#if defined(HASHCALC_X86)
+    if (CpuFeatures::get().sse42) {
+        return crc32cSse42;
+    }
+#endif
+#if defined(HASHCALC_ARM64)
+    if (CpuFeatures::get().armCrc32) {
+        return crc32cArm64;
+    }
+#endif
+    return crc32cSlicing;
+}
+
+/// @return Best folding kernel, nullptr to use the tables only
+FoldFn selectFold() {
+#if defined(HASHCALC_X86)
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (cpu.vpclmulqdq && cpu.avx512f && cpu.avx512bw) {
+        return foldAvx512;
+    }
+    if (cpu.pclmul && cpu.ssse3) {
+        return foldPclmul;
+    }
+#endif
+#if defined(HASHCALC_ARM64)
+    if (CpuFeatures::get().armPmull) {
+        return foldPmull;
+    }
+#endif
+    return nullptr;
+}
+
+} // namespace
+
+FoldFn foldKernel() {
+    static const FoldFn kernel = selectFold();
+    return kernel;
+}
+
+uint32_t crc32c(uint32_t crc, const uint8_t* data, size_t length) {
+    static const Crc32cFn kernel = selectCrc32c();
+    return kernel(crc, data, length);
+}
+
+uint64_t shiftZeros(const Polynomial& poly, uint64_t crc, uint64_t length) {
+    // Square-and-multiply over the bits of length, starting from x^8 (one byte)
+    uint64_t value = toPolynomial(poly, crc);
+    uint64_t power = xPowMod(8, poly.normal, poly.width);
+    while (length != 0) {
+        if (length & 1) {
+            value = mulMod(value, power, poly);
+        }
+        power = mulMod(power, power, poly);
+        length >>= 1;
+    }
+    return toPolynomial(poly, value);
+}
+
+uint64_t combine(const Polynomial& poly, uint64_t init, uint64_t xorOut, uint64_t crcA, uint64_t crcB,
+                 uint64_t lengthB) {
+    // crcB started from init rather than from A's register; the difference is
+    // (A's register ^ init) moved across B, and xorOut cancels on both sides
+    return shiftZeros(poly, crcA ^ xorOut ^ init, lengthB) ^ crcB;
+}
+
+uint64_t updateParallel(const Polynomial& poly, UpdateFn update, uint64_t crc, const uint8_t* data,
+                        size_t length, ThreadPool* pool) {
+    if (pool == nullptr || length < 2 * MIN_PARALLEL_LEN) {
+        return update(crc, data, length);
+    }
+
+    // The right half starts from a zero register; keep the split on a cache line
+    const size_t leftLen = (length / 2) & ~static_cast<size_t>(63);
+    const size_t rightLen = length - leftLen;
+    uint64_t left = 0;
+    uint64_t right = 0;
+    pool->join([&]() { left = updateParallel(poly, update, crc, data, leftLen, pool); },
+               [&]() { right = updateParallel(poly, update, 0, data + leftLen, rightLen, pool); });
+    return shiftZeros(poly, left, rightLen) ^ right;
+}
+
+uint32_t crc32cShiftLong(uint32_t crc) {
+    return shift(tables().zerosLong, crc);
+}
+
+uint32_t crc32cShiftShort(uint32_t crc) {
+    return shift(tables().zerosShort, crc);
+}
+
+uint32_t crc32cSlicing(uint32_t crc, const uint8_t* data, size_t length) {
+    return Engine<Crc32c>::slicing(crc, data, length);
+}
+
+} // namespace crc
+} // namespace impl
+} // namespace core
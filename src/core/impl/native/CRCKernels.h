@@ -0,0 +1,136 @@
+#ifndef CRC_KERNELS_H
+#define CRC_KERNELS_H
+
+#include "../../CpuFeatures.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+
+class ThreadPool;
+
+namespace impl {
+namespace crc {
+
+/**
+ * @brief CRC kernels shared by the CRC engine (CRCEngine.h).
+ *
+ * Every function works on the raw CRC register: the caller applies the
+ * initial value and final XOR. crc32c() picks the fastest kernel the CPU
+ * supports on every call: the SSE4.2 or ARMv8 crc32c instructions, or
+ * slicing tables.
+ *
+ * The fold kernels reduce any CRC of up to 64 bits with carry-less
+ * multiplication (VPCLMULQDQ on AVX-512, PCLMULQDQ, or ARMv8 PMULL): each
+ * 128-bit block is multiplied by x^D mod P to move it D bits forward, where
+ * it is XORed into the data. The 16 bytes left at the end have the same CRC
+ * as the whole input and are finished with the engine's tables.
+ *
+ * The crc32c instructions take 8 bytes at a time but have a latency of three
+ * cycles, so the hardware kernels run three independent CRCs over adjacent
+ * thirds of each large block and merge them with crc32cShiftLong() and
+ * crc32cShiftShort(), which move a register across a fixed run of zero
+ * bytes using four table lookups.
+ *
+ * Feeding n zero bytes multiplies the register by x^(8n) mod P, so
+ * shiftZeros() skips any run of zeros in O(log n) and combine() joins the
+ * CRCs of two adjacent pieces. updateParallel() builds on that: it hashes
+ * the halves of a large input on a ThreadPool from a zero register and
+ * merges them into exactly the sequential result.
+ */
+
+/// @brief Stream lengths of the three-way interleaved hardware kernels
+constexpr size_t CRC32C_LONG = 8192;
+constexpr size_t CRC32C_SHORT = 256;
+
+/// @brief Inputs shorter than this are not worth folding
+constexpr size_t MIN_FOLD_LEN = 64;
+
+/// @brief Inputs shorter than this are not split across threads by updateParallel()
+constexpr size_t MIN_PARALLEL_LEN = 1024 * 1024;
+
+/// @brief Generator polynomial and bit order of a CRC
+struct Polynomial {
+    uint64_t normal;  ///< Generator without the x^width term, MSB-first
+    unsigned width;   ///< Register width in bits, 8 to 64
+    bool reflected;   ///< LSB-first register (bit 0 holds the highest power)
+};
+
+/// @brief Update function of one CRC on a register widened to 64 bits
+using UpdateFn = uint64_t (*)(uint64_t crc, const uint8_t* data, size_t length);
+
+/// @brief Constants that fold 128-bit blocks forward by a fixed distance
+///
+/// Each pair holds the multipliers for the low and the high 64 bits of a
+/// block as loaded by the kernel (byte-reversed first for MSB-first CRCs).
+struct FoldConstants {
+    bool reflected;       ///< LSB-first CRC; blocks are used in memory order
+    uint64_t k128[2];     ///< Fold by one block
+    uint64_t k256[2];
+    uint64_t k384[2];
+    uint64_t k512[2];     ///< Fold by four blocks (one 128-bit kernel step)
+    uint64_t k1024[2];
+    uint64_t k1536[2];
+    uint64_t k2048[2];    ///< Fold by sixteen blocks (one AVX-512 kernel step)
+};
+
+/// @brief Update a reflected CRC-32C register (polynomial 0x82F63B78)
+uint32_t crc32c(uint32_t crc, const uint8_t* data, size_t length);
+
+/// @return The register after crc is followed by length zero bytes, in O(log length)
+uint64_t shiftZeros(const Polynomial& poly, uint64_t crc, uint64_t length);
+
+/// @brief CRC of a message A followed by a message B
+/// @param init Initial register value of the CRC
+/// @param xorOut Final XOR of the CRC
+/// @param crcA Final CRC of A
+/// @param crcB Final CRC of B
+/// @param lengthB Length of B in bytes
+/// @return Final CRC of A followed by B
+uint64_t combine(const Polynomial& poly, uint64_t init, uint64_t xorOut, uint64_t crcA, uint64_t crcB,
+                 uint64_t lengthB);
+
+/// @brief Run update over data, hashing the halves of inputs of MIN_PARALLEL_LEN
+///        bytes and more on pool's workers and merging them with shiftZeros()
+/// @param pool Workers to share the input with, nullptr to update on the calling thread
+uint64_t updateParallel(const Polynomial& poly, UpdateFn update, uint64_t crc, const uint8_t* data,
+                        size_t length, ThreadPool* pool);
+
+/// @return The register after crc is followed by CRC32C_LONG zero bytes
+uint32_t crc32cShiftLong(uint32_t crc);
+
+/// @return The register after crc is followed by CRC32C_SHORT zero bytes
+uint32_t crc32cShiftShort(uint32_t crc);
+
+// Portable and instruction set specific kernels, chosen by the functions above
+
+uint32_t crc32cSlicing(uint32_t crc, const uint8_t* data, size_t length);
+
+/// @brief Fold data down to one 16-byte block with the same CRC from a zero register
+/// @param seed Incoming register in message byte order, XORed into the first block
+/// @param length Multiple of 16, at least MIN_FOLD_LEN
+using FoldFn = void (*)(const FoldConstants& k, const uint8_t seed[16], const uint8_t* data,
+                        size_t length, uint8_t out[16]);
+
+/// @return Best folding kernel for this CPU, nullptr if there is none
+FoldFn foldKernel();
+
+#if defined(HASHCALC_X86)
+uint32_t crc32cSse42(uint32_t crc, const uint8_t* data, size_t length);
+void foldPclmul(const FoldConstants& k, const uint8_t seed[16], const uint8_t* data, size_t length,
+                uint8_t out[16]);
+void foldAvx512(const FoldConstants& k, const uint8_t seed[16], const uint8_t* data, size_t length,
+                uint8_t out[16]);
+#endif
+
+#if defined(HASHCALC_ARM64)
+uint32_t crc32cArm64(uint32_t crc, const uint8_t* data, size_t length);
+void foldPmull(const FoldConstants& k, const uint8_t seed[16], const uint8_t* data, size_t length,
+               uint8_t out[16]);
+#endif
+
+} // namespace crc
+} // namespace impl
+} // namespace core
+
+#endif // CRC_KERNELS_H
@@ -0,0 +1,79 @@
+#include "CRCKernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <immintrin.h>
+
+namespace core {
+namespace impl {
+namespace crc {
+
+namespace {
+
+#define PCLMUL HASHCALC_TARGET("pclmul,ssse3")
+
+/// @brief Multiply both halves of x by their constants: x moved forward by the fold distance
+PCLMUL inline __m128i fold(__m128i x, __m128i k) {
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+PCLMUL inline __m128i loadConstants(const uint64_t k[2]) {
+    return _mm_set_epi64x(static_cast<long long>(k[1]), static_cast<long long>(k[0]));
+}
+
+/// @brief Reverses the bytes of a block so that MSB-first CRCs see x^127 in the top bit
+PCLMUL inline __m128i byteReverse() {
+    return _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+}
+
+PCLMUL inline __m128i orderBlock(__m128i x, bool reflected) {
+    return reflected ? x : _mm_shuffle_epi8(x, byteReverse());
+}
+
+PCLMUL inline __m128i loadBlock(const uint8_t* p, bool reflected) {
+    return orderBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), reflected);
+}
+
+} // namespace
+
+PCLMUL void foldPclmul(const FoldConstants& k, const uint8_t seed[16], const uint8_t* data, size_t length,
+                       uint8_t out[16]) {
+    const bool reflected = k.reflected;
+    const __m128i first = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)),
+                                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(seed)));
+
+    // Four blocks in flight hide the multiplier latency
+    __m128i x0 = orderBlock(first, reflected);
+    __m128i x1 = loadBlock(data + 16, reflected);
+    __m128i x2 = loadBlock(data + 32, reflected);
+    __m128i x3 = loadBlock(data + 48, reflected);
+    size_t position = 64;
+
+    const __m128i k512 = loadConstants(k.k512);
+    while (length - position >= 64) {
+        x0 = _mm_xor_si128(fold(x0, k512), loadBlock(data + position, reflected));
+        x1 = _mm_xor_si128(fold(x1, k512), loadBlock(data + position + 16, reflected));
+        x2 = _mm_xor_si128(fold(x2, k512), loadBlock(data + position + 32, reflected));
+        x3 = _mm_xor_si128(fold(x3, k512), loadBlock(data + position + 48, reflected));
+        position += 64;
+    }
+
+    // Merge the four into the last, then fold in any remaining blocks one at a time
+    const __m128i k128 = loadConstants(k.k128);
+    __m128i x = _mm_xor_si128(_mm_xor_si128(fold(x0, loadConstants(k.k384)), fold(x1, loadConstants(k.k256))),
+                              _mm_xor_si128(fold(x2, k128), x3));
+    while (position < length) {
+        x = _mm_xor_si128(fold(x, k128), loadBlock(data + position, reflected));
+        position += 16;
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), orderBlock(x, reflected));
+}
+
+#undef PCLMUL
+
+} // namespace crc
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
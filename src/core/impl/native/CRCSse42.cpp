@@ -0,0 +1,82 @@
+#include "CRCKernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <nmmintrin.h>
+#include <cstring>
+
+namespace core {
+namespace impl {
+namespace crc {
+
+namespace {
+
+#define SSE42 HASHCALC_TARGET("sse4.2")
+
+#if defined(_M_X64) || defined(__x86_64__)
+
+SSE42 inline uint64_t load64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/// @brief Hash blocks of three streams of streamLen bytes while they last
+SSE42 inline uint64_t crc3Way(uint64_t crc0, const uint8_t*& data, size_t& length, size_t streamLen,
+                              uint32_t (*shiftStream)(uint32_t)) {
+    while (length >= 3 * streamLen) {
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+        for (size_t i = 0; i < streamLen; i += 8) {
+            crc0 = _mm_crc32_u64(crc0, load64(data + i));
+            crc1 = _mm_crc32_u64(crc1, load64(data + streamLen + i));
+            crc2 = _mm_crc32_u64(crc2, load64(data + 2 * streamLen + i));
+        }
+        crc0 = shiftStream(static_cast<uint32_t>(crc0)) ^ crc1;
+        crc0 = shiftStream(static_cast<uint32_t>(crc0)) ^ crc2;
+        data += 3 * streamLen;
+        length -= 3 * streamLen;
+    }
+    return crc0;
+}
+
+#endif
+
+} // namespace
+
+SSE42 uint32_t crc32cSse42(uint32_t crc, const uint8_t* data, size_t length) {
+#if defined(_M_X64) || defined(__x86_64__)
+    uint64_t crc0 = crc;
+    crc0 = crc3Way(crc0, data, length, CRC32C_LONG, crc32cShiftLong);
+    crc0 = crc3Way(crc0, data, length, CRC32C_SHORT, crc32cShiftShort);
+    while (length >= 8) {
+        crc0 = _mm_crc32_u64(crc0, load64(data));
+        data += 8;
+        length -= 8;
+    }
+    crc = static_cast<uint32_t>(crc0);
+#else
+    // 32-bit builds: no 64-bit crc32, and too few registers to interleave
+    while (length >= 4) {
+        uint32_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+        data += 4;
+        length -= 4;
+    }
+#endif
+    while (length > 0) {
+        crc = _mm_crc32_u8(crc, *data);
+        data++;
+        length--;
+    }
+    return crc;
+}
+
+#undef SSE42
+
+} // namespace crc
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
@@ -3,6 +3,7 @@
 #include "GOST2012Tables.h"  // Must be included before namespace to ensure visibility
 #include <algorithm>
 #include <cstring>
+#include <stdexcept>
 
 // Define alignment macro for compatibility
 #ifdef _MSC_VER
@@ -305,6 +306,26 @@ void GOST94::Restart() {
     m_totalLen = 0;
 }
 
+void GOST94::SaveState(HashStateWriter& writer) const {
+    writer.putWords(m_H, 8);
+    writer.putWords(m_S, 8);
+    writer.putU64(m_totalLen);
+    writer.putU8(static_cast<uint8_t>(m_bufferLen));
+    writer.putBytes(m_buffer, m_bufferLen);
+}
+
+void GOST94::LoadState(HashStateReader& reader) {
+    reader.getWords(m_H, 8);
+    reader.getWords(m_S, 8);
+    m_totalLen = reader.getU64();
+    m_bufferLen = reader.getU8();
+    if (m_bufferLen >= BLOCKSIZE || m_totalLen % BLOCKSIZE != m_bufferLen) {
+        throw std::invalid_argument("Invalid hash state: corrupt GOST R 34.11-94 buffer");
+    }
+    std::memset(m_buffer, 0, sizeof(m_buffer));
+    reader.getBytes(m_buffer, m_bufferLen);
+}
+
 void GOST94::Update(const CryptoPP::byte *input, size_t length) {
     const uint8_t* buf = input;
     size_t len = length;
@@ -582,6 +603,28 @@ void GOST2012<DIGEST_BITS>::Restart() {
     // else: already zeroed by memset for 512-bit
 }
 
+template<unsigned int DIGEST_BITS>
+void GOST2012<DIGEST_BITS>::SaveState(HashStateWriter& writer) const {
+    writer.putWords(m_h, 8);
+    writer.putWords(m_N, 8);
+    writer.putWords(m_Sigma, 8);
+    writer.putU8(static_cast<uint8_t>(m_bufferLen));
+    writer.putBytes(m_buffer, m_bufferLen);
+}
+
+template<unsigned int DIGEST_BITS>
+void GOST2012<DIGEST_BITS>::LoadState(HashStateReader& reader) {
+    reader.getWords(m_h, 8);
+    reader.getWords(m_N, 8);
+    reader.getWords(m_Sigma, 8);
+    m_bufferLen = reader.getU8();
+    if (m_bufferLen >= BLOCKSIZE) {
+        throw std::invalid_argument("Invalid hash state: corrupt GOST R 34.11-2012 buffer");
+    }
+    std::memset(m_buffer, 0, sizeof(m_buffer));
+    reader.getBytes(m_buffer, m_bufferLen);
+}
+
 // Process a complete 512-bit (64-byte) block
 // Matches reference implementation stage2() from gost3411-2012-core.c
 template<unsigned int DIGEST_BITS>
@@ -48,6 +48,13 @@ public:
     void TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) override;
     void Restart() override;
 
+    /// @brief Append the running state to a saved hash state (see IHashAlgorithm::saveState)
+    void SaveState(HashStateWriter& writer) const;
+
+    /// @brief Restore a state written by SaveState()
+    /// @throws std::invalid_argument if the state is inconsistent
+    void LoadState(HashStateReader& reader);
+
     // GOST 28147-89 S-boxes (standard paramset) - public for table initialization
     static const uint8_t SBOX[8][16];
 
@@ -116,6 +123,13 @@ public:
     void TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) override;
     void Restart() override;
 
+    /// @brief Append the running state to a saved hash state (see IHashAlgorithm::saveState)
+    void SaveState(HashStateWriter& writer) const;
+
+    /// @brief Restore a state written by SaveState()
+    /// @throws std::invalid_argument if the state is inconsistent
+    void LoadState(HashStateReader& reader);
+
 private:
     // Internal state (512 bits each)
     uint64_t m_h[8];         // Hash state
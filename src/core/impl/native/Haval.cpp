@@ -97,15 +97,15 @@ static const unsigned char wp5[32] = {
     27,3,21,26,17,11,20,29,19,0,12,7,13,8,31,10,5,9,14,30,18,6,28,24,2,23,16,22,4,1,25,15
 };
 
-template <unsigned int DIGEST_BITS, unsigned int PASSES>
-void Haval<DIGEST_BITS, PASSES>::Transform(const CryptoPP::byte *block) {
+template <unsigned int PASSES>
+void HavalTransform(CryptoPP::word32 *state, const CryptoPP::byte *block) {
     CryptoPP::word32 W[32];
     for (int i = 0; i < 32; ++i) {
         W[i] = CryptoPP::GetWord<CryptoPP::word32>(false, CryptoPP::LITTLE_ENDIAN_ORDER, block + i * 4);
     }
 
-    CryptoPP::word32 t0 = m_state[0], t1 = m_state[1], t2 = m_state[2], t3 = m_state[3];
-    CryptoPP::word32 t4 = m_state[4], t5 = m_state[5], t6 = m_state[6], t7 = m_state[7];
+    CryptoPP::word32 t0 = state[0], t1 = state[1], t2 = state[2], t3 = state[3];
+    CryptoPP::word32 t4 = state[4], t5 = state[5], t6 = state[6], t7 = state[7];
 
     // Pass 1 - no constants
     if (PASSES == 3) {
@@ -208,8 +208,8 @@ void Haval<DIGEST_BITS, PASSES>::Transform(const CryptoPP::byte *block) {
         #undef PASS5_ROUND
     }
 
-    m_state[0] += t0; m_state[1] += t1; m_state[2] += t2; m_state[3] += t3;
-    m_state[4] += t4; m_state[5] += t5; m_state[6] += t6; m_state[7] += t7;
+    state[0] += t0; state[1] += t1; state[2] += t2; state[3] += t3;
+    state[4] += t4; state[5] += t5; state[6] += t6; state[7] += t7;
 }
 
 template <unsigned int DIGEST_BITS, unsigned int PASSES>
@@ -239,6 +239,10 @@ void Haval<DIGEST_BITS, PASSES>::Tailor() {
     }
 }
 
+template void HavalTransform<3>(CryptoPP::word32 *state, const CryptoPP::byte *block);
+template void HavalTransform<4>(CryptoPP::word32 *state, const CryptoPP::byte *block);
+template void HavalTransform<5>(CryptoPP::word32 *state, const CryptoPP::byte *block);
+
 template class Haval<128, 3>; template class Haval<160, 3>; template class Haval<192, 3>;
 template class Haval<224, 3>; template class Haval<256, 3>;
 template class Haval<128, 4>; template class Haval<160, 4>; template class Haval<192, 4>;
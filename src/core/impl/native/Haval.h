@@ -8,16 +8,27 @@
 #include <array>
 #include <sstream>
 #include <cstring>
+#include <stdexcept>
 
 namespace core {
 namespace impl {
 
+/// @brief HAVAL compression of one 128-byte block into state; the same for
+///        every output size of a pass count
+template <unsigned int PASSES>
+void HavalTransform(CryptoPP::word32 *state, const CryptoPP::byte *block);
+
 /**
  * @brief HAVAL implementation compatible with Crypto++ HashTransformation.
  * 
  * HAVAL is a variable-length, variable-pass hash algorithm.
  * Output sizes: 128, 160, 192, 224, 256 bits.
  * Passes: 3, 4, 5.
+ *
+ * The output size only enters the final block and the tailoring of the
+ * state, so all sizes of one pass count absorb input identically and share
+ * their saved state payload (SharedStateKey()): MultiHasher hashes the data
+ * once per pass count and forks the state for every selected size.
  */
 template <unsigned int DIGEST_BITS, unsigned int PASSES>
 class Haval : public CryptoPP::HashTransformation {
@@ -39,6 +50,11 @@ public:
         return ss.str();
     }
 
+    /// @return Key shared by every output size of this pass count
+    static std::string SharedStateKey() {
+        return "HAVAL/" + std::to_string(PASSES);
+    }
+
     unsigned int DigestSize() const override { return DIGESTSIZE; }
     unsigned int BlockSize() const override { return BLOCKSIZE; }
 
@@ -135,8 +151,28 @@ public:
         m_state[7] = 0xEC4E6C89;
     }
 
+    /// @brief Append the running state to a saved hash state (see IHashAlgorithm::saveState)
+    void SaveState(HashStateWriter& writer) const {
+        writer.putWords(m_state, 8);
+        writer.putU64(m_processed);
+        writer.putU8(static_cast<uint8_t>(m_count));
+        writer.putBytes(m_buffer, m_count);
+    }
+
+    /// @brief Restore a state written by SaveState()
+    /// @throws std::invalid_argument if the state is inconsistent
+    void LoadState(HashStateReader& reader) {
+        reader.getWords(m_state, 8);
+        m_processed = reader.getU64();
+        m_count = reader.getU8();
+        if (m_count >= BLOCKSIZE || m_processed % BLOCKSIZE != 0) {
+            throw std::invalid_argument("Invalid hash state: corrupt HAVAL buffer");
+        }
+        reader.getBytes(m_buffer, m_count);
+    }
+
 private:
-    void Transform(const CryptoPP::byte *block);
+    void Transform(const CryptoPP::byte *block) { HavalTransform<PASSES>(m_state, block); }
     void Tailor();
     CryptoPP::word32 m_state[8];
     CryptoPP::byte m_buffer[BLOCKSIZE];
@@ -0,0 +1,168 @@
+#include "Keccak.h"
+#include "../../HashAlgorithmFactory.h"
+#include <algorithm>
+
+namespace core {
+namespace impl {
+
+namespace {
+
+const uint64_t ROUND_CONSTANTS[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL, 0x8000000080008000ULL,
+    0x000000000000808BULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008AULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+    0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800AULL, 0x800000008000000AULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+inline uint64_t rotl64(uint64_t x, int n) {
+    return n == 0 ? x : (x << n) | (x >> (64 - n));
+}
+
+inline uint64_t load64(const uint8_t *p) {
+    uint64_t w = 0;
+    for (int i = 7; i >= 0; i--) {
+        w = (w << 8) | p[i];
+    }
+    return w;
+}
+
+} // namespace
+
+// One plane of rho, pi and chi: the five lanes (after theta) that land in
+// plane y, in x order, with their rotations; the result goes to E##y0..E##y4
+#define KECCAK_PLANE(E, y, l0, r0, l1, r1, l2, r2, l3, r3, l4, r4)              \
+    B0 = rotl64(l0, r0);                                                        \
+    B1 = rotl64(l1, r1);                                                        \
+    B2 = rotl64(l2, r2);                                                        \
+    B3 = rotl64(l3, r3);                                                        \
+    B4 = rotl64(l4, r4);                                                        \
+    E##y##0 = B0 ^ (~B1 & B2);                                                  \
+    E##y##1 = B1 ^ (~B2 & B3);                                                  \
+    E##y##2 = B2 ^ (~B3 & B4);                                                  \
+    E##y##3 = B3 ^ (~B4 & B0);                                                  \
+    E##y##4 = B4 ^ (~B0 & B1)
+
+// One round from the lanes A00..A44 (A##yx is lane x + 5y) into E: theta,
+// then rho, pi and chi a plane at a time, then iota
+#define KECCAK_ROUND(A, E, rc)                                                  \
+    C0 = A##00 ^ A##10 ^ A##20 ^ A##30 ^ A##40;                                 \
+    C1 = A##01 ^ A##11 ^ A##21 ^ A##31 ^ A##41;                                 \
+    C2 = A##02 ^ A##12 ^ A##22 ^ A##32 ^ A##42;                                 \
+    C3 = A##03 ^ A##13 ^ A##23 ^ A##33 ^ A##43;                                 \
+    C4 = A##04 ^ A##14 ^ A##24 ^ A##34 ^ A##44;                                 \
+    D0 = C4 ^ rotl64(C1, 1);                                                    \
+    D1 = C0 ^ rotl64(C2, 1);                                                    \
+    D2 = C1 ^ rotl64(C3, 1);                                                    \
+    D3 = C2 ^ rotl64(C4, 1);                                                    \
+    D4 = C3 ^ rotl64(C0, 1);                                                    \
+    KECCAK_PLANE(E, 0, A##00 ^ D0, 0, A##11 ^ D1, 44, A##22 ^ D2, 43, A##33 ^ D3, 21, A##44 ^ D4, 14); \
+    KECCAK_PLANE(E, 1, A##03 ^ D3, 28, A##14 ^ D4, 20, A##20 ^ D0, 3, A##31 ^ D1, 45, A##42 ^ D2, 61); \
+    KECCAK_PLANE(E, 2, A##01 ^ D1, 1, A##12 ^ D2, 6, A##23 ^ D3, 25, A##34 ^ D4, 8, A##40 ^ D0, 18); \
+    KECCAK_PLANE(E, 3, A##04 ^ D4, 27, A##10 ^ D0, 36, A##21 ^ D1, 10, A##32 ^ D2, 15, A##43 ^ D3, 56); \
+    KECCAK_PLANE(E, 4, A##02 ^ D2, 62, A##13 ^ D3, 55, A##24 ^ D4, 39, A##30 ^ D0, 41, A##41 ^ D1, 2); \
+    E##00 ^= (rc)
+
+void KeccakF1600(uint64_t *state) {
+    // Two copies of the state in locals, each round reading one and writing
+    // the other, so that no lane is ever moved
+    uint64_t a00 = state[0], a01 = state[1], a02 = state[2], a03 = state[3], a04 = state[4];
+    uint64_t a10 = state[5], a11 = state[6], a12 = state[7], a13 = state[8], a14 = state[9];
+    uint64_t a20 = state[10], a21 = state[11], a22 = state[12], a23 = state[13], a24 = state[14];
+    uint64_t a30 = state[15], a31 = state[16], a32 = state[17], a33 = state[18], a34 = state[19];
+    uint64_t a40 = state[20], a41 = state[21], a42 = state[22], a43 = state[23], a44 = state[24];
+    uint64_t e00, e01, e02, e03, e04;
+    uint64_t e10, e11, e12, e13, e14;
+    uint64_t e20, e21, e22, e23, e24;
+    uint64_t e30, e31, e32, e33, e34;
+    uint64_t e40, e41, e42, e43, e44;
+    uint64_t C0, C1, C2, C3, C4, D0, D1, D2, D3, D4, B0, B1, B2, B3, B4;
+
+    for (int round = 0; round < 24; round += 2) {
+        KECCAK_ROUND(a, e, ROUND_CONSTANTS[round]);
+        KECCAK_ROUND(e, a, ROUND_CONSTANTS[round + 1]);
+    }
+
+    state[0] = a00; state[1] = a01; state[2] = a02; state[3] = a03; state[4] = a04;
+    state[5] = a10; state[6] = a11; state[7] = a12; state[8] = a13; state[9] = a14;
+    state[10] = a20; state[11] = a21; state[12] = a22; state[13] = a23; state[14] = a24;
+    state[15] = a30; state[16] = a31; state[17] = a32; state[18] = a33; state[19] = a34;
+    state[20] = a40; state[21] = a41; state[22] = a42; state[23] = a43; state[24] = a44;
+}
+
+#undef KECCAK_ROUND
+#undef KECCAK_PLANE
+
+template <unsigned int DIGEST_BITS, uint8_t PADDING>
+void Keccak<DIGEST_BITS, PADDING>::absorbBytes(const CryptoPP::byte *input, size_t length) {
+    for (size_t i = 0; i < length; i++, m_count++) {
+        m_state[m_count / 8] ^= static_cast<uint64_t>(input[i]) << (8 * (m_count % 8));
+    }
+}
+
+template <unsigned int DIGEST_BITS, uint8_t PADDING>
+void Keccak<DIGEST_BITS, PADDING>::Update(const CryptoPP::byte *input, size_t length) {
+    // Complete a partly absorbed block first
+    if (m_count > 0) {
+        size_t take = std::min(length, static_cast<size_t>(BLOCKSIZE) - m_count);
+        absorbBytes(input, take);
+        input += take;
+        length -= take;
+        if (m_count < BLOCKSIZE) {
+            return;
+        }
+        KeccakF1600(m_state);
+        m_count = 0;
+    }
+
+    // Whole blocks, a lane at a time
+    while (length >= BLOCKSIZE) {
+        for (unsigned int i = 0; i < BLOCKSIZE / 8; i++) {
+            m_state[i] ^= load64(input + 8 * i);
+        }
+        KeccakF1600(m_state);
+        input += BLOCKSIZE;
+        length -= BLOCKSIZE;
+    }
+
+    absorbBytes(input, length);
+}
+
+template <unsigned int DIGEST_BITS, uint8_t PADDING>
+void Keccak<DIGEST_BITS, PADDING>::TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) {
+    ThrowIfInvalidTruncatedSize(digestSize);
+
+    // Pad: the domain byte after the data, 0x80 in the last byte of the block
+    m_state[m_count / 8] ^= static_cast<uint64_t>(PADDING) << (8 * (m_count % 8));
+    m_state[(BLOCKSIZE - 1) / 8] ^= 0x80ULL << (8 * ((BLOCKSIZE - 1) % 8));
+    KeccakF1600(m_state);
+
+    // The digest is the start of the state, lanes little-endian
+    for (size_t i = 0; i < digestSize; i++) {
+        digest[i] = static_cast<CryptoPP::byte>(m_state[i / 8] >> (8 * (i % 8)));
+    }
+
+    Restart();
+}
+
+template class Keccak<224, SHA3_PADDING>;
+template class Keccak<256, SHA3_PADDING>;
+template class Keccak<384, SHA3_PADDING>;
+template class Keccak<512, SHA3_PADDING>;
+template class Keccak<224, KECCAK_PADDING>;
+template class Keccak<256, KECCAK_PADDING>;
+template class Keccak<384, KECCAK_PADDING>;
+template class Keccak<512, KECCAK_PADDING>;
+
+static HashAlgorithmRegistrar<KeccakWrapper<SHA3_224>> reg_sha3_224("SHA3-224");
+static HashAlgorithmRegistrar<KeccakWrapper<SHA3_256>> reg_sha3_256("SHA3-256");
+static HashAlgorithmRegistrar<KeccakWrapper<SHA3_384>> reg_sha3_384("SHA3-384");
+static HashAlgorithmRegistrar<KeccakWrapper<SHA3_512>> reg_sha3_512("SHA3-512");
+static HashAlgorithmRegistrar<KeccakWrapper<Keccak_224>> reg_keccak_224("Keccak-224");
+static HashAlgorithmRegistrar<KeccakWrapper<Keccak_256>> reg_keccak_256("Keccak-256");
+static HashAlgorithmRegistrar<KeccakWrapper<Keccak_384>> reg_keccak_384("Keccak-384");
+static HashAlgorithmRegistrar<KeccakWrapper<Keccak_512>> reg_keccak_512("Keccak-512");
+
+} // namespace impl
+} // namespace core
@@ -0,0 +1,108 @@
+#ifndef KECCAK_H
+#define KECCAK_H
+
+#include "../cryptopp/CryptoppHashBase.h"
+#include <cryptopp/cryptlib.h>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace core {
+namespace impl {
+
+/// @brief Keccak-f[1600] permutation of a 25-lane state (lane x + 5y)
+void KeccakF1600(uint64_t *state);
+
+/// @brief Domain separation byte of SHA-3 (FIPS 202)
+constexpr uint8_t SHA3_PADDING = 0x06;
+
+/// @brief Padding byte of the original Keccak submission (Ethereum's Keccak-256)
+constexpr uint8_t KECCAK_PADDING = 0x01;
+
+/**
+ * @brief SHA-3 and Keccak implementation compatible with Crypto++ HashTransformation.
+ *
+ * Both absorb input into the same sponge at a rate of 200 - 2 * digest
+ * bytes; they differ only in the first padding byte. SHA3-n and Keccak-n
+ * therefore share their saved state payload (SharedStateKey()), and
+ * MultiHasher absorbs the data once for both.
+ *
+ * Usage:
+ *   Keccak<256, SHA3_PADDING> sha3;  // SHA3-256
+ *   sha3.Update(data, len);
+ *   sha3.Final(digest);
+ */
+template <unsigned int DIGEST_BITS, uint8_t PADDING>
+class Keccak : public CryptoPP::HashTransformation {
+public:
+    CRYPTOPP_CONSTANT(DIGESTSIZE = DIGEST_BITS / 8);
+    CRYPTOPP_CONSTANT(BLOCKSIZE = 200 - 2 * DIGESTSIZE);  // sponge rate in bytes
+
+    Keccak() { Restart(); }
+
+    std::string AlgorithmName() const override { return StaticAlgorithmName(); }
+
+    static std::string StaticAlgorithmName() {
+        return (PADDING == SHA3_PADDING ? "SHA3-" : "Keccak-") + std::to_string(DIGEST_BITS);
+    }
+
+    /// @return Key shared by SHA-3 and Keccak of this rate
+    static std::string SharedStateKey() {
+        return "Keccak/" + std::to_string(BLOCKSIZE);
+    }
+
+    unsigned int DigestSize() const override { return DIGESTSIZE; }
+    unsigned int BlockSize() const override { return BLOCKSIZE; }
+
+    void Update(const CryptoPP::byte *input, size_t length) override;
+    void TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) override;
+
+    void Restart() override {
+        std::memset(m_state, 0, sizeof(m_state));
+        m_count = 0;
+    }
+
+    /// @brief Append the running state to a saved hash state (see IHashAlgorithm::saveState)
+    void SaveState(HashStateWriter& writer) const {
+        writer.putWords(m_state, 25);
+        writer.putU8(static_cast<uint8_t>(m_count));
+    }
+
+    /// @brief Restore a state written by SaveState()
+    /// @throws std::invalid_argument if the state is inconsistent
+    void LoadState(HashStateReader& reader) {
+        reader.getWords(m_state, 25);
+        m_count = reader.getU8();
+        if (m_count >= BLOCKSIZE) {
+            throw std::invalid_argument("Invalid hash state: corrupt Keccak block offset");
+        }
+    }
+
+private:
+    /// @brief XOR bytes into the state from byte offset m_count on
+    void absorbBytes(const CryptoPP::byte *input, size_t length);
+
+    uint64_t m_state[25];
+    size_t m_count;  // bytes absorbed into the current block
+};
+
+// Typedefs for registration
+using SHA3_224 = Keccak<224, SHA3_PADDING>;
+using SHA3_256 = Keccak<256, SHA3_PADDING>;
+using SHA3_384 = Keccak<384, SHA3_PADDING>;
+using SHA3_512 = Keccak<512, SHA3_PADDING>;
+
+using Keccak_224 = Keccak<224, KECCAK_PADDING>;
+using Keccak_256 = Keccak<256, KECCAK_PADDING>;
+using Keccak_384 = Keccak<384, KECCAK_PADDING>;
+using Keccak_512 = Keccak<512, KECCAK_PADDING>;
+
+// Wrapper for CryptoppHashBase interaction
+template<typename H>
+using KeccakWrapper = CryptoppHashBase<H>;
+
+} // namespace impl
+} // namespace core
+
+#endif // KECCAK_H
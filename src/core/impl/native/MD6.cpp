@@ -1,7 +1,11 @@
 #include "MD6.h"
+#include "MD6Kernels.h"
 #include "../../HashAlgorithmFactory.h"
+#include "../../ThreadPool.h"
 #include <algorithm>
 #include <cstring>
+#include <stdexcept>
+#include <vector>
 
 namespace core {
 namespace impl {
@@ -16,35 +20,71 @@ const uint64_t MD6<DIGEST_BITS>::Q[Q_SIZE] = {
     0xc878c1dd04c4b633ULL, 0x3b72066c7a1552acULL, 0x0d6f3522631effcbULL
 };
 
-template<unsigned int DIGEST_BITS>
-int MD6<DIGEST_BITS>::defaultRounds(int d) const {
-    int r = 40 + (d / 4);
-    return r;
-}
-
 template<unsigned int DIGEST_BITS>
 void MD6<DIGEST_BITS>::Restart() {
     m_d = DIGEST_BITS;
-    m_L = DEFAULT_L;
-    m_r = defaultRounds(m_d);
     m_bits_processed = 0;
     m_top = 1;
     
     // Clear key (use all zeros)
     m_K.fill(0);
     
-    // Clear state
-    for (auto& b : m_B) {
-        b.fill(0);
-    }
+    // Empty every level; their words are cleared as data arrives (see Update)
     m_bits.fill(0);
     m_i_for_level.fill(0);
     
-    // For sequential mode at level L+1, initialize with IV=0
-    // (This is handled dynamically in processBlock when needed)
+    // For sequential mode at level L+1, initialize with IV=0 (other SEQ
+    // levels get theirs in appendChainingValue)
+    if (m_L == 0) {
+        std::fill_n(m_B[1].data(), C, 0);
+        m_bits[1] = C * W;
+    }
     
-    m_hashval.resize(C * (W / 8));  // Allocate space for full C words
-    std::fill(m_hashval.begin(), m_hashval.end(), 0);
+    m_hashval.fill(0);
+}
+
+template<unsigned int DIGEST_BITS>
+void MD6<DIGEST_BITS>::SaveState(HashStateWriter& writer) const {
+    writer.putU32(static_cast<uint32_t>(m_d));
+    writer.putU32(static_cast<uint32_t>(m_L));
+    writer.putU32(static_cast<uint32_t>(m_r));
+    writer.putU64(m_bits_processed);
+    writer.putWords(m_K.data(), K_SIZE);
+    writer.putU32(static_cast<uint32_t>(m_top));
+
+    // Levels above m_top are still in their Restart() state; below it, only
+    // the words holding data are non-zero
+    for (int ell = 0; ell <= m_top; ell++) {
+        writer.putU32(m_bits[ell]);
+        writer.putU64(m_i_for_level[ell]);
+        writer.putWords(m_B[ell].data(), (m_bits[ell] + W - 1) / W);
+    }
+}
+
+template<unsigned int DIGEST_BITS>
+void MD6<DIGEST_BITS>::LoadState(HashStateReader& reader) {
+    int d = static_cast<int>(reader.getU32());
+    int L = static_cast<int>(reader.getU32());
+    int r = static_cast<int>(reader.getU32());
+    Restart();
+    if (d != m_d || L != m_L || r != m_r) {
+        throw std::invalid_argument("Invalid hash state: MD6 parameters do not match");
+    }
+
+    m_bits_processed = reader.getU64();
+    reader.getWords(m_K.data(), K_SIZE);
+    m_top = static_cast<int>(reader.getU32());
+    if (m_top < 1 || m_top >= MAX_STACK_HEIGHT || m_top > m_L + 1) {
+        throw std::invalid_argument("Invalid hash state: corrupt MD6 stack height");
+    }
+    for (int ell = 0; ell <= m_top; ell++) {
+        m_bits[ell] = reader.getU32();
+        if (m_bits[ell] > B * W) {
+            throw std::invalid_argument("Invalid hash state: corrupt MD6 level");
+        }
+        m_i_for_level[ell] = reader.getU64();
+        reader.getWords(m_B[ell].data(), (m_bits[ell] + W - 1) / W);
+    }
 }
 
 template<unsigned int DIGEST_BITS>
@@ -61,14 +101,14 @@ uint64_t MD6<DIGEST_BITS>::makeControlWord(int r, int L, int z, int p, int keyle
 }
 
 template<unsigned int DIGEST_BITS>
-uint64_t MD6<DIGEST_BITS>::makeNodeID(int ell, int i) const {
-    return (uint64_t(ell) << 56) | (uint64_t(i) & 0x00FFFFFFFFFFFFFFULL);
+uint64_t MD6<DIGEST_BITS>::makeNodeID(int ell, uint64_t i) const {
+    return (uint64_t(ell) << 56) | (i & 0x00FFFFFFFFFFFFFFULL);
 }
 
 template<unsigned int DIGEST_BITS>
 void MD6<DIGEST_BITS>::pack(uint64_t *N, const uint64_t *Q, const uint64_t *K,
-                            int ell, int i, int r, int L, int z, int p, int keylen, int d,
-                            const uint64_t *B_data) {
+                            int ell, uint64_t i, int r, int L, int z, int p, int keylen, int d,
+                            const uint64_t *B_data, int reverseFrom) const {
     int ni = 0;
     // Q part
     for (int j = 0; j < Q_SIZE; j++) {
@@ -82,105 +122,42 @@ void MD6<DIGEST_BITS>::pack(uint64_t *N, const uint64_t *Q, const uint64_t *K,
     N[ni++] = makeNodeID(ell, i);
     // Control word
     N[ni++] = makeControlWord(r, L, z, p, keylen, d);
-    // Data (B_data is the input data block, 64 is the block size)
-    for (int j = 0; j < 64; j++) {
-        N[ni++] = B_data[j];
+    // Data (B_data is the input data block, 64 is the block size): words from
+    // reverseFrom on are byte-reversed, words past the p padding bits are zero
+    const int used = (B * W - p + W - 1) / W;
+    for (int j = 0; j < used; j++) {
+        N[ni++] = j < reverseFrom ? B_data[j] : byteSwap(B_data[j]);
     }
-}
-
-template<unsigned int DIGEST_BITS>
-void MD6<DIGEST_BITS>::mainCompressionLoop(uint64_t *A, int r) {
-    // S constants for round constants
-    const uint64_t S0 = 0x0123456789abcdefULL;
-    const uint64_t Smask = 0x7311c2812425cfa0ULL;
-    
-    // Shift amounts for each step in a round
-    const int rs[16] = {10, 5, 13, 10, 11, 12, 2, 7, 14, 15, 7, 13, 11, 7, 6, 12};
-    const int ls[16] = {11, 24, 9, 16, 15, 9, 27, 15, 6, 2, 29, 8, 15, 5, 31, 9};
-    
-    uint64_t x, S = S0;
-    int i = MD6::N;  // starting position in A
-    
-    for (int j = 0; j < r * C; j++) {
-        int step = j % 16;  // step within current round
-        
-        // Compute next word
-        x = S;                                    // feedback constant
-        x ^= A[i + step - t5];                    // end-around feedback
-        x ^= A[i + step - t0];                    // linear feedback
-        x ^= (A[i + step - t1] & A[i + step - t2]); // first quadratic term
-        x ^= (A[i + step - t3] & A[i + step - t4]); // second quadratic term
-        x ^= (x >> rs[step]);                     // right shift
-        A[i + step] = x ^ (x << ls[step]);        // left shift and store
-        
-        // After each complete round (16 steps), update S and advance i
-        if (step == 15) {
-            S = (S << 1) ^ (S >> (W - 1)) ^ (S & Smask);
-            i += 16;
-        }
+    for (int j = used; j < B; j++) {
+        N[ni++] = 0;
     }
 }
 
 template<unsigned int DIGEST_BITS>
-void MD6<DIGEST_BITS>::compress(uint64_t *C_out, const uint64_t *N_input, int r) {
-    // Allocate working array: size is r*c + n
-    std::vector<uint64_t> A(r * C + MD6::N);
+void MD6<DIGEST_BITS>::compressNode(uint64_t *C_out, int ell, uint64_t i, int z, int p,
+                                    const uint64_t *B_data) const {
+    uint64_t A[md6::WINDOW_WORDS];  // compression input and working window
     
-    // Initialize A with N (first n=89 words)
-    std::memcpy(A.data(), N_input, MD6::N * sizeof(uint64_t));
-    
-    // Run main compression loop
-    mainCompressionLoop(A.data(), r);
+    // Level 1 data is read little-endian and reversed while packing, except
+    // for the chaining variables (first C words) of a SEQ node
+    int reverseFrom = B;
+    if (ell == 1) {
+        reverseFrom = (ell == m_L + 1) ? C : 0;
+    }
     
-    // Extract output: C words from position (r-1)*c + n
-    std::memcpy(C_out, A.data() + (r - 1) * C + MD6::N, C * sizeof(uint64_t));
+    // Pack the block into the front of the window and compress it
+    pack(A, Q, m_K.data(), ell, i, m_r, m_L, z, p, 0, m_d, B_data, reverseFrom);
+    md6::compress(C_out, A, m_r);
 }
 
 template<unsigned int DIGEST_BITS>
 void MD6<DIGEST_BITS>::processBlock(int ell, int final) {
-    uint64_t N[89];
     uint64_t C_out[16];
     
     int z = (final && ell == m_top) ? 1 : 0;
     int p = B * W - m_bits[ell];  // padding bits
     
-    // Determine next level to check if this is a SEQ node
-    int next_level = std::min(ell + 1, m_L + 1);
-    bool is_seq_node = (next_level == m_L + 1);
-    
-    // Reverse bytes for level 1 data (little-endian)
-    if (ell == 1) {
-        if (!is_seq_node) {  // PAR (tree) node - reverse all data
-            for (int i = 0; i < B; i++) {
-                m_B[ell][i] = ((m_B[ell][i] & 0x00000000000000FFULL) << 56) |
-                              ((m_B[ell][i] & 0x000000000000FF00ULL) << 40) |
-                              ((m_B[ell][i] & 0x0000000000FF0000ULL) << 24) |
-                              ((m_B[ell][i] & 0x00000000FF000000ULL) << 8)  |
-                              ((m_B[ell][i] & 0x000000FF00000000ULL) >> 8)  |
-                              ((m_B[ell][i] & 0x0000FF0000000000ULL) >> 24) |
-                              ((m_B[ell][i] & 0x00FF000000000000ULL) >> 40) |
-                              ((m_B[ell][i] & 0xFF00000000000000ULL) >> 56);
-            }
-        } else {  // SEQ node - don't reverse chaining vars (first C words)
-            for (int i = C; i < B; i++) {
-                m_B[ell][i] = ((m_B[ell][i] & 0x00000000000000FFULL) << 56) |
-                              ((m_B[ell][i] & 0x000000000000FF00ULL) << 40) |
-                              ((m_B[ell][i] & 0x0000000000FF0000ULL) << 24) |
-                              ((m_B[ell][i] & 0x00000000FF000000ULL) << 8)  |
-                              ((m_B[ell][i] & 0x000000FF00000000ULL) >> 8)  |
-                              ((m_B[ell][i] & 0x0000FF0000000000ULL) >> 24) |
-                              ((m_B[ell][i] & 0x00FF000000000000ULL) >> 40) |
-                              ((m_B[ell][i] & 0xFF00000000000000ULL) >> 56);
-            }
-        }
-    }
-    
-    // Pack the block
-    pack(N, Q, m_K.data(), ell, static_cast<int>(m_i_for_level[ell]),
-         m_r, m_L, z, p, 0, m_d, m_B[ell].data());
-    
-    // Compress
-    compress(C_out, N, m_r);
+    compressNode(C_out, ell, m_i_for_level[ell], z, p, m_B[ell].data());
     
     // Save final chaining value if this is the last compression
     if (z == 1) {
@@ -188,34 +165,107 @@ void MD6<DIGEST_BITS>::processBlock(int ell, int final) {
         return;
     }
     
-    // Determine next level (already calculated above for is_seq_node check)
-    // int next_level = std::min(ell + 1, m_L + 1);
-    
-    // For sequential mode (level L+1), first C words are chaining values (IV=0 initially)
-    // These were already initialized to 0 in Restart(), no special action needed
+    // Empty current level first: a SEQ node passes its chaining value to itself
+    m_bits[ell] = 0;
+    m_i_for_level[ell]++;
     
-    // Boundary check for next level
-    if (next_level >= MAX_STACK_HEIGHT) {
+    appendChainingValue(std::min(ell + 1, m_L + 1), C_out, final);
+}
+
+template<unsigned int DIGEST_BITS>
+void MD6<DIGEST_BITS>::appendChainingValue(int ell, const uint64_t *cv, int final) {
+    // Boundary check for the level
+    if (ell >= MAX_STACK_HEIGHT) {
         return;  // Safety check - should not happen with proper L value
     }
     
-    // Copy C words to next level
-    std::memcpy(reinterpret_cast<uint8_t*>(m_B[next_level].data()) + m_bits[next_level] / 8,
-                C_out, C * sizeof(uint64_t));
-    m_bits[next_level] += C * W;
+    // The first node of the SEQ level starts with an all-zero IV
+    if (ell == m_L + 1 && m_i_for_level[ell] == 0 && m_bits[ell] == 0) {
+        std::fill_n(m_B[ell].data(), C, 0);
+        m_bits[ell] = C * W;
+    }
+    
+    // Copy C words to the level
+    std::memcpy(reinterpret_cast<uint8_t*>(m_B[ell].data()) + m_bits[ell] / 8,
+                cv, C * sizeof(uint64_t));
+    m_bits[ell] += C * W;
     
-    if (next_level > m_top) {
-        m_top = next_level;
+    if (ell > m_top) {
+        m_top = ell;
     }
     
-    // Clear current level
-    m_bits[ell] = 0;
-    m_i_for_level[ell]++;
-    m_B[ell].fill(0);
+    // Recursively process the level if needed
+    if (final || m_bits[ell] >= B * W) {
+        processBlock(ell, final);
+    }
+}
+
+namespace {
+
+/// @brief Run fn(i) for every i in [begin, end), splitting the range over pool
+template<typename Fn>
+void parallelFor(ThreadPool* pool, size_t begin, size_t end, const Fn& fn) {
+    constexpr size_t GRAIN = 16;  // nodes per task
+    if (end - begin <= GRAIN) {
+        for (size_t i = begin; i < end; i++) {
+            fn(i);
+        }
+        return;
+    }
+    const size_t mid = begin + (end - begin) / 2;
+    pool->join([&]() { parallelFor(pool, begin, mid, fn); },
+               [&]() { parallelFor(pool, mid, end, fn); });
+}
+
+} // namespace
+
+template<unsigned int DIGEST_BITS>
+void MD6<DIGEST_BITS>::hashLeaves(const uint8_t *data, size_t count) {
+    // Level 1 is empty and count full blocks follow, each with more data
+    // after it, so every one is a complete, non-final tree leaf
+    std::vector<uint64_t> cvs(count * C);
+    const uint64_t first = m_i_for_level[1];
+    parallelFor(m_pool, 0, count, [&](size_t j) {
+        uint64_t block[B];
+        std::memcpy(block, data + j * (B * W / 8), sizeof(block));
+        compressNode(&cvs[j * C], 1, first + j, 0, 0, block);
+    });
+    m_i_for_level[1] += count;
+    
+    absorbChainingValues(std::min(2, m_L + 1), cvs.data(), count);
+}
+
+template<unsigned int DIGEST_BITS>
+void MD6<DIGEST_BITS>::absorbChainingValues(int ell, const uint64_t *cvs, size_t count) {
+    // Same result as appendChainingValue() for each value in turn, with the
+    // full tree nodes in between compressed in parallel
+    constexpr size_t NODE_CVS = B / C;  // chaining values per tree node
+    if (ell > m_top && ell < MAX_STACK_HEIGHT) {
+        m_top = ell;
+    }
     
-    // Recursively process next level if needed
-    if (final || m_bits[next_level] >= B * W) {
-        processBlock(next_level, final);
+    size_t n = 0;
+    while (n < count && m_bits[ell] != 0) {
+        appendChainingValue(ell, &cvs[n * C], 0);  // completes the partly filled node
+        n++;
+    }
+    
+    const size_t nodes = (count - n) / NODE_CVS;
+    if (ell != m_L + 1 && ell + 1 < MAX_STACK_HEIGHT && nodes >= 2) {
+        // Four consecutive chaining values are exactly one node's data
+        std::vector<uint64_t> next(nodes * C);
+        const uint64_t first = m_i_for_level[ell];
+        parallelFor(m_pool, 0, nodes, [&](size_t j) {
+            compressNode(&next[j * C], ell, first + j, 0, 0, &cvs[(n + j * NODE_CVS) * C]);
+        });
+        m_i_for_level[ell] += nodes;
+        n += nodes * NODE_CVS;
+        
+        absorbChainingValues(std::min(ell + 1, m_L + 1), next.data(), nodes);
+    }
+    
+    for (; n < count; n++) {
+        appendChainingValue(ell, &cvs[n * C], 0);
     }
 }
 
@@ -236,6 +286,17 @@ void MD6<DIGEST_BITS>::Update(const CryptoPP::byte *input, size_t length) {
     uint64_t j = 0;  // bits processed so far
     
     while (j < databitlen) {
+        // With a pool, whole leaf blocks go straight from the input to the workers
+        if (m_pool != nullptr && m_L >= 1 && m_bits[ell] == 0 && j % 8 == 0) {
+            const uint64_t leaves = (databitlen - j - 1) / (B * W);  // keep the last block back
+            if (leaves >= PARALLEL_MIN_LEAVES) {
+                const size_t count = static_cast<size_t>(std::min<uint64_t>(leaves, PARALLEL_MAX_LEAVES));
+                hashLeaves(&data[j / 8], count);
+                j += count * B * W;
+                continue;
+            }
+        }
+        
         // Calculate portion size (in bits)
         unsigned int portion_size = std::min(static_cast<unsigned int>(databitlen - j),
                                             static_cast<unsigned int>(B * W - m_bits[ell]));
@@ -258,6 +319,13 @@ void MD6<DIGEST_BITS>::Update(const CryptoPP::byte *input, size_t length) {
         j += portion_size;
         m_bits[ell] += portion_size;
         
+        // The rest of a partly filled word is padding and must read as zero
+        if (m_bits[ell] % W != 0) {
+            unsigned int used = (m_bits[ell] + 7) / 8;
+            unsigned int end = (m_bits[ell] / W + 1) * (W / 8);
+            std::memset(reinterpret_cast<uint8_t*>(m_B[ell].data()) + used, 0, end - used);
+        }
+        
         // Process block if full and more data coming
         if (m_bits[ell] == B * W && j < databitlen) {
             processBlock(ell, 0);
@@ -326,14 +394,7 @@ void MD6<DIGEST_BITS>::TruncatedFinal(CryptoPP::byte *digest, size_t digestSize)
     
     // Reverse byte order within each word (little-endian to big-endian)
     for (int i = 0; i < C; i++) {
-        temp[i] = ((temp[i] & 0x00000000000000FFULL) << 56) |
-                  ((temp[i] & 0x000000000000FF00ULL) << 40) |
-                  ((temp[i] & 0x0000000000FF0000ULL) << 24) |
-                  ((temp[i] & 0x00000000FF000000ULL) << 8)  |
-                  ((temp[i] & 0x000000FF00000000ULL) >> 8)  |
-                  ((temp[i] & 0x0000FF0000000000ULL) >> 24) |
-                  ((temp[i] & 0x00FF000000000000ULL) >> 40) |
-                  ((temp[i] & 0xFF00000000000000ULL) >> 56);
+        temp[i] = byteSwap(temp[i]);
     }
     
     // Extract last d bits from the C words
@@ -369,10 +430,52 @@ template class MD6<256>;
 template class MD6<384>;
 template class MD6<512>;
 
-// Registration macro for MD6 variants
+namespace {
+
+/// @brief Create an MD6 variant from "L=<n>/r=<n>" (either part optional,
+///        keys case-insensitive)
+/// @throws std::invalid_argument for unknown keys or out of range values
+template<unsigned int DIGEST_BITS>
+std::unique_ptr<IHashAlgorithm> createMD6(const std::string& parameters) {
+    using Hash = MD6<DIGEST_BITS>;
+    int L = Hash::DEFAULT_L;
+    int rounds = Hash::DEFAULT_ROUNDS;
+    
+    size_t start = 0;
+    while (start <= parameters.size()) {
+        size_t end = parameters.find('/', start);
+        if (end == std::string::npos) {
+            end = parameters.size();
+        }
+        const std::string item = parameters.substr(start, end - start);
+        start = end + 1;
+        
+        const size_t eq = item.find('=');
+        const std::string value = eq == std::string::npos ? std::string() : item.substr(eq + 1);
+        if (value.empty() || value.size() > 3 ||
+            value.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::invalid_argument("Invalid MD6 parameter: " + item);
+        }
+        const std::string key = item.substr(0, eq);
+        if (key == "L" || key == "l") {
+            L = std::stoi(value);
+        } else if (key == "r" || key == "R") {
+            rounds = std::stoi(value);
+        } else {
+            throw std::invalid_argument("Unknown MD6 parameter: " + item);
+        }
+    }
+    return std::make_unique<MD6Wrapper<Hash>>(std::make_unique<Hash>(L, rounds));
+}
+
+} // namespace
+
+// Registration macro for MD6 variants: "MD6-256" and "MD6-256/L=<n>/r=<n>"
 #define REGISTER_MD6(bits) \
     static HashAlgorithmRegistrar<MD6Wrapper<MD6_##bits>> \
-        reg_md6_##bits("MD6-" #bits)
+        reg_md6_##bits("MD6-" #bits); \
+    static HashAlgorithmFamilyRegistrar \
+        reg_md6_##bits##_params("MD6-" #bits, createMD6<bits>)
 
 // Register common MD6 variants
 REGISTER_MD6(128);
@@ -8,7 +8,7 @@
 #include <array>
 #include <sstream>
 #include <cstring>
-#include <vector>
+#include <stdexcept>
 
 namespace core {
 namespace impl {
@@ -18,6 +18,25 @@ namespace impl {
  * 
  * MD6 is a cryptographic hash function designed by Ron Rivest for the NIST hash function competition.
  * Pure C++ implementation without dependencies on external C code.
+ *
+ * Nothing is allocated per block: each compression packs its 89 input words
+ * straight into a fixed stack window and runs the rounds there with the
+ * fastest kernel of MD6Kernels.h (AVX-512, AVX2 or portable), and levels of
+ * the node stack are only as clean as their bit counts say, so Restart()
+ * does not wipe the whole stack.
+ *
+ * The mode parameter L and the round count r can be chosen per instance:
+ * levels 1 to L form a 4-ary tree and level L + 1 hashes sequentially, so
+ * L = 0 is the fully sequential mode and the default L = 64 a pure tree.
+ * With a ThreadPool, Update() compresses whole leaf blocks of large inputs
+ * in parallel and merges their chaining values level by level, giving the
+ * same digest as processing them one at a time.
+ *
+ * Usage:
+ *   MD6<256> md6;            // MD6-256, L = 64, r = 104
+ *   MD6<256> seq(0, 80);     // MD6-256/L=0/r=80
+ *   seq.Update(data, length);
+ *   seq.Final(digest);
  * 
  * @tparam DIGEST_BITS The desired hash output size in bits (1-512)
  */
@@ -36,16 +55,34 @@ public:
     static constexpr int K_SIZE = 8;  // key size in words
     static constexpr int MAX_STACK_HEIGHT = 29;
     static constexpr int DEFAULT_L = 64;
+    static constexpr int DEFAULT_ROUNDS = 40 + DIGEST_BITS / 4;
+    static constexpr int MAX_ROUNDS = 255;
 
-    MD6() { 
+    /// @param L Mode parameter: tree levels below the sequential level (0 to DEFAULT_L)
+    /// @param rounds Rounds per compression (1 to MAX_ROUNDS)
+    /// @throws std::invalid_argument if a parameter is out of range
+    explicit MD6(int L = DEFAULT_L, int rounds = DEFAULT_ROUNDS) : m_L(L), m_r(rounds) {
         static_assert(DIGEST_BITS >= 1 && DIGEST_BITS <= 512, 
                      "MD6 digest size must be between 1 and 512 bits");
+        if (L < 0 || L > DEFAULT_L) {
+            throw std::invalid_argument("MD6 mode parameter L must be between 0 and 64");
+        }
+        if (rounds < 1 || rounds > MAX_ROUNDS) {
+            throw std::invalid_argument("MD6 round count must be between 1 and 255");
+        }
         Restart(); 
     }
 
+    /// @return "MD6-<bits>", followed by "/L=<L>" and "/r=<rounds>" for non-default parameters
     std::string AlgorithmName() const override {
         std::stringstream ss;
         ss << "MD6-" << DIGEST_BITS;
+        if (m_L != DEFAULT_L) {
+            ss << "/L=" << m_L;
+        }
+        if (m_r != DEFAULT_ROUNDS) {
+            ss << "/r=" << m_r;
+        }
         return ss.str();
     }
     
@@ -62,18 +99,21 @@ public:
     void TruncatedFinal(CryptoPP::byte *digest, size_t digestSize) override;
     void Restart() override;
 
+    /// @brief Append the running state to a saved hash state (see IHashAlgorithm::saveState)
+    void SaveState(HashStateWriter& writer) const;
+
+    /// @brief Restore a state written by SaveState()
+    /// @throws std::invalid_argument if the state is inconsistent
+    void LoadState(HashStateReader& reader);
+
+    /// @brief Compress the leaf blocks of large Update() inputs on the pool's workers as well
+    /// @param pool Pool to use (not owned), nullptr to hash on the calling thread only
+    void SetThreadPool(ThreadPool* pool) { m_pool = pool; }
+
 private:
     // MD6 Q constant (fractional part of sqrt(6))
     static const uint64_t Q[Q_SIZE];
     
-    // Tap positions for feedback shift register
-    static constexpr int t0 = 17;
-    static constexpr int t1 = 18;
-    static constexpr int t2 = 21;
-    static constexpr int t3 = 31;
-    static constexpr int t4 = 67;
-    static constexpr int t5 = 89;
-    
     // State variables
     int m_d;                  // digest size in bits
     int m_L;                  // mode parameter
@@ -81,26 +121,43 @@ private:
     uint64_t m_bits_processed;
     
     std::array<uint64_t, K_SIZE> m_K;  // key (all zeros for default)
-    std::array<std::array<uint64_t, B>, MAX_STACK_HEIGHT> m_B;  // data stack
+    std::array<std::array<uint64_t, B>, MAX_STACK_HEIGHT> m_B;  // data stack (words past m_bits are stale)
     std::array<unsigned int, MAX_STACK_HEIGHT> m_bits;          // bits in each level
     std::array<uint64_t, MAX_STACK_HEIGHT> m_i_for_level;       // node indices
     int m_top;                // top of stack
     
-    std::vector<uint8_t> m_hashval;  // final hash value
+    std::array<uint8_t, C * (W / 8)> m_hashval;  // final hash value
+    ThreadPool* m_pool = nullptr;  // Workers for leaf blocks (not owned)
+    
+    // Leaves per parallel batch: at least PARALLEL_MIN_LEAVES, at most PARALLEL_MAX_LEAVES
+    static constexpr size_t PARALLEL_MIN_LEAVES = 256;
+    static constexpr size_t PARALLEL_MAX_LEAVES = 4096;
     
     // Helper functions
-    int defaultRounds(int d) const;
-    void compress(uint64_t *C, const uint64_t *N, int r);
-    void mainCompressionLoop(uint64_t *A, int r);
     uint64_t makeControlWord(int r, int L, int z, int p, int keylen, int d) const;
-    uint64_t makeNodeID(int ell, int i) const;
+    uint64_t makeNodeID(int ell, uint64_t i) const;
     void pack(uint64_t *N, const uint64_t *Q, const uint64_t *K,
-              int ell, int i, int r, int L, int z, int p, int keylen, int d,
-              const uint64_t *B_data);
+              int ell, uint64_t i, int r, int L, int z, int p, int keylen, int d,
+              const uint64_t *B_data, int reverseFrom) const;
+    void compressNode(uint64_t *C_out, int ell, uint64_t i, int z, int p, const uint64_t *B_data) const;
     void processBlock(int ell, int final);
+    void appendChainingValue(int ell, const uint64_t *cv, int final);
+    void hashLeaves(const uint8_t *data, size_t count);
+    void absorbChainingValues(int ell, const uint64_t *cvs, size_t count);
     void trimHashval();
     
     // Bit manipulation helpers
+    static inline uint64_t byteSwap(uint64_t x) {
+        return ((x & 0x00000000000000FFULL) << 56) |
+               ((x & 0x000000000000FF00ULL) << 40) |
+               ((x & 0x0000000000FF0000ULL) << 24) |
+               ((x & 0x00000000FF000000ULL) << 8)  |
+               ((x & 0x000000FF00000000ULL) >> 8)  |
+               ((x & 0x0000FF0000000000ULL) >> 24) |
+               ((x & 0x00FF000000000000ULL) >> 40) |
+               ((x & 0xFF00000000000000ULL) >> 56);
+    }
+
     static inline uint64_t rotateRight(uint64_t x, int n) {
         return (x >> n) | (x << (64 - n));
     }
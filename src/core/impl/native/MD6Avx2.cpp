@@ -0,0 +1,103 @@
+#include "MD6Kernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <immintrin.h>
+#include <cstring>
+
+namespace core {
+namespace impl {
+namespace md6 {
+
+namespace {
+
+#define AVX2 HASHCALC_TARGET("avx2")
+
+AVX2 inline __m256i loadu(const uint64_t* src) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+}
+
+/// @brief Words tap words back from steps 4g to 4g + 3, from the registers
+/// @param Y Y[k] holds words -4(k+1) to -4k - 1 relative to the round start
+template<int tap, int g>
+AVX2 inline __m256i nearTap(const __m256i* Y) {
+    constexpr int start = 4 * g - tap;
+    constexpr int k = (-start - 1) / 4;
+    constexpr int p = start + 4 * (k + 1);  // first word's lane in Y[k]
+    if constexpr (p == 0) {
+        return Y[k];
+    } else {
+        const __m256i mid = _mm256_permute2x128_si256(Y[k], Y[k - 1], 0x21);
+        if constexpr (p == 1) {
+            return _mm256_alignr_epi8(mid, Y[k], 8);
+        } else if constexpr (p == 2) {
+            return mid;
+        } else {
+            return _mm256_alignr_epi8(Y[k - 1], mid, 8);
+        }
+    }
+}
+
+/// @brief Steps 4g to 4g + 3 of the round starting at a
+template<int g>
+AVX2 inline __m256i steps4(const __m256i* Y, uint64_t* a, __m256i S) {
+    const __m256i rs = _mm256_setr_epi64x(RS[4 * g], RS[4 * g + 1], RS[4 * g + 2], RS[4 * g + 3]);
+    const __m256i ls = _mm256_setr_epi64x(LS[4 * g], LS[4 * g + 1], LS[4 * g + 2], LS[4 * g + 3]);
+    uint64_t* b = a + 4 * g;
+
+    // The two far taps come from memory, the rest from registers
+    __m256i x = _mm256_xor_si256(_mm256_xor_si256(S, loadu(b - T5)), nearTap<T0, g>(Y));
+    x = _mm256_xor_si256(x, _mm256_and_si256(nearTap<T1, g>(Y), nearTap<T2, g>(Y)));
+    x = _mm256_xor_si256(x, _mm256_and_si256(nearTap<T3, g>(Y), loadu(b - T4)));
+    x = _mm256_xor_si256(x, _mm256_srlv_epi64(x, rs));
+    x = _mm256_xor_si256(x, _mm256_sllv_epi64(x, ls));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(b), x);
+    return x;
+}
+
+} // namespace
+
+AVX2 void compressAvx2(uint64_t out[C], uint64_t* A, int r) {
+    // Same sliding window as compressPortable(), with the last 32 words
+    // mirrored in Y0 (newest) to Y7
+    __m256i Y0 = loadu(A + N - 4);
+    __m256i Y1 = loadu(A + N - 8);
+    __m256i Y2 = loadu(A + N - 12);
+    __m256i Y3 = loadu(A + N - 16);
+    __m256i Y4 = loadu(A + N - 20);
+    __m256i Y5 = loadu(A + N - 24);
+    __m256i Y6 = loadu(A + N - 28);
+    __m256i Y7 = loadu(A + N - 32);
+
+    uint64_t S = S0;
+    uint64_t* window = A;
+    for (int round = 0; round < r; round++) {
+        if (window + N + C > A + WINDOW_WORDS) {
+            std::memmove(A, window, N * sizeof(uint64_t));
+            window = A;
+        }
+
+        uint64_t* a = window + N;
+        const __m256i s = _mm256_set1_epi64x(static_cast<long long>(S));
+        const __m256i Y[8] = {Y0, Y1, Y2, Y3, Y4, Y5, Y6, Y7};
+        const __m256i x0 = steps4<0>(Y, a, s);
+        const __m256i x1 = steps4<1>(Y, a, s);
+        const __m256i x2 = steps4<2>(Y, a, s);
+        const __m256i x3 = steps4<3>(Y, a, s);
+        Y7 = Y3; Y6 = Y2; Y5 = Y1; Y4 = Y0;
+        Y3 = x0; Y2 = x1; Y1 = x2; Y0 = x3;
+
+        S = nextS(S);
+        window += C;
+    }
+
+    std::memcpy(out, window + N - C, C * sizeof(uint64_t));
+}
+
+#undef AVX2
+
+} // namespace md6
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
@@ -0,0 +1,85 @@
+#include "MD6Kernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <immintrin.h>
+
+namespace core {
+namespace impl {
+namespace md6 {
+
+namespace {
+
+#define AVX512 HASHCALC_TARGET("avx512f")
+
+/// @brief Words tap words back from steps 8g to 8g + 7, from the registers
+/// @param Z Z[k] holds words -8(k+1) to -8k - 1 relative to the round start
+template<int tap, int g>
+AVX512 inline __m512i windowTap(const __m512i* Z) {
+    constexpr int start = 8 * g - tap;
+    constexpr int k = (-start - 1) / 8;
+    constexpr int p = start + 8 * (k + 1);  // first word's lane in Z[k]
+    if constexpr (p == 0) {
+        return Z[k];
+    } else {
+        return _mm512_alignr_epi64(Z[k - 1], Z[k], p);
+    }
+}
+
+/// @brief Steps 8g to 8g + 7 of a round
+template<int g>
+AVX512 inline __m512i steps8(const __m512i* Z, __m512i S) {
+    const __m512i rs = _mm512_setr_epi64(RS[8 * g], RS[8 * g + 1], RS[8 * g + 2], RS[8 * g + 3],
+                                         RS[8 * g + 4], RS[8 * g + 5], RS[8 * g + 6], RS[8 * g + 7]);
+    const __m512i ls = _mm512_setr_epi64(LS[8 * g], LS[8 * g + 1], LS[8 * g + 2], LS[8 * g + 3],
+                                         LS[8 * g + 4], LS[8 * g + 5], LS[8 * g + 6], LS[8 * g + 7]);
+
+    // 0x96: a ^ b ^ c, 0x78: a ^ (b & c)
+    __m512i x = _mm512_ternarylogic_epi64(S, windowTap<T5, g>(Z), windowTap<T0, g>(Z), 0x96);
+    x = _mm512_ternarylogic_epi64(x, windowTap<T1, g>(Z), windowTap<T2, g>(Z), 0x78);
+    x = _mm512_ternarylogic_epi64(x, windowTap<T3, g>(Z), windowTap<T4, g>(Z), 0x78);
+    x = _mm512_xor_si512(x, _mm512_srlv_epi64(x, rs));
+    return _mm512_xor_si512(x, _mm512_sllv_epi64(x, ls));
+}
+
+} // namespace
+
+AVX512 void compressAvx512(uint64_t out[C], uint64_t* A, int r) {
+    // The whole window lives in Z0 (newest) to Z11, 96 words of which the
+    // oldest 7 are never read; nothing is stored until the end
+    __m512i Z0 = _mm512_loadu_si512(A + N - 8);
+    __m512i Z1 = _mm512_loadu_si512(A + N - 16);
+    __m512i Z2 = _mm512_loadu_si512(A + N - 24);
+    __m512i Z3 = _mm512_loadu_si512(A + N - 32);
+    __m512i Z4 = _mm512_loadu_si512(A + N - 40);
+    __m512i Z5 = _mm512_loadu_si512(A + N - 48);
+    __m512i Z6 = _mm512_loadu_si512(A + N - 56);
+    __m512i Z7 = _mm512_loadu_si512(A + N - 64);
+    __m512i Z8 = _mm512_loadu_si512(A + N - 72);
+    __m512i Z9 = _mm512_loadu_si512(A + N - 80);
+    __m512i Z10 = _mm512_loadu_si512(A + N - 88);
+    __m512i Z11 = _mm512_maskz_loadu_epi64(0x80, A + N - 96);  // word 0 only
+
+    uint64_t S = S0;
+    for (int round = 0; round < r; round++) {
+        const __m512i s = _mm512_set1_epi64(static_cast<long long>(S));
+        const __m512i Z[12] = {Z0, Z1, Z2, Z3, Z4, Z5, Z6, Z7, Z8, Z9, Z10, Z11};
+        const __m512i x0 = steps8<0>(Z, s);
+        const __m512i x1 = steps8<1>(Z, s);
+        Z11 = Z9; Z10 = Z8; Z9 = Z7; Z8 = Z6; Z7 = Z5; Z6 = Z4;
+        Z5 = Z3; Z4 = Z2; Z3 = Z1; Z2 = Z0; Z1 = x0; Z0 = x1;
+
+        S = nextS(S);
+    }
+
+    _mm512_storeu_si512(out, Z1);
+    _mm512_storeu_si512(out + 8, Z0);
+}
+
+#undef AVX512
+
+} // namespace md6
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
@@ -0,0 +1,69 @@
+#include "MD6Kernels.h"
+#include <cstring>
+
+namespace core {
+namespace impl {
+namespace md6 {
+
+namespace {
+
+using CompressFn = void (*)(uint64_t*, uint64_t*, int);
+
+/// @return Fastest compression kernel for this CPU
+CompressFn selectCompress() {
+#if defined(HASHCALC_X86)
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (cpu.avx512f) {
+        return compressAvx512;
+    }
+    if (cpu.avx2) {
+        return compressAvx2;
+    }
+#endif
+    return compressPortable;
+}
+
+} // namespace
+
+void compress(uint64_t out[C], uint64_t* A, int r) {
+    static const CompressFn kernel = selectCompress();
+    kernel(out, A, r);
+}
+
+// One step of the feedback shift register: word s of the round starting at a
+#define MD6_STEP(s)                                                                   \
+    x = S ^ a[s - T5] ^ a[s - T0] ^ (a[s - T1] & a[s - T2]) ^ (a[s - T3] & a[s - T4]); \
+    x ^= x >> RS[s];                                                                  \
+    a[s] = x ^ (x << LS[s])
+
+void compressPortable(uint64_t out[C], uint64_t* A, int r) {
+    // A holds the N packed input words and room for WINDOW_ROUNDS rounds. A
+    // round reads only the N words before it, so once the room is used up the
+    // last N words are moved back to the front instead of keeping all r * C.
+    uint64_t x, S = S0;
+    uint64_t* window = A;  // the last N words
+    for (int round = 0; round < r; round++) {
+        if (window + N + C > A + WINDOW_WORDS) {
+            std::memmove(A, window, N * sizeof(uint64_t));
+            window = A;
+        }
+
+        uint64_t* a = window + N;
+        MD6_STEP(0);  MD6_STEP(1);  MD6_STEP(2);  MD6_STEP(3);
+        MD6_STEP(4);  MD6_STEP(5);  MD6_STEP(6);  MD6_STEP(7);
+        MD6_STEP(8);  MD6_STEP(9);  MD6_STEP(10); MD6_STEP(11);
+        MD6_STEP(12); MD6_STEP(13); MD6_STEP(14); MD6_STEP(15);
+
+        S = nextS(S);
+        window += C;
+    }
+
+    // Output: the last C words computed
+    std::memcpy(out, window + N - C, C * sizeof(uint64_t));
+}
+
+#undef MD6_STEP
+
+} // namespace md6
+} // namespace impl
+} // namespace core
@@ -0,0 +1,75 @@
+#ifndef MD6_KERNELS_H
+#define MD6_KERNELS_H
+
+#include "../../CpuFeatures.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+namespace impl {
+namespace md6 {
+
+/**
+ * @brief MD6 compression function kernels.
+ *
+ * The compression function runs a feedback shift register over 64-bit
+ * words: word i is computed from words i-17, i-18, i-21, i-31, i-67 and
+ * i-89, 16 words (steps) per round. Because the nearest tap is 17 words
+ * back, the 16 steps of a round only depend on earlier rounds and can be
+ * computed side by side; only the right and left shift counts differ from
+ * step to step.
+ *
+ * The AVX2 kernel computes a round as four vectors of four steps, keeping
+ * the last 32 words in registers for the near taps; the AVX-512 kernel
+ * computes it as two vectors of eight steps with the whole 96-word window
+ * held in registers. Both use per-lane shift counts (vpsrlvq/vpsllvq).
+ * compress() picks the fastest kernel the CPU supports on every call.
+ */
+
+constexpr int N = 89;              ///< Words of compression input (and of the feedback window)
+constexpr int C = 16;              ///< Words of compression output, and steps per round
+constexpr int WINDOW_ROUNDS = 8;   ///< Rounds between slides of the window back to the front
+
+/// @brief Words of the buffer a kernel compresses in
+constexpr int WINDOW_WORDS = N + WINDOW_ROUNDS * C;
+
+// Tap positions of the feedback shift register (words back from the new word)
+constexpr int T0 = 17;
+constexpr int T1 = 18;
+constexpr int T2 = 21;
+constexpr int T3 = 31;
+constexpr int T4 = 67;
+constexpr int T5 = 89;
+
+/// @brief Right and left shift amounts of each step of a round
+constexpr int RS[C] = {10, 5, 13, 10, 11, 12, 2, 7, 14, 15, 7, 13, 11, 7, 6, 12};
+constexpr int LS[C] = {11, 24, 9, 16, 15, 9, 27, 15, 6, 2, 29, 8, 15, 5, 31, 9};
+
+/// @brief Round constant of the first round
+constexpr uint64_t S0 = 0x0123456789abcdefULL;
+
+/// @return Round constant of the round after the one using s
+inline uint64_t nextS(uint64_t s) {
+    return (s << 1) ^ (s >> 63) ^ (s & 0x7311c2812425cfa0ULL);
+}
+
+/// @brief Run r rounds of the compression function
+/// @param out C output words (the last C words computed)
+/// @param A Buffer of WINDOW_WORDS words starting with the N packed input
+///          words; the kernel uses the rest as working space
+void compress(uint64_t out[C], uint64_t* A, int r);
+
+// Portable and instruction set specific kernels, chosen by compress()
+
+void compressPortable(uint64_t out[C], uint64_t* A, int r);
+
+#if defined(HASHCALC_X86)
+void compressAvx2(uint64_t out[C], uint64_t* A, int r);
+void compressAvx512(uint64_t out[C], uint64_t* A, int r);
+#endif
+
+} // namespace md6
+} // namespace impl
+} // namespace core
+
+#endif // MD6_KERNELS_H
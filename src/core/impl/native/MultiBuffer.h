@@ -0,0 +1,84 @@
+#ifndef MULTI_BUFFER_H
+#define MULTI_BUFFER_H
+
+#include "../../IBatchHashAlgorithm.h"
+#include "MultiBufferKernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+namespace impl {
+
+/**
+ * @brief Multi-buffer MD5, SHA-1, SHA-256 and RIPEMD-160 over many messages.
+ *
+ * Every lane of the compression kernel (MultiBufferKernels.h) hashes one
+ * message. A message is split into its whole blocks, read in place, and a
+ * padded tail of one or two blocks in the lane's own buffer. Each kernel
+ * call runs as many blocks as the busy lane closest to the end of its
+ * current run has left; a lane that finishes writes its digest and takes
+ * the next waiting message at once, so short and long messages mix
+ * without leaving lanes idle. Idle lanes recompute the blocks of a busy
+ * lane into their own, unused state rather than being masked out.
+ *
+ * When no message is waiting and only one lane, or at most an eighth of
+ * the lanes, is still busy, those lanes are finished one by one with the
+ * portable kernel, which is faster than sending mostly idle registers
+ * through the rounds.
+ *
+ * Usage:
+ *   MultiBufferHash<mb::Sha256> sha256("SHA-256", mb::SHA256_KERNELS, 8);
+ *   sha256.computeMany(messages, count, digests);
+ */
+template<class Alg>
+class MultiBufferHash : public IBatchHashAlgorithm {
+public:
+    /// @param name Name reported by getName()
+    /// @param kernels Kernels of Alg
+    /// @param lanes Messages hashed side by side (4, 8 or 16)
+    /// @throws std::invalid_argument if lanes is not 4, 8 or 16
+    MultiBufferHash(const std::string& name, const mb::KernelSet& kernels, size_t lanes);
+
+    std::string getName() const override { return m_name; }
+    size_t getDigestSize() const override { return Alg::DIGEST_SIZE; }
+    size_t getLanes() const override { return m_lanes; }
+
+    void computeMany(const Message* messages, size_t count, uint8_t* digests) override;
+    using IBatchHashAlgorithm::computeMany;
+
+private:
+    /// @brief Progress of the message in one lane
+    struct Lane {
+        bool busy = false;
+        size_t message = 0;              // index of the message
+        const uint8_t* next = nullptr;   // next block of the current run
+        size_t blocks = 0;               // blocks left in the current run
+        bool inTail = false;             // the current run is the padded tail
+        size_t tailBlocks = 0;
+        uint8_t tail[2 * mb::BLOCK_SIZE];
+    };
+
+    /// @brief Put message index into lane, starting from the initial chaining value
+    void startLane(size_t lane, const Message& message, size_t index);
+
+    /// @brief Finish a busy lane with the portable kernel and write its digest
+    void finishAlone(size_t lane, uint8_t* digests);
+
+    /// @brief Write the digest held in the words state[0], state[stride], ...
+    static void storeDigest(const uint32_t* state, size_t stride, uint8_t* digest);
+
+    std::string m_name;
+    size_t m_lanes;
+    mb::Kernel m_kernel;
+    mb::Kernel m_portable;
+    std::vector<uint32_t> m_state;      // word i of lane l at i * m_lanes + l
+    std::vector<Lane> m_lane;
+    std::vector<const uint8_t*> m_data; // kernel input, one pointer per lane
+};
+
+} // namespace impl
+} // namespace core
+
+#endif // MULTI_BUFFER_H
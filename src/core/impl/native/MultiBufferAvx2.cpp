@@ -0,0 +1,114 @@
+#include "MultiBufferKernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <immintrin.h>
+
+#define MB_TARGET HASHCALC_TARGET("avx2")
+#include "MultiBufferRounds.h"
+
+namespace core {
+namespace impl {
+namespace mb {
+
+namespace {
+
+#define AVX2 MB_TARGET
+
+/// @brief Eight lanes in a YMM register
+struct Avx2Ops {
+    using Vec = __m256i;
+    static constexpr size_t LANES = 8;
+
+    AVX2 static Vec load(const uint32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    AVX2 static void store(uint32_t* p, Vec x) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x); }
+    AVX2 static Vec set1(uint32_t x) { return _mm256_set1_epi32(static_cast<int>(x)); }
+
+    AVX2 static Vec add(Vec x, Vec y) { return _mm256_add_epi32(x, y); }
+    AVX2 static Vec bxor(Vec x, Vec y) { return _mm256_xor_si256(x, y); }
+    AVX2 static Vec band(Vec x, Vec y) { return _mm256_and_si256(x, y); }
+    AVX2 static Vec bor(Vec x, Vec y) { return _mm256_or_si256(x, y); }
+    AVX2 static Vec orNot(Vec x, Vec y) { return _mm256_or_si256(x, _mm256_xor_si256(y, _mm256_set1_epi32(-1))); }
+    AVX2 static Vec ch(Vec x, Vec y, Vec z) {
+        return _mm256_xor_si256(z, _mm256_and_si256(x, _mm256_xor_si256(y, z)));
+    }
+    AVX2 static Vec maj(Vec x, Vec y, Vec z) {
+        return _mm256_or_si256(_mm256_and_si256(x, y), _mm256_and_si256(z, _mm256_or_si256(x, y)));
+    }
+    AVX2 static Vec xor3(Vec x, Vec y, Vec z) { return _mm256_xor_si256(_mm256_xor_si256(x, y), z); }
+
+    template<int n>
+    AVX2 static Vec rotl(Vec x) { return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n)); }
+
+    template<int n>
+    AVX2 static Vec shr(Vec x) { return _mm256_srli_epi32(x, n); }
+
+    AVX2 static Vec bswap(Vec x) {
+        const __m256i mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                              3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        return _mm256_shuffle_epi8(x, mask);
+    }
+
+    AVX2 static void loadBlock(const uint8_t* const* p, Vec w[16]) {
+        // Two 8x8 transposes, 32 bytes of every lane at a time
+        for (int half = 0; half < 2; half++) {
+            __m256i r[8];
+            for (int lane = 0; lane < 8; lane++) {
+                r[lane] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p[lane] + 32 * half));
+            }
+            // Pairs of lanes, then quads, within each 128-bit half...
+            const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+            const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+            const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+            const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+            const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+            const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+            const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+            const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+            const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+            const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+            const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+            const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+            const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+            const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+            const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+            const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+            // ...then lanes 0-3 and 4-7 across the halves
+            Vec* out = w + 8 * half;
+            out[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+            out[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+            out[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+            out[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+            out[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+            out[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+            out[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+            out[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+        }
+    }
+};
+
+} // namespace
+
+AVX2 void md5Avx2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Avx2Ops, Md5>(state, lanes, data, blocks);
+}
+
+AVX2 void sha1Avx2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Avx2Ops, Sha1>(state, lanes, data, blocks);
+}
+
+AVX2 void sha256Avx2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Avx2Ops, Sha256>(state, lanes, data, blocks);
+}
+
+AVX2 void ripemd160Avx2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Avx2Ops, Ripemd160>(state, lanes, data, blocks);
+}
+
+#undef AVX2
+
+} // namespace mb
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
@@ -0,0 +1,109 @@
+#include "MultiBufferKernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <immintrin.h>
+
+#define MB_TARGET HASHCALC_TARGET("avx512f")
+#include "MultiBufferRounds.h"
+
+namespace core {
+namespace impl {
+namespace mb {
+
+namespace {
+
+#define AVX512 MB_TARGET
+
+/// @brief Sixteen lanes in a ZMM register; the three-input functions are single
+///        ternary logic instructions and rotations are native
+struct Avx512Ops {
+    using Vec = __m512i;
+    static constexpr size_t LANES = 16;
+
+    AVX512 static Vec load(const uint32_t* p) { return _mm512_loadu_si512(p); }
+    AVX512 static void store(uint32_t* p, Vec x) { _mm512_storeu_si512(p, x); }
+    AVX512 static Vec set1(uint32_t x) { return _mm512_set1_epi32(static_cast<int>(x)); }
+
+    AVX512 static Vec add(Vec x, Vec y) { return _mm512_add_epi32(x, y); }
+    AVX512 static Vec bxor(Vec x, Vec y) { return _mm512_xor_si512(x, y); }
+    AVX512 static Vec band(Vec x, Vec y) { return _mm512_and_si512(x, y); }
+    AVX512 static Vec bor(Vec x, Vec y) { return _mm512_or_si512(x, y); }
+    // Truth tables over (x, y, z): 0xF3 x | ~y, 0xCA x ? y : z, 0xE8 majority, 0x96 parity
+    AVX512 static Vec orNot(Vec x, Vec y) { return _mm512_ternarylogic_epi32(x, y, y, 0xF3); }
+    AVX512 static Vec ch(Vec x, Vec y, Vec z) { return _mm512_ternarylogic_epi32(x, y, z, 0xCA); }
+    AVX512 static Vec maj(Vec x, Vec y, Vec z) { return _mm512_ternarylogic_epi32(x, y, z, 0xE8); }
+    AVX512 static Vec xor3(Vec x, Vec y, Vec z) { return _mm512_ternarylogic_epi32(x, y, z, 0x96); }
+
+    template<int n>
+    AVX512 static Vec rotl(Vec x) { return _mm512_rol_epi32(x, n); }
+
+    template<int n>
+    AVX512 static Vec shr(Vec x) { return _mm512_srli_epi32(x, n); }
+
+    AVX512 static Vec bswap(Vec x) {
+        // Without AVX-512BW byte shuffles: bytes 0 and 2 rotate right by 8, bytes 1 and 3 left by 8
+        const __m512i even = _mm512_and_si512(x, _mm512_set1_epi32(0x00FF00FF));
+        const __m512i odd = _mm512_and_si512(x, _mm512_set1_epi32(static_cast<int>(0xFF00FF00)));
+        return _mm512_or_si512(_mm512_rol_epi32(even, 24), _mm512_rol_epi32(odd, 8));
+    }
+
+    AVX512 static void loadBlock(const uint8_t* const* p, Vec w[16]) {
+        // 16x16 transpose: one whole block per lane in r, word j of all lanes out
+        __m512i r[16];
+        for (int lane = 0; lane < 16; lane++) {
+            r[lane] = _mm512_loadu_si512(p[lane]);
+        }
+
+        // Within every 128-bit chunk k: u[4q + j] = word 4k + j of lanes 4q to 4q + 3
+        __m512i u[16];
+        for (int q = 0; q < 4; q++) {
+            const __m512i t0 = _mm512_unpacklo_epi32(r[4 * q], r[4 * q + 1]);
+            const __m512i t1 = _mm512_unpackhi_epi32(r[4 * q], r[4 * q + 1]);
+            const __m512i t2 = _mm512_unpacklo_epi32(r[4 * q + 2], r[4 * q + 3]);
+            const __m512i t3 = _mm512_unpackhi_epi32(r[4 * q + 2], r[4 * q + 3]);
+            u[4 * q] = _mm512_unpacklo_epi64(t0, t2);
+            u[4 * q + 1] = _mm512_unpackhi_epi64(t0, t2);
+            u[4 * q + 2] = _mm512_unpacklo_epi64(t1, t3);
+            u[4 * q + 3] = _mm512_unpackhi_epi64(t1, t3);
+        }
+
+        // Then a 4x4 transpose of 128-bit chunks: chunk q of w[4k + j] is chunk k of u[4q + j]
+        for (int j = 0; j < 4; j++) {
+            const __m512i x0 = _mm512_shuffle_i32x4(u[j], u[4 + j], 0x44);
+            const __m512i x1 = _mm512_shuffle_i32x4(u[j], u[4 + j], 0xEE);
+            const __m512i x2 = _mm512_shuffle_i32x4(u[8 + j], u[12 + j], 0x44);
+            const __m512i x3 = _mm512_shuffle_i32x4(u[8 + j], u[12 + j], 0xEE);
+            w[j] = _mm512_shuffle_i32x4(x0, x2, 0x88);
+            w[4 + j] = _mm512_shuffle_i32x4(x0, x2, 0xDD);
+            w[8 + j] = _mm512_shuffle_i32x4(x1, x3, 0x88);
+            w[12 + j] = _mm512_shuffle_i32x4(x1, x3, 0xDD);
+        }
+    }
+};
+
+} // namespace
+
+AVX512 void md5Avx512(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Avx512Ops, Md5>(state, lanes, data, blocks);
+}
+
+AVX512 void sha1Avx512(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Avx512Ops, Sha1>(state, lanes, data, blocks);
+}
+
+AVX512 void sha256Avx512(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Avx512Ops, Sha256>(state, lanes, data, blocks);
+}
+
+AVX512 void ripemd160Avx512(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Avx512Ops, Ripemd160>(state, lanes, data, blocks);
+}
+
+#undef AVX512
+
+} // namespace mb
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
@@ -0,0 +1,98 @@
+#include "MultiBufferKernels.h"
+
+#define MB_TARGET
+#include "MultiBufferRounds.h"
+
+namespace core {
+namespace impl {
+namespace mb {
+
+namespace {
+
+/// @brief One lane in a plain 32-bit integer
+struct ScalarOps {
+    using Vec = uint32_t;
+    static constexpr size_t LANES = 1;
+
+    static Vec load(const uint32_t* p) { return *p; }
+    static void store(uint32_t* p, Vec x) { *p = x; }
+    static Vec set1(uint32_t x) { return x; }
+
+    static Vec add(Vec x, Vec y) { return x + y; }
+    static Vec bxor(Vec x, Vec y) { return x ^ y; }
+    static Vec band(Vec x, Vec y) { return x & y; }
+    static Vec bor(Vec x, Vec y) { return x | y; }
+    static Vec orNot(Vec x, Vec y) { return x | ~y; }
+    static Vec ch(Vec x, Vec y, Vec z) { return z ^ (x & (y ^ z)); }
+    static Vec maj(Vec x, Vec y, Vec z) { return (x & y) | (z & (x | y)); }
+    static Vec xor3(Vec x, Vec y, Vec z) { return x ^ y ^ z; }
+
+    template<int n>
+    static Vec rotl(Vec x) { return (x << n) | (x >> (32 - n)); }
+
+    template<int n>
+    static Vec shr(Vec x) { return x >> n; }
+
+    static Vec bswap(Vec x) {
+        return (x << 24) | ((x << 8) & 0x00FF0000) | ((x >> 8) & 0x0000FF00) | (x >> 24);
+    }
+
+    static void loadBlock(const uint8_t* const* p, Vec w[16]) {
+        for (int i = 0; i < 16; i++) {
+            const uint8_t* b = p[0] + 4 * i;
+            w[i] = static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) |
+                   (static_cast<uint32_t>(b[2]) << 16) | (static_cast<uint32_t>(b[3]) << 24);
+        }
+    }
+};
+
+} // namespace
+
+void md5Portable(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<ScalarOps, Md5>(state, lanes, data, blocks);
+}
+
+void sha1Portable(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<ScalarOps, Sha1>(state, lanes, data, blocks);
+}
+
+void sha256Portable(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<ScalarOps, Sha256>(state, lanes, data, blocks);
+}
+
+void ripemd160Portable(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<ScalarOps, Ripemd160>(state, lanes, data, blocks);
+}
+
+#if defined(HASHCALC_X86)
+const KernelSet MD5_KERNELS = {md5Portable, md5Sse2, md5Avx2, md5Avx512};
+const KernelSet SHA1_KERNELS = {sha1Portable, sha1Sse2, sha1Avx2, sha1Avx512};
+const KernelSet SHA256_KERNELS = {sha256Portable, sha256Sse2, sha256Avx2, sha256Avx512};
+const KernelSet RIPEMD160_KERNELS = {ripemd160Portable, ripemd160Sse2, ripemd160Avx2, ripemd160Avx512};
+#else
+const KernelSet MD5_KERNELS = {md5Portable, nullptr, nullptr, nullptr};
+const KernelSet SHA1_KERNELS = {sha1Portable, nullptr, nullptr, nullptr};
+const KernelSet SHA256_KERNELS = {sha256Portable, nullptr, nullptr, nullptr};
+const KernelSet RIPEMD160_KERNELS = {ripemd160Portable, nullptr, nullptr, nullptr};
+#endif
+
+Kernel selectKernel(const KernelSet& set, size_t lanes) {
+#if defined(HASHCALC_X86)
+    const CpuFeatures& cpu = CpuFeatures::get();
+    if (lanes % 16 == 0 && cpu.avx512f) {
+        return set.avx512;
+    }
+    if (lanes % 8 == 0 && cpu.avx2) {
+        return set.avx2;
+    }
+    if (lanes % 4 == 0 && cpu.sse2) {
+        return set.sse2;
+    }
+#endif
+    (void)lanes;
+    return set.portable;
+}
+
+} // namespace mb
+} // namespace impl
+} // namespace core
@@ -0,0 +1,122 @@
+#ifndef MULTI_BUFFER_KERNELS_H
+#define MULTI_BUFFER_KERNELS_H
+
+#include "../../CpuFeatures.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+namespace impl {
+namespace mb {
+
+/**
+ * @brief Multi-buffer compression kernels for MD5, SHA-1, SHA-256 and RIPEMD-160.
+ *
+ * All four are Merkle-Damgård hashes with 32-bit words and 64-byte blocks,
+ * and their compression functions use only additions, rotations and
+ * bitwise logic. A kernel therefore runs the compression function of
+ * several independent messages side by side, one message per 32-bit lane:
+ * 4 per register with SSE2, 8 with AVX2 and 16 with AVX-512. Lane counts
+ * above the register width are processed as several register groups.
+ *
+ * The chaining values are kept transposed, word i of lane l at
+ * state[i * lanes + l], and every lane reads its own run of consecutive
+ * blocks. Padding, lane refills and digests are left to the caller
+ * (see MultiBuffer.h).
+ *
+ * The round functions are written once, as templates over a small vector
+ * type (MultiBufferRounds.h), and instantiated by each instruction set's
+ * kernel file.
+ */
+
+/// @brief Block size shared by all four algorithms
+constexpr size_t BLOCK_SIZE = 64;
+
+/// @brief Widest lane count, that of AVX-512
+constexpr size_t MAX_LANES = 16;
+
+/// @brief Compression kernel
+/// @param state Chaining values of all lanes, word i of lane l at state[i * lanes + l]
+/// @param lanes Lane count, a multiple of the kernel's register width
+/// @param data Per lane, the first of blocks consecutive 64-byte blocks
+/// @param blocks Blocks to compress in every lane
+using Kernel = void (*)(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+
+// Algorithm descriptions: state words, byte order of words and of the
+// length in the padding, initial chaining value
+
+struct Md5 {
+    static constexpr size_t WORDS = 4;
+    static constexpr size_t DIGEST_SIZE = 16;
+    static constexpr bool BIG_ENDIAN_WORDS = false;
+    static constexpr uint32_t IV[WORDS] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476};
+};
+
+struct Sha1 {
+    static constexpr size_t WORDS = 5;
+    static constexpr size_t DIGEST_SIZE = 20;
+    static constexpr bool BIG_ENDIAN_WORDS = true;
+    static constexpr uint32_t IV[WORDS] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+};
+
+struct Sha256 {
+    static constexpr size_t WORDS = 8;
+    static constexpr size_t DIGEST_SIZE = 32;
+    static constexpr bool BIG_ENDIAN_WORDS = true;
+    static constexpr uint32_t IV[WORDS] = {0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+                                           0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+};
+
+struct Ripemd160 {
+    static constexpr size_t WORDS = 5;
+    static constexpr size_t DIGEST_SIZE = 20;
+    static constexpr bool BIG_ENDIAN_WORDS = false;
+    static constexpr uint32_t IV[WORDS] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+};
+
+/// @brief The kernels of one algorithm, by instruction set (nullptr where not built)
+struct KernelSet {
+    Kernel portable;  // any lane count
+    Kernel sse2;      // multiples of 4 lanes
+    Kernel avx2;      // multiples of 8 lanes
+    Kernel avx512;    // multiples of 16 lanes
+};
+
+extern const KernelSet MD5_KERNELS;
+extern const KernelSet SHA1_KERNELS;
+extern const KernelSet SHA256_KERNELS;
+extern const KernelSet RIPEMD160_KERNELS;
+
+/// @return Fastest kernel of set for lanes on this CPU: the widest one whose
+///         register width divides lanes, or the portable kernel
+Kernel selectKernel(const KernelSet& set, size_t lanes);
+
+// Portable and instruction set specific kernels
+
+void md5Portable(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void sha1Portable(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void sha256Portable(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void ripemd160Portable(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+
+#if defined(HASHCALC_X86)
+void md5Sse2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void sha1Sse2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void sha256Sse2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void ripemd160Sse2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+
+void md5Avx2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void sha1Avx2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void sha256Avx2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void ripemd160Avx2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+
+void md5Avx512(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void sha1Avx512(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void sha256Avx512(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+void ripemd160Avx512(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks);
+#endif
+
+} // namespace mb
+} // namespace impl
+} // namespace core
+
+#endif // MULTI_BUFFER_KERNELS_H
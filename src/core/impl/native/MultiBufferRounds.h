@@ -0,0 +1,344 @@
+#ifndef MULTI_BUFFER_ROUNDS_H
+#define MULTI_BUFFER_ROUNDS_H
+
+// Round functions of the multi-buffer kernels (MultiBufferKernels.h),
+// written once for every instruction set. A kernel file defines MB_TARGET
+// (its HASHCALC_TARGET, or nothing) and a vector type V providing:
+//
+//   V::Vec                       one 32-bit word in each of V::LANES lanes
+//   V::load(p), V::store(p, x)   LANES consecutive words
+//   V::set1(x)                   x in every lane
+//   V::add, V::bxor, V::band, V::bor
+//   V::orNot(x, y)               x | ~y
+//   V::ch(x, y, z)               (x & y) | (~x & z)
+//   V::maj(x, y, z)              (x & y) | (x & z) | (y & z)
+//   V::xor3(x, y, z)             x ^ y ^ z
+//   V::rotl<n>(x), V::shr<n>(x)
+//   V::bswap(x)                  byte swap of every word
+//   V::loadBlock(p, w)           w[i] = little-endian word i of the block at p[lane]
+//
+// and then includes this header. Everything here is in an anonymous
+// namespace, so the instantiations of different kernel files never meet.
+
+#ifndef MB_TARGET
+#error "Define MB_TARGET before including MultiBufferRounds.h"
+#endif
+
+#include "MultiBufferKernels.h"
+#include <utility>
+
+namespace core {
+namespace impl {
+namespace mb {
+
+namespace {
+
+// Every compression function below is unrolled at compile time: step t is
+// an instantiation with t as a template argument, so that rotation counts,
+// message word indices and constants are immediates. The working variables
+// are not moved between steps; instead the slot holding each of them turns
+// by one per step, and after a whole block every slot is back in place.
+
+// ============================================================================
+// MD5 (RFC 1321)
+// ============================================================================
+
+constexpr uint32_t MD5_K[64] = {
+    0xD76AA478, 0xE8C7B756, 0x242070DB, 0xC1BDCEEE, 0xF57C0FAF, 0x4787C62A, 0xA8304613, 0xFD469501,
+    0x698098D8, 0x8B44F7AF, 0xFFFF5BB1, 0x895CD7BE, 0x6B901122, 0xFD987193, 0xA679438E, 0x49B40821,
+    0xF61E2562, 0xC040B340, 0x265E5A51, 0xE9B6C7AA, 0xD62F105D, 0x02441453, 0xD8A1E681, 0xE7D3FBC8,
+    0x21E1CDE6, 0xC33707D6, 0xF4D50D87, 0x455A14ED, 0xA9E3E905, 0xFCEFA3F8, 0x676F02D9, 0x8D2A4C8A,
+    0xFFFA3942, 0x8771F681, 0x6D9D6122, 0xFDE5380C, 0xA4BEEA44, 0x4BDECFA9, 0xF6BB4B60, 0xBEBFBC70,
+    0x289B7EC6, 0xEAA127FA, 0xD4EF3085, 0x04881D05, 0xD9D4D039, 0xE6DB99E5, 0x1FA27CF8, 0xC4AC5665,
+    0xF4292244, 0x432AFF97, 0xAB9423A7, 0xFC93A039, 0x655B59C3, 0x8F0CCC92, 0xFFEFF47D, 0x85845DD1,
+    0x6FA87E4F, 0xFE2CE6E0, 0xA3014314, 0x4E0811A1, 0xF7537E82, 0xBD3AF235, 0x2AD7D2BB, 0xEB86D391
+};
+
+constexpr int MD5_ROTATE[64] = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+};
+
+/// @return Message word used by MD5 step i
+constexpr int md5Word(int i) {
+    return i < 16 ? i : i < 32 ? (5 * i + 1) % 16 : i < 48 ? (3 * i + 5) % 16 : (7 * i) % 16;
+}
+
+template<class V, int i>
+MB_TARGET inline void md5Step(typename V::Vec* v, const typename V::Vec* w) {
+    constexpr int a = (64 - i) % 4, b = (65 - i) % 4, c = (66 - i) % 4, d = (67 - i) % 4;
+
+    typename V::Vec f;
+    if constexpr (i < 16) {
+        f = V::ch(v[b], v[c], v[d]);
+    } else if constexpr (i < 32) {
+        f = V::ch(v[d], v[b], v[c]);
+    } else if constexpr (i < 48) {
+        f = V::xor3(v[b], v[c], v[d]);
+    } else {
+        f = V::bxor(v[c], V::orNot(v[b], v[d]));
+    }
+    f = V::add(V::add(v[a], f), V::add(V::set1(MD5_K[i]), w[md5Word(i)]));
+    v[a] = V::add(v[b], V::template rotl<MD5_ROTATE[i]>(f));
+}
+
+template<class V, int... I>
+MB_TARGET inline void md5Rounds(typename V::Vec* s, const typename V::Vec* w,
+                                std::integer_sequence<int, I...>) {
+    typename V::Vec v[4] = {s[0], s[1], s[2], s[3]};
+    (md5Step<V, I>(v, w), ...);
+    for (int k = 0; k < 4; k++) {
+        s[k] = V::add(s[k], v[k]);
+    }
+}
+
+template<class V>
+MB_TARGET inline void compressBlock(Md5, typename V::Vec* s, typename V::Vec* w) {
+    md5Rounds<V>(s, w, std::make_integer_sequence<int, 64>());
+}
+
+// ============================================================================
+// SHA-1 (FIPS 180-4)
+// ============================================================================
+
+constexpr uint32_t SHA1_K[4] = {0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6};
+
+template<class V, int t>
+MB_TARGET inline void sha1Step(typename V::Vec* v, typename V::Vec* w) {
+    constexpr int a = (80 - t) % 5, b = (81 - t) % 5, c = (82 - t) % 5, d = (83 - t) % 5, e = (84 - t) % 5;
+
+    // Message schedule in a 16-word ring
+    if constexpr (t >= 16) {
+        w[t % 16] = V::template rotl<1>(
+            V::bxor(V::xor3(w[(t - 3) % 16], w[(t - 8) % 16], w[(t - 14) % 16]), w[t % 16]));
+    }
+
+    typename V::Vec f;
+    if constexpr (t < 20) {
+        f = V::ch(v[b], v[c], v[d]);
+    } else if constexpr (t >= 40 && t < 60) {
+        f = V::maj(v[b], v[c], v[d]);
+    } else {
+        f = V::xor3(v[b], v[c], v[d]);
+    }
+    v[e] = V::add(V::add(v[e], V::template rotl<5>(v[a])),
+                  V::add(f, V::add(V::set1(SHA1_K[t / 20]), w[t % 16])));
+    v[b] = V::template rotl<30>(v[b]);
+}
+
+template<class V, int... T>
+MB_TARGET inline void sha1Rounds(typename V::Vec* s, typename V::Vec* w,
+                                 std::integer_sequence<int, T...>) {
+    typename V::Vec v[5] = {s[0], s[1], s[2], s[3], s[4]};
+    (sha1Step<V, T>(v, w), ...);
+    for (int k = 0; k < 5; k++) {
+        s[k] = V::add(s[k], v[k]);
+    }
+}
+
+template<class V>
+MB_TARGET inline void compressBlock(Sha1, typename V::Vec* s, typename V::Vec* w) {
+    sha1Rounds<V>(s, w, std::make_integer_sequence<int, 80>());
+}
+
+// ============================================================================
+// SHA-256 (FIPS 180-4)
+// ============================================================================
+
+constexpr uint32_t SHA256_K[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+template<class V, int t>
+MB_TARGET inline void sha256Step(typename V::Vec* v, typename V::Vec* w) {
+    constexpr int a = (64 - t) % 8, b = (65 - t) % 8, c = (66 - t) % 8, d = (67 - t) % 8;
+    constexpr int e = (68 - t) % 8, f = (69 - t) % 8, g = (70 - t) % 8, h = (71 - t) % 8;
+    using Vec = typename V::Vec;
+
+    // Message schedule in a 16-word ring; right rotations by r are left rotations by 32 - r
+    if constexpr (t >= 16) {
+        const Vec w15 = w[(t - 15) % 16];
+        const Vec w2 = w[(t - 2) % 16];
+        const Vec s0 = V::xor3(V::template rotl<25>(w15), V::template rotl<14>(w15), V::template shr<3>(w15));
+        const Vec s1 = V::xor3(V::template rotl<15>(w2), V::template rotl<13>(w2), V::template shr<10>(w2));
+        w[t % 16] = V::add(V::add(w[t % 16], s0), V::add(w[(t - 7) % 16], s1));
+    }
+
+    const Vec S1 = V::xor3(V::template rotl<26>(v[e]), V::template rotl<21>(v[e]), V::template rotl<7>(v[e]));
+    const Vec S0 = V::xor3(V::template rotl<30>(v[a]), V::template rotl<19>(v[a]), V::template rotl<10>(v[a]));
+    const Vec t1 = V::add(V::add(v[h], S1),
+                          V::add(V::ch(v[e], v[f], v[g]), V::add(V::set1(SHA256_K[t]), w[t % 16])));
+    v[d] = V::add(v[d], t1);
+    v[h] = V::add(t1, V::add(S0, V::maj(v[a], v[b], v[c])));
+}
+
+template<class V, int... T>
+MB_TARGET inline void sha256Rounds(typename V::Vec* s, typename V::Vec* w,
+                                   std::integer_sequence<int, T...>) {
+    typename V::Vec v[8] = {s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7]};
+    (sha256Step<V, T>(v, w), ...);
+    for (int k = 0; k < 8; k++) {
+        s[k] = V::add(s[k], v[k]);
+    }
+}
+
+template<class V>
+MB_TARGET inline void compressBlock(Sha256, typename V::Vec* s, typename V::Vec* w) {
+    sha256Rounds<V>(s, w, std::make_integer_sequence<int, 64>());
+}
+
+// ============================================================================
+// RIPEMD-160 (Dobbertin, Bosselaers, Preneel)
+// ============================================================================
+
+// Message word and rotation of every step, left and right line
+constexpr int RMD_WORD_LEFT[80] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+    3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+    1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+    4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13
+};
+
+constexpr int RMD_WORD_RIGHT[80] = {
+    5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+    6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+    15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+    8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+    12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11
+};
+
+constexpr int RMD_ROTATE_LEFT[80] = {
+    11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+    7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+    11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+    11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+    9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6
+};
+
+constexpr int RMD_ROTATE_RIGHT[80] = {
+    8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+    9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+    9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+    15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+    8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11
+};
+
+constexpr uint32_t RMD_K_LEFT[5] = {0x00000000, 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xA953FD4E};
+constexpr uint32_t RMD_K_RIGHT[5] = {0x50A28BE6, 0x5C4DD124, 0x6D703EF3, 0x7A6D76E9, 0x00000000};
+
+/// @brief Boolean function of RIPEMD-160 round (0-4)
+template<class V, int round>
+MB_TARGET inline typename V::Vec ripemdF(typename V::Vec x, typename V::Vec y, typename V::Vec z) {
+    if constexpr (round == 0) {
+        return V::xor3(x, y, z);
+    } else if constexpr (round == 1) {
+        return V::ch(x, y, z);
+    } else if constexpr (round == 2) {
+        return V::bxor(V::orNot(x, y), z);
+    } else if constexpr (round == 3) {
+        return V::ch(z, x, y);
+    } else {
+        return V::bxor(x, V::orNot(y, z));
+    }
+}
+
+/// @brief Step j of one line: functions in order on the left line, reversed on the right
+template<class V, int j, bool right>
+MB_TARGET inline void ripemdStep(typename V::Vec* v, const typename V::Vec* w) {
+    constexpr int a = (80 - j) % 5, b = (81 - j) % 5, c = (82 - j) % 5, d = (83 - j) % 5, e = (84 - j) % 5;
+    constexpr int round = right ? 4 - j / 16 : j / 16;
+    constexpr uint32_t k = right ? RMD_K_RIGHT[j / 16] : RMD_K_LEFT[j / 16];
+    constexpr int word = right ? RMD_WORD_RIGHT[j] : RMD_WORD_LEFT[j];
+    constexpr int rotate = right ? RMD_ROTATE_RIGHT[j] : RMD_ROTATE_LEFT[j];
+
+    typename V::Vec x = V::add(V::add(v[a], ripemdF<V, round>(v[b], v[c], v[d])), w[word]);
+    if constexpr (k != 0) {
+        x = V::add(x, V::set1(k));
+    }
+    v[a] = V::add(V::template rotl<rotate>(x), v[e]);
+    v[c] = V::template rotl<10>(v[c]);
+}
+
+template<class V, int... J>
+MB_TARGET inline void ripemd160Rounds(typename V::Vec* s, const typename V::Vec* w,
+                                      std::integer_sequence<int, J...>) {
+    typename V::Vec left[5] = {s[0], s[1], s[2], s[3], s[4]};
+    typename V::Vec right[5] = {s[0], s[1], s[2], s[3], s[4]};
+    // The two lines are independent; interleaving them gives the CPU two dependency chains
+    ((ripemdStep<V, J, false>(left, w), ripemdStep<V, J, true>(right, w)), ...);
+
+    const typename V::Vec t = V::add(s[1], V::add(left[2], right[3]));
+    s[1] = V::add(s[2], V::add(left[3], right[4]));
+    s[2] = V::add(s[3], V::add(left[4], right[0]));
+    s[3] = V::add(s[4], V::add(left[0], right[1]));
+    s[4] = V::add(s[0], V::add(left[1], right[2]));
+    s[0] = t;
+}
+
+template<class V>
+MB_TARGET inline void compressBlock(Ripemd160, typename V::Vec* s, typename V::Vec* w) {
+    ripemd160Rounds<V>(s, w, std::make_integer_sequence<int, 80>());
+}
+
+// ============================================================================
+// Block loop
+// ============================================================================
+
+/// @brief Compress blocks blocks in V::LANES lanes whose words are stride apart in state
+template<class V, class Alg>
+MB_TARGET void compressLanes(uint32_t* state, size_t stride, const uint8_t* const* data, size_t blocks) {
+    using Vec = typename V::Vec;
+
+    Vec s[Alg::WORDS];
+    for (size_t i = 0; i < Alg::WORDS; i++) {
+        s[i] = V::load(state + i * stride);
+    }
+    const uint8_t* p[V::LANES];
+    for (size_t lane = 0; lane < V::LANES; lane++) {
+        p[lane] = data[lane];
+    }
+
+    for (size_t block = 0; block < blocks; block++) {
+        Vec w[16];
+        V::loadBlock(p, w);
+        if constexpr (Alg::BIG_ENDIAN_WORDS) {
+            for (int i = 0; i < 16; i++) {
+                w[i] = V::bswap(w[i]);
+            }
+        }
+        compressBlock<V>(Alg(), s, w);
+        for (size_t lane = 0; lane < V::LANES; lane++) {
+            p[lane] += BLOCK_SIZE;
+        }
+    }
+
+    for (size_t i = 0; i < Alg::WORDS; i++) {
+        V::store(state + i * stride, s[i]);
+    }
+}
+
+/// @brief Kernel body: all lanes, V::LANES at a time
+template<class V, class Alg>
+MB_TARGET void compressGroups(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    for (size_t group = 0; group < lanes; group += V::LANES) {
+        compressLanes<V, Alg>(state + group, lanes, data + group, blocks);
+    }
+}
+
+} // namespace
+
+} // namespace mb
+} // namespace impl
+} // namespace core
+
+#endif // MULTI_BUFFER_ROUNDS_H
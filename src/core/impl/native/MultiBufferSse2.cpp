@@ -0,0 +1,93 @@
+#include "MultiBufferKernels.h"
+
+#if defined(HASHCALC_X86)
+
+#include <emmintrin.h>
+
+#define MB_TARGET HASHCALC_TARGET("sse2")
+#include "MultiBufferRounds.h"
+
+namespace core {
+namespace impl {
+namespace mb {
+
+namespace {
+
+#define SSE2 MB_TARGET
+
+/// @brief Four lanes in an XMM register
+struct Sse2Ops {
+    using Vec = __m128i;
+    static constexpr size_t LANES = 4;
+
+    SSE2 static Vec load(const uint32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    SSE2 static void store(uint32_t* p, Vec x) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+    SSE2 static Vec set1(uint32_t x) { return _mm_set1_epi32(static_cast<int>(x)); }
+
+    SSE2 static Vec add(Vec x, Vec y) { return _mm_add_epi32(x, y); }
+    SSE2 static Vec bxor(Vec x, Vec y) { return _mm_xor_si128(x, y); }
+    SSE2 static Vec band(Vec x, Vec y) { return _mm_and_si128(x, y); }
+    SSE2 static Vec bor(Vec x, Vec y) { return _mm_or_si128(x, y); }
+    SSE2 static Vec orNot(Vec x, Vec y) { return _mm_or_si128(x, _mm_xor_si128(y, _mm_set1_epi32(-1))); }
+    SSE2 static Vec ch(Vec x, Vec y, Vec z) { return _mm_xor_si128(z, _mm_and_si128(x, _mm_xor_si128(y, z))); }
+    SSE2 static Vec maj(Vec x, Vec y, Vec z) {
+        return _mm_or_si128(_mm_and_si128(x, y), _mm_and_si128(z, _mm_or_si128(x, y)));
+    }
+    SSE2 static Vec xor3(Vec x, Vec y, Vec z) { return _mm_xor_si128(_mm_xor_si128(x, y), z); }
+
+    template<int n>
+    SSE2 static Vec rotl(Vec x) { return _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - n)); }
+
+    template<int n>
+    SSE2 static Vec shr(Vec x) { return _mm_srli_epi32(x, n); }
+
+    SSE2 static Vec bswap(Vec x) {
+        // Swap the 16-bit halves of each word, then the bytes of each half
+        x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xB1), 0xB1);
+        return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+    }
+
+    SSE2 static void loadBlock(const uint8_t* const* p, Vec w[16]) {
+        // Four 4x4 transposes, 16 bytes of every lane at a time
+        for (int g = 0; g < 4; g++) {
+            const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p[0] + 16 * g));
+            const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p[1] + 16 * g));
+            const __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p[2] + 16 * g));
+            const __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p[3] + 16 * g));
+            const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+            const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+            const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+            const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+            w[4 * g] = _mm_unpacklo_epi64(t0, t1);
+            w[4 * g + 1] = _mm_unpackhi_epi64(t0, t1);
+            w[4 * g + 2] = _mm_unpacklo_epi64(t2, t3);
+            w[4 * g + 3] = _mm_unpackhi_epi64(t2, t3);
+        }
+    }
+};
+
+} // namespace
+
+SSE2 void md5Sse2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Sse2Ops, Md5>(state, lanes, data, blocks);
+}
+
+SSE2 void sha1Sse2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Sse2Ops, Sha1>(state, lanes, data, blocks);
+}
+
+SSE2 void sha256Sse2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Sse2Ops, Sha256>(state, lanes, data, blocks);
+}
+
+SSE2 void ripemd160Sse2(uint32_t* state, size_t lanes, const uint8_t* const* data, size_t blocks) {
+    compressGroups<Sse2Ops, Ripemd160>(state, lanes, data, blocks);
+}
+
+#undef SSE2
+
+} // namespace mb
+} // namespace impl
+} // namespace core
+
+#endif // HASHCALC_X86
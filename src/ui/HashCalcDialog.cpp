@@ -6,9 +6,12 @@
 #include <Shellapi.h>
 #include "../core/HashAlgorithmFactory.h"
 #include "../core/IHashAlgorithm.h"
+#include "../core/MultiHasher.h"
+#include "../core/DigestCache.h"
 #include "../core/AlgorithmIds.h"
 #include <sstream>
 #include <chrono>
+#include <cstdint>
 #include <iomanip>
 #include <vector>
 #include <process.h>
@@ -79,6 +82,17 @@ void CHashCalcDialog::SetAutoStartCalculation(bool autoStart) {
   m_autoStartCalculation = autoStart;
 }
 
+void CHashCalcDialog::SetUseDigestCache(bool useCache) {
+  m_digestCache.reset();
+  if (useCache) {
+    try {
+      m_digestCache.reset(new core::DigestCache(core::DigestCache::defaultPath()));
+    } catch (const std::exception&) {
+      // Hashing works the same without the cache
+    }
+  }
+}
+
 BOOL CHashCalcDialog::PreTranslateMessage(MSG& msg) {
   // Handle Enter key in edit boxes
   if (msg.message == WM_KEYDOWN && msg.wParam == VK_RETURN) {
@@ -1306,117 +1320,71 @@ bool CHashCalcDialog::IsAlgorithmSelected(int algorithmId) {
   return (it != allStates.end() && it->second);
 }
 
-void CHashCalcDialog::ComputeHashAlgorithmsForText(
-    std::wstringstream& output, 
-    bool& anyComputed,
-    const std::string& inputData) {
-  
-  // Helper to compute a specific algorithm by name
-  auto computeAlgo = [&](const std::string &algoName, const std::string &displayName) {
-    // Check for cancellation
-    if (m_bCancelCalculation.load()) {
-      return;
-    }
-    
-    try {
-      if (core::HashAlgorithmFactory::isAvailable(algoName)) {
-        auto algo = core::HashAlgorithmFactory::create(algoName);
-        // Set cancel callback
-        algo->setCancelCallback([this]() { return m_bCancelCalculation.load(); });
-        auto digest = algo->computeString(inputData);
-        
-        // Format: Algorithm Name (padded) : Hash Value
-        std::wstring wDisplayName(displayName.begin(), displayName.end());
-        
-        output << std::left << std::setw(12) << wDisplayName << L": " 
-               << core::IHashAlgorithm::toHexWString(digest, true) << L"\r\n";
-        anyComputed = true;
-      } else {
-        // For unavailable algorithms, show "Not Available"
-        std::wstring wDisplayName(displayName.begin(), displayName.end());
-        output << std::left << std::setw(12) << wDisplayName << L": Not Available\r\n";
-      }
-    } catch (const std::exception &e) {
-      std::string errorMsg = e.what();
-      // Check if this is a cancellation
-      if (errorMsg.find("cancelled") != std::string::npos) {
-        throw; // Re-throw to stop all calculations
-      }
-      std::wstring wDisplayName(displayName.begin(), displayName.end());
-      std::string error = e.what();
-      std::wstring wError(error.begin(), error.end());
-      output << std::left << std::setw(12) << wDisplayName << L": Error";
-      if (!wError.empty()) {
-        output << L" - " << wError;
-      }
-      output << L"\r\n";
-    }
-  };
+std::vector<CHashCalcDialog::SelectedAlgorithm> CHashCalcDialog::CollectSelectedAlgorithms(bool fileOrder) {
+  std::vector<SelectedAlgorithm> selected;
 
-  // Helper to check ID and compute
-  auto checkAndCompute = [&](int id, const std::string &algoName, const std::string& displayName) {
+  // Helper to check ID and queue the algorithm
+  auto checkAndAdd = [&](int id, const std::string &algoName, const std::string& displayName) {
     if (IsAlgorithmSelected(id)) {
-      m_currentAlgorithmIndex++;
-      computeAlgo(algoName, displayName);
+      selected.push_back({algoName, displayName});
     }
   };
 
   // ========== Tab 1: SHA && MD (left to right order as shown in UI) ==========
   // SHA Family
-  checkAndCompute(IDC_SHA_160, "SHA-1", "SHA-160");
-  checkAndCompute(IDC_SHA_224, "SHA-224", "SHA-224");
-  checkAndCompute(IDC_SHA_256, "SHA-256", "SHA-256");
-  checkAndCompute(IDC_SHA_384, "SHA-384", "SHA-384");
-  checkAndCompute(IDC_SHA_512, "SHA-512", "SHA-512");
+  checkAndAdd(IDC_SHA_160, "SHA-1", "SHA-160");
+  checkAndAdd(IDC_SHA_224, "SHA-224", "SHA-224");
+  checkAndAdd(IDC_SHA_256, "SHA-256", "SHA-256");
+  checkAndAdd(IDC_SHA_384, "SHA-384", "SHA-384");
+  checkAndAdd(IDC_SHA_512, "SHA-512", "SHA-512");
 
   // MD Family
-  checkAndCompute(IDC_MD2, "MD2", "MD2");
-  checkAndCompute(IDC_MD4, "MD4", "MD4");
-  checkAndCompute(IDC_MD5, "MD5", "MD5");
+  checkAndAdd(IDC_MD2, "MD2", "MD2");
+  checkAndAdd(IDC_MD4, "MD4", "MD4");
+  checkAndAdd(IDC_MD5, "MD5", "MD5");
 
   // MD6 Family
-  checkAndCompute(IDC_MD6_128, "MD6-128", "MD6-128");
-  checkAndCompute(IDC_MD6_160, "MD6-160", "MD6-160");
-  checkAndCompute(IDC_MD6_192, "MD6-192", "MD6-192");
-  checkAndCompute(IDC_MD6_224, "MD6-224", "MD6-224");
-  checkAndCompute(IDC_MD6_256, "MD6-256", "MD6-256");
-  checkAndCompute(IDC_MD6_384, "MD6-384", "MD6-384");
-  checkAndCompute(IDC_MD6_512, "MD6-512", "MD6-512");
+  checkAndAdd(IDC_MD6_128, "MD6-128", "MD6-128");
+  checkAndAdd(IDC_MD6_160, "MD6-160", "MD6-160");
+  checkAndAdd(IDC_MD6_192, "MD6-192", "MD6-192");
+  checkAndAdd(IDC_MD6_224, "MD6-224", "MD6-224");
+  checkAndAdd(IDC_MD6_256, "MD6-256", "MD6-256");
+  checkAndAdd(IDC_MD6_384, "MD6-384", "MD6-384");
+  checkAndAdd(IDC_MD6_512, "MD6-512", "MD6-512");
 
   // ========== Tab 2: SHA-3 && Modern (left to right order as shown in UI) ==========
   // SHA-3
-  checkAndCompute(IDC_SHA3_224, "SHA3-224", "SHA3-224");
-  checkAndCompute(IDC_SHA3_256, "SHA3-256", "SHA3-256");
-  checkAndCompute(IDC_SHA3_384, "SHA3-384", "SHA3-384");
-  checkAndCompute(IDC_SHA3_512, "SHA3-512", "SHA3-512");
+  checkAndAdd(IDC_SHA3_224, "SHA3-224", "SHA3-224");
+  checkAndAdd(IDC_SHA3_256, "SHA3-256", "SHA3-256");
+  checkAndAdd(IDC_SHA3_384, "SHA3-384", "SHA3-384");
+  checkAndAdd(IDC_SHA3_512, "SHA3-512", "SHA3-512");
 
   // Keccak
-  checkAndCompute(IDC_KECCAK_224, "Keccak-224", "Keccak-224");
-  checkAndCompute(IDC_KECCAK_256, "Keccak-256", "Keccak-256");
-  checkAndCompute(IDC_KECCAK_384, "Keccak-384", "Keccak-384");
-  checkAndCompute(IDC_KECCAK_512, "Keccak-512", "Keccak-512");
+  checkAndAdd(IDC_KECCAK_224, "Keccak-224", "Keccak-224");
+  checkAndAdd(IDC_KECCAK_256, "Keccak-256", "Keccak-256");
+  checkAndAdd(IDC_KECCAK_384, "Keccak-384", "Keccak-384");
+  checkAndAdd(IDC_KECCAK_512, "Keccak-512", "Keccak-512");
 
   // SHAKE
-  checkAndCompute(IDC_SHAKE_128, "SHAKE128", "SHAKE-128");
-  checkAndCompute(IDC_SHAKE_256, "SHAKE256", "SHAKE-256");
+  checkAndAdd(IDC_SHAKE_128, "SHAKE128", "SHAKE-128");
+  checkAndAdd(IDC_SHAKE_256, "SHAKE256", "SHAKE-256");
 
   // BLAKE2
-  checkAndCompute(IDC_BLAKE2B, "BLAKE2b", "BLAKE2b");
-  checkAndCompute(IDC_BLAKE2S, "BLAKE2s", "BLAKE2s");
+  checkAndAdd(IDC_BLAKE2B, "BLAKE2b", "BLAKE2b");
+  checkAndAdd(IDC_BLAKE2S, "BLAKE2s", "BLAKE2s");
 
   // BLAKE3
-  checkAndCompute(IDC_BLAKE3, "BLAKE3", "BLAKE3");
+  checkAndAdd(IDC_BLAKE3, "BLAKE3", "BLAKE3");
 
   // ========== Tab 3: HAVAL && RIPEMD (left to right order as shown in UI) ==========
   // HAVAL Family
   // Compute for each selected pass count
-  auto checkAndComputeHaval = [&](int id, int bits, int passes) {
+  auto checkAndAddHaval = [&](int id, int bits, int passes) {
     if (IsAlgorithmSelected(id)) {
-      m_currentAlgorithmIndex++;
       std::stringstream algoName, displayName;
       algoName << "HAVAL-" << bits << "/Pass" << passes;
       displayName << "HAVAL-" << bits << "/" << passes;
-      computeAlgo(algoName.str(), displayName.str());
+      selected.push_back({algoName.str(), displayName.str()});
     }
   };
 
@@ -1436,96 +1404,70 @@ void CHashCalcDialog::ComputeHashAlgorithmsForText(
 
   // Compute HAVAL for each selected bit size and pass combination
   for (int passes : selectedPasses) {
-    checkAndComputeHaval(IDC_HAVAL_128, 128, passes);
-    checkAndComputeHaval(IDC_HAVAL_160, 160, passes);
-    checkAndComputeHaval(IDC_HAVAL_192, 192, passes);
-    checkAndComputeHaval(IDC_HAVAL_224, 224, passes);
-    checkAndComputeHaval(IDC_HAVAL_256, 256, passes);
+    checkAndAddHaval(IDC_HAVAL_128, 128, passes);
+    checkAndAddHaval(IDC_HAVAL_160, 160, passes);
+    checkAndAddHaval(IDC_HAVAL_192, 192, passes);
+    checkAndAddHaval(IDC_HAVAL_224, 224, passes);
+    checkAndAddHaval(IDC_HAVAL_256, 256, passes);
   }
 
   // RIPEMD
-  checkAndCompute(IDC_RIPEMD_128, "RIPEMD-128", "RIPEMD-128");
-  checkAndCompute(IDC_RIPEMD_160, "RIPEMD-160", "RIPEMD-160");
-  checkAndCompute(IDC_RIPEMD_256, "RIPEMD-256", "RIPEMD-256");
-  checkAndCompute(IDC_RIPEMD_320, "RIPEMD-320", "RIPEMD-320");
+  checkAndAdd(IDC_RIPEMD_128, "RIPEMD-128", "RIPEMD-128");
+  checkAndAdd(IDC_RIPEMD_160, "RIPEMD-160", "RIPEMD-160");
+  checkAndAdd(IDC_RIPEMD_256, "RIPEMD-256", "RIPEMD-256");
+  checkAndAdd(IDC_RIPEMD_320, "RIPEMD-320", "RIPEMD-320");
 
   // ========== Tab 4: Checksum && Others (left to right order as shown in UI) ==========
   // Checksum
-  checkAndCompute(IDC_CRC8, "CRC-8", "CRC-8");
-  checkAndCompute(IDC_CRC16, "CRC-16", "CRC-16");
-  checkAndCompute(IDC_CRC32, "CRC32", "CRC-32");
-  checkAndCompute(IDC_CRC32C, "CRC-32C", "CRC-32C");
-  checkAndCompute(IDC_CRC64, "CRC-64", "CRC-64");
-  checkAndCompute(IDC_ADLER32, "Adler32", "Adler-32");
+  checkAndAdd(IDC_CRC8, "CRC-8", "CRC-8");
+  checkAndAdd(IDC_CRC16, "CRC-16", "CRC-16");
+  checkAndAdd(IDC_CRC32, "CRC32", "CRC-32");
+  checkAndAdd(IDC_CRC32C, "CRC-32C", "CRC-32C");
+  checkAndAdd(IDC_CRC64, "CRC-64", "CRC-64");
+  checkAndAdd(IDC_ADLER32, "Adler32", "Adler-32");
 
   // Others
-  checkAndCompute(IDC_TIGER, "Tiger", "Tiger");
-  checkAndCompute(IDC_WHIRLPOOL, "Whirlpool", "Whirlpool");
-  checkAndCompute(IDC_SM3, "SM3", "SM3");
-  checkAndCompute(IDC_LSH_256, "LSH-256", "LSH-256");
-  checkAndCompute(IDC_LSH_512, "LSH-512", "LSH-512");
-  checkAndCompute(IDC_GOST94, "GOST-R-34.11-94", "GOST-94");
-  checkAndCompute(IDC_GOST2012_256, "GOST-R-34.11-2012-256", "GOST-256");
-  checkAndCompute(IDC_GOST2012_512, "GOST-R-34.11-2012-512", "GOST-512");
+  checkAndAdd(IDC_TIGER, "Tiger", "Tiger");
+  checkAndAdd(IDC_WHIRLPOOL, "Whirlpool", "Whirlpool");
+  // File results have always listed LSH-256 before SM3, text results after it
+  if (fileOrder) {
+    checkAndAdd(IDC_LSH_256, "LSH-256", "LSH-256");
+    checkAndAdd(IDC_SM3, "SM3", "SM3");
+  } else {
+    checkAndAdd(IDC_SM3, "SM3", "SM3");
+    checkAndAdd(IDC_LSH_256, "LSH-256", "LSH-256");
+  }
+  checkAndAdd(IDC_LSH_512, "LSH-512", "LSH-512");
+  checkAndAdd(IDC_GOST94, "GOST-R-34.11-94", "GOST-94");
+  checkAndAdd(IDC_GOST2012_256, "GOST-R-34.11-2012-256", "GOST-256");
+  checkAndAdd(IDC_GOST2012_512, "GOST-R-34.11-2012-512", "GOST-512");
+
+  return selected;
 }
 
-void CHashCalcDialog::ComputeHashAlgorithmsForFile(
-    std::wstringstream& output,
+void CHashCalcDialog::ComputeHashAlgorithmsForText(
+    std::wstringstream& output, 
     bool& anyComputed,
-    const std::wstring& filePath) {
-
-  // Helper to compute a specific algorithm by name for file
+    const std::string& inputData) {
+  
+  // Helper to compute a specific algorithm by name
   auto computeAlgo = [&](const std::string &algoName, const std::string &displayName) {
     // Check for cancellation
     if (m_bCancelCalculation.load()) {
       return;
     }
-
+    
     try {
       if (core::HashAlgorithmFactory::isAvailable(algoName)) {
         auto algo = core::HashAlgorithmFactory::create(algoName);
         // Set cancel callback
         algo->setCancelCallback([this]() { return m_bCancelCalculation.load(); });
-
-        // Set progress callback
-        algo->setProgressCallback([this, displayName](uint64_t bytesProcessed, uint64_t totalBytes) {
-          ProgressData* pData = new ProgressData();
-          pData->algorithmName = std::wstring(displayName.begin(), displayName.end());
-          pData->bytesProcessed = bytesProcessed;
-          pData->totalBytes = totalBytes;
-          pData->algorithmIndex = m_currentAlgorithmIndex;
-          pData->totalAlgorithms = m_totalAlgorithms;
-          PostMessage(WM_HASH_PROGRESS, reinterpret_cast<WPARAM>(pData), 0);
-        });
-
-        // Send progress update at algorithm start (0%)
-        {
-          ProgressData* pData = new ProgressData();
-          pData->algorithmName = std::wstring(displayName.begin(), displayName.end());
-          pData->bytesProcessed = 0;
-          pData->totalBytes = 1; // Avoid division by zero
-          pData->algorithmIndex = m_currentAlgorithmIndex;
-          pData->totalAlgorithms = m_totalAlgorithms;
-          PostMessage(WM_HASH_PROGRESS, reinterpret_cast<WPARAM>(pData), 0);
-        }
-
-        auto digest = algo->computeFile(filePath);
-
-        // Send progress update at algorithm completion (100%)
-        {
-          ProgressData* pData = new ProgressData();
-          pData->algorithmName = std::wstring(displayName.begin(), displayName.end());
-          pData->bytesProcessed = 1;
-          pData->totalBytes = 1; // 100%
-          pData->algorithmIndex = m_currentAlgorithmIndex;
-          pData->totalAlgorithms = m_totalAlgorithms;
-          PostMessage(WM_HASH_PROGRESS, reinterpret_cast<WPARAM>(pData), 0);
-        }
-
+        auto digest = algo->computeString(inputData);
+        
         // Format: Algorithm Name (padded) : Hash Value
         std::wstring wDisplayName(displayName.begin(), displayName.end());
-
-        output << std::left << std::setw(12) << wDisplayName << L": "
+        
+        output << std::left << std::setw(12) << wDisplayName << L": " 
                << core::IHashAlgorithm::toHexWString(digest, true) << L"\r\n";
         anyComputed = true;
       } else {
@@ -1550,120 +1492,105 @@ void CHashCalcDialog::ComputeHashAlgorithmsForFile(
     }
   };
 
-  // Helper to check ID and compute
-  auto checkAndCompute = [&](int id, const std::string &algoName, const std::string& displayName) {
-    if (IsAlgorithmSelected(id)) {
-      m_currentAlgorithmIndex++;
-      computeAlgo(algoName, displayName);
-    }
-  };
-
-  // ========== Tab 1: SHA && MD (left to right order as shown in UI) ==========
-  // SHA Family
-  checkAndCompute(IDC_SHA_160, "SHA-1", "SHA-160");
-  checkAndCompute(IDC_SHA_224, "SHA-224", "SHA-224");
-  checkAndCompute(IDC_SHA_256, "SHA-256", "SHA-256");
-  checkAndCompute(IDC_SHA_384, "SHA-384", "SHA-384");
-  checkAndCompute(IDC_SHA_512, "SHA-512", "SHA-512");
-
-  // MD Family
-  checkAndCompute(IDC_MD2, "MD2", "MD2");
-  checkAndCompute(IDC_MD4, "MD4", "MD4");
-  checkAndCompute(IDC_MD5, "MD5", "MD5");
-
-  // MD6 Family
-  checkAndCompute(IDC_MD6_128, "MD6-128", "MD6-128");
-  checkAndCompute(IDC_MD6_160, "MD6-160", "MD6-160");
-  checkAndCompute(IDC_MD6_192, "MD6-192", "MD6-192");
-  checkAndCompute(IDC_MD6_224, "MD6-224", "MD6-224");
-  checkAndCompute(IDC_MD6_256, "MD6-256", "MD6-256");
-  checkAndCompute(IDC_MD6_384, "MD6-384", "MD6-384");
-  checkAndCompute(IDC_MD6_512, "MD6-512", "MD6-512");
+  for (const SelectedAlgorithm& algo : CollectSelectedAlgorithms(false)) {
+    m_currentAlgorithmIndex++;
+    computeAlgo(algo.factoryName, algo.displayName);
+  }
+}
 
-  // ========== Tab 2: SHA-3 && Modern (left to right order as shown in UI) ==========
-  // SHA-3
-  checkAndCompute(IDC_SHA3_224, "SHA3-224", "SHA3-224");
-  checkAndCompute(IDC_SHA3_256, "SHA3-256", "SHA3-256");
-  checkAndCompute(IDC_SHA3_384, "SHA3-384", "SHA3-384");
-  checkAndCompute(IDC_SHA3_512, "SHA3-512", "SHA3-512");
+void CHashCalcDialog::ComputeHashAlgorithmsForFile(
+    std::wstringstream& output,
+    bool& anyComputed,
+    const std::wstring& filePath) {
 
-  // Keccak
-  checkAndCompute(IDC_KECCAK_224, "Keccak-224", "Keccak-224");
-  checkAndCompute(IDC_KECCAK_256, "Keccak-256", "Keccak-256");
-  checkAndCompute(IDC_KECCAK_384, "Keccak-384", "Keccak-384");
-  checkAndCompute(IDC_KECCAK_512, "Keccak-512", "Keccak-512");
+  std::vector<SelectedAlgorithm> selected = CollectSelectedAlgorithms(true);
 
-  // SHAKE
-  checkAndCompute(IDC_SHAKE_128, "SHAKE128", "SHAKE-128");
-  checkAndCompute(IDC_SHAKE_256, "SHAKE256", "SHAKE-256");
+  // Instantiate every available algorithm up front so the file is read only
+  // once and each block is fed to all of them while it is still in cache
+  core::MultiHasher hasher;
+  std::vector<size_t> digestIndex(selected.size(), SIZE_MAX);
+  std::vector<std::string> errors(selected.size());
+  std::vector<std::string> factoryNames; // In add() order, for the digest cache
 
-  // BLAKE2
-  checkAndCompute(IDC_BLAKE2B, "BLAKE2b", "BLAKE2b");
-  checkAndCompute(IDC_BLAKE2S, "BLAKE2s", "BLAKE2s");
+  for (size_t i = 0; i < selected.size(); i++) {
+    if (!core::HashAlgorithmFactory::isAvailable(selected[i].factoryName)) {
+      continue;
+    }
+    try {
+      digestIndex[i] = hasher.add(core::HashAlgorithmFactory::create(selected[i].factoryName));
+      factoryNames.push_back(selected[i].factoryName);
+    } catch (const std::exception &e) {
+      errors[i] = e.what();
+    }
+  }
 
-  // BLAKE3
-  checkAndCompute(IDC_BLAKE3, "BLAKE3", "BLAKE3");
+  if (m_digestCache) {
+    hasher.setDigestCache(m_digestCache.get(), factoryNames);
+  }
 
-  // ========== Tab 3: HAVAL && RIPEMD (left to right order as shown in UI) ==========
-  // HAVAL Family
-  // Compute for each selected pass count
-  auto checkAndComputeHaval = [&](int id, int bits, int passes) {
-    if (IsAlgorithmSelected(id)) {
-      m_currentAlgorithmIndex++;
-      std::stringstream algoName, displayName;
-      algoName << "HAVAL-" << bits << "/Pass" << passes;
-      displayName << "HAVAL-" << bits << "/" << passes;
-      computeAlgo(algoName.str(), displayName.str());
+  std::vector<std::vector<uint8_t>> digests;
+  if (!hasher.empty()) {
+    // Single progress stream for the whole set of algorithms
+    std::wstring progressName;
+    if (hasher.size() == 1) {
+      for (size_t i = 0; i < selected.size(); i++) {
+        if (digestIndex[i] != SIZE_MAX) {
+          progressName = std::wstring(selected[i].displayName.begin(), selected[i].displayName.end());
+        }
+      }
+    } else {
+      progressName = std::to_wstring(hasher.size()) + L" algorithms";
     }
-  };
 
-  // Check which passes are selected and compute for each
-  std::vector<int> selectedPasses;
-  bool pass3, pass4, pass5;
-  m_pViewHAVAL->GetHavalPassStates(pass3, pass4, pass5);
+    m_currentAlgorithmIndex = 1;
+    m_totalAlgorithms = 1;
 
-  if (pass3) selectedPasses.push_back(3);
-  if (pass4) selectedPasses.push_back(4);
-  if (pass5) selectedPasses.push_back(5);
+    hasher.setCancelCallback([this]() { return m_bCancelCalculation.load(); });
+    hasher.setProgressCallback([this, progressName](uint64_t bytesProcessed, uint64_t totalBytes) {
+      ProgressData* pData = new ProgressData();
+      pData->algorithmName = progressName;
+      pData->bytesProcessed = bytesProcessed;
+      pData->totalBytes = totalBytes;
+      pData->algorithmIndex = m_currentAlgorithmIndex;
+      pData->totalAlgorithms = m_totalAlgorithms;
+      PostMessage(WM_HASH_PROGRESS, reinterpret_cast<WPARAM>(pData), 0);
+    });
 
-  // If no pass is selected, default to 3-pass
-  if (selectedPasses.empty()) {
-    selectedPasses.push_back(3);
+    try {
+      digests = hasher.computeFile(filePath);
+    } catch (const std::exception &e) {
+      std::string errorMsg = e.what();
+      // Check if this is a cancellation
+      if (errorMsg.find("cancelled") != std::string::npos) {
+        throw; // Re-throw to stop all calculations
+      }
+      // A read error affects every algorithm in the set
+      for (size_t i = 0; i < selected.size(); i++) {
+        if (digestIndex[i] != SIZE_MAX) {
+          errors[i] = errorMsg;
+          digestIndex[i] = SIZE_MAX;
+        }
+      }
+    }
   }
 
-  // Compute HAVAL for each selected bit size and pass combination
-  for (int passes : selectedPasses) {
-    checkAndComputeHaval(IDC_HAVAL_128, 128, passes);
-    checkAndComputeHaval(IDC_HAVAL_160, 160, passes);
-    checkAndComputeHaval(IDC_HAVAL_192, 192, passes);
-    checkAndComputeHaval(IDC_HAVAL_224, 224, passes);
-    checkAndComputeHaval(IDC_HAVAL_256, 256, passes);
+  for (size_t i = 0; i < selected.size(); i++) {
+    // Format: Algorithm Name (padded) : Hash Value
+    std::wstring wDisplayName(selected[i].displayName.begin(), selected[i].displayName.end());
+    output << std::left << std::setw(12) << wDisplayName << L": ";
+
+    if (digestIndex[i] != SIZE_MAX) {
+      output << core::IHashAlgorithm::toHexWString(digests[digestIndex[i]], true);
+      anyComputed = true;
+    } else if (!errors[i].empty()) {
+      std::wstring wError(errors[i].begin(), errors[i].end());
+      output << L"Error - " << wError;
+    } else {
+      // For unavailable algorithms, show "Not Available"
+      output << L"Not Available";
+    }
+    output << L"\r\n";
   }
-
-  // RIPEMD
-  checkAndCompute(IDC_RIPEMD_128, "RIPEMD-128", "RIPEMD-128");
-  checkAndCompute(IDC_RIPEMD_160, "RIPEMD-160", "RIPEMD-160");
-  checkAndCompute(IDC_RIPEMD_256, "RIPEMD-256", "RIPEMD-256");
-  checkAndCompute(IDC_RIPEMD_320, "RIPEMD-320", "RIPEMD-320");
-
-  // ========== Tab 4: Checksum && Others (left to right order as shown in UI) ==========
-  // Checksum
-  checkAndCompute(IDC_CRC8, "CRC-8", "CRC-8");
-  checkAndCompute(IDC_CRC16, "CRC-16", "CRC-16");
-  checkAndCompute(IDC_CRC32, "CRC32", "CRC-32");
-  checkAndCompute(IDC_CRC32C, "CRC-32C", "CRC-32C");
-  checkAndCompute(IDC_CRC64, "CRC-64", "CRC-64");
-  checkAndCompute(IDC_ADLER32, "Adler32", "Adler-32");
-
-  // Others
-  checkAndCompute(IDC_TIGER, "Tiger", "Tiger");
-  checkAndCompute(IDC_WHIRLPOOL, "Whirlpool", "Whirlpool");
-  checkAndCompute(IDC_LSH_256, "LSH-256", "LSH-256");
-  checkAndCompute(IDC_SM3, "SM3", "SM3");
-  checkAndCompute(IDC_LSH_512, "LSH-512", "LSH-512");
-  checkAndCompute(IDC_GOST94, "GOST-R-34.11-94", "GOST-94");
-  checkAndCompute(IDC_GOST2012_256, "GOST-R-34.11-2012-256", "GOST-256");
-  checkAndCompute(IDC_GOST2012_512, "GOST-R-34.11-2012-512", "GOST-512");
 }
 
 // ============================================================================
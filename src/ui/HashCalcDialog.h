@@ -13,12 +13,14 @@
 #include <memory>
 #include <vector>
 #include <sstream>
+#include <string>
 #include <shobjidl.h>
 #include <wrl/client.h>
 
 // Forward declarations
 namespace core {
   class IHashAlgorithm;
+  class DigestCache;
 }
 
 // Custom message for hash calculation completion
@@ -49,6 +51,9 @@ public:
   // Set auto-start calculation flag
   void SetAutoStartCalculation(bool autoStart);
 
+  // Reuse digests of unchanged files from the persistent digest cache
+  void SetUseDigestCache(bool useCache);
+
 protected:
   // Virtual function overrides
   virtual BOOL OnInitDialog() override;
@@ -76,7 +81,14 @@ private:
   bool HasValidInput(); // Check if input is valid
   static DWORD WINAPI CalculateHashThread(LPVOID lpParam);
   
+  // Algorithm selected for calculation
+  struct SelectedAlgorithm {
+    std::string factoryName;  // Name registered in HashAlgorithmFactory
+    std::string displayName;  // Name shown in the result output
+  };
+
   // Refactored helper methods
+  std::vector<SelectedAlgorithm> CollectSelectedAlgorithms(bool fileOrder); // Selected algorithms in UI order (file mode lists LSH-256 before SM3)
   void SetCheckboxStates(const int* ids, size_t count, bool checked);
   void EnableControlsById(const int* ids, size_t count, bool enable);
   void ComputeHashAlgorithmsForText(std::wstringstream& output, bool& anyComputed, const std::string& inputData);
@@ -154,6 +166,9 @@ private:
   bool m_cmdLineHavalPass3;
   bool m_cmdLineHavalPass4;
   bool m_cmdLineHavalPass5;
+
+  // Digest cache for file hashing (null unless --cache was given and the cache could be opened)
+  std::unique_ptr<core::DigestCache> m_digestCache;
 };
 
 #endif // HASH_CALC_DIALOG_H
@@ -10,14 +10,24 @@
 #include "ConfigManager.h"
 #include "../core/HashAlgorithmFactory.h"
 #include "../core/IHashAlgorithm.h"
+#include "../core/BaoOutboard.h"
+#include "../core/BatchHasher.h"
+#include "../core/CheckpointFile.h"
+#include "../core/DigestCache.h"
+#include "../core/MultiHasher.h"
+#include "../core/ThreadPool.h"
 #include "../core/AlgorithmIds.h"
 #include "../../res/resource.h"
 #include <iostream>
+#include <cctype>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <io.h>
 #include <fcntl.h>
 #include <conio.h>
 #include <objbase.h>
+#include <shellapi.h>
 
 namespace utils {
 
@@ -108,34 +118,38 @@ CommandLineParser::ParsedArgs CommandLineParser::Parse(LPWSTR lpCmdLine) {
 
   std::wstring cmdLine(lpCmdLine);
 
+  // Flags are matched as whole arguments so that paths like "my-cat.txt"
+  // or text like "a -c b" are not mistaken for options
+  std::vector<std::wstring> tokens = Tokenize(cmdLine);
+
   // Check for help and list flags
-  if (cmdLine.find(L"--help") != std::wstring::npos ||
-      cmdLine.find(L"-h") != std::wstring::npos ||
-      cmdLine.find(L"/?") != std::wstring::npos) {
+  if (HasFlag(tokens, L"-h", L"--help") || HasFlag(tokens, L"/?", nullptr)) {
     args.mode = Mode::Console;
     args.isHelp = true;
     return args;
   }
 
-  if (cmdLine.find(L"--list") != std::wstring::npos ||
-      cmdLine.find(L"-l") != std::wstring::npos) {
+  if (HasFlag(tokens, L"-l", L"--list")) {
     args.mode = Mode::Console;
     args.isList = true;
     return args;
   }
 
   // Check for --all flag
-  if (cmdLine.find(L"--all") != std::wstring::npos ||
-      cmdLine.find(L"-A") != std::wstring::npos) {
+  if (HasFlag(tokens, L"-A", L"--all")) {
     args.allAlgorithms = true;
   }
 
   // Check for --lowercase flag
-  if (cmdLine.find(L"--lowercase") != std::wstring::npos ||
-      cmdLine.find(L"-c") != std::wstring::npos) {
+  if (HasFlag(tokens, L"-c", L"--lowercase")) {
     args.lowercase = true;
   }
 
+  // Check for --cache flag
+  if (HasFlag(tokens, L"--cache", nullptr)) {
+    args.useCache = true;
+  }
+
   // Parse based on mode
   if (IsConsoleMode(lpCmdLine)) {
     args.mode = Mode::Console;
@@ -159,11 +173,29 @@ void CommandLineParser::PrintHelp() {
   printf("  -h, --help                Display this help information\n");
   printf("  -l, --list                List all supported hash algorithms\n");
   printf("  -f, --file <path>         Console: Calculate hash of file (requires -a or -A)\n");
+  printf("                            Further paths after the options are hashed too\n");
+  printf("  -r, --recursive <dir>     Console: Hash every file below a directory\n");
+  printf("  -j, --jobs <n>            Console: Worker threads for -r/multiple files\n");
+  printf("                            (default: CPUs available to the process)\n");
   printf("  -t, --text <content>      Console: Calculate hash of text (requires -a or -A)\n");
   printf("  -a, --algorithm <algo>    Specify algorithm (can use multiple times)\n");
   printf("                            Examples: MD5, SHA256, SHA3-256, BLAKE3\n");
   printf("  -A, --all                 Use all available algorithms (GUI and console)\n");
-  printf("  -c, --lowercase           Output hash in lowercase (default: uppercase)\n\n");
+  printf("  -c, --lowercase           Output hash in lowercase (default: uppercase)\n");
+  printf("  --io <mode>               Console: File input backend (auto, read, mmap,\n");
+  printf("                            direct, ioring)\n");
+  printf("  --cache                   Reuse digests of unchanged files from the digest\n");
+  printf("                            cache and record new ones (GUI and console)\n");
+  printf("  --cache-file <path>       Console: Use this digest cache file (implies --cache)\n");
+  printf("  --resume <checkpoint>     Console: Save progress of a single file to a\n");
+  printf("                            checkpoint and continue from it when rerun\n");
+  printf("  --append                  Console: Hash only data appended to files since\n");
+  printf("                            they were last hashed (implies --cache)\n");
+  printf("  --outboard <path>         Console: Write the BLAKE3 hash tree of a single\n");
+  printf("                            file to an outboard file and print its root\n");
+  printf("  --verify-range <off>:<len>  Console: Check that slice of the file against\n");
+  printf("                            --root using the outboard (reads only that part)\n");
+  printf("  --root <hex>              Console: BLAKE3 root hash for --verify-range\n\n");
   printf("Examples:\n");
   printf("  HashCalc.exe test.txt              # GUI mode, auto-detect file\n");
   printf("  HashCalc.exe \"Hello World\"         # GUI mode, treat as text\n");
@@ -172,13 +204,35 @@ void CommandLineParser::PrintHelp() {
   printf("  HashCalc.exe -f test.txt -a SHA256 -a MD5  # Console mode\n");
   printf("  HashCalc.exe -f test.txt -A        # Console mode with all algorithms\n");
   printf("  HashCalc.exe -t \"text\" -a BLAKE3   # Console mode\n");
-  printf("  HashCalc.exe -f test.txt -a SHA256 -c  # Console mode, lowercase output\n\n");
+  printf("  HashCalc.exe -f test.txt -a SHA256 -c  # Console mode, lowercase output\n");
+  printf("  HashCalc.exe -f big.iso -a SHA256 --io mmap  # Console mode, memory-mapped input\n");
+  printf("  HashCalc.exe -f vol.img -a SHA256 --io direct  # Console mode, bypass the file cache\n");
+  printf("  HashCalc.exe -r C:\\data -a SHA256 -j 8  # Console mode, whole tree on 8 threads\n");
+  printf("  HashCalc.exe -f a.bin b.bin c.bin -a MD5  # Console mode, several files\n");
+  printf("  HashCalc.exe -r D:\\backup -a SHA256 --cache  # Console mode, skip unchanged files\n");
+  printf("  HashCalc.exe -f disk.img -a BLAKE3 --resume disk.ckpt  # Console mode, resumable\n");
+  printf("  HashCalc.exe -r D:\\logs -a BLAKE3 --append  # Console mode, growing logs\n");
+  printf("  HashCalc.exe -f big.iso --outboard big.obao  # Console mode, write hash tree\n");
+  printf("  HashCalc.exe -f big.iso --outboard big.obao --verify-range 4096:1048576 --root <hex>\n\n");
   printf("Notes:\n");
   printf("  - GUI mode: Use config algorithms if -a/-A not specified\n");
   printf("  - Console mode (-t/-f): Must specify at least one -a algorithm or use -A\n");
   printf("  - Paths/text with spaces should be quoted\n");
   printf("  - For HAVAL algorithms, -A includes all pass variants (3, 4, 5)\n");
-  printf("  - Console mode outputs uppercase hex by default, use -c for lowercase\n\n");
+  printf("  - Console mode outputs uppercase hex by default, use -c for lowercase\n");
+  printf("  - --io auto maps files of 16 MB and more, and streams smaller ones\n");
+  printf("  - With -r or several files, results are printed in a fixed order (sorted by\n");
+  printf("    name within each directory) and hard links are hashed only once\n");
+  printf("  - --cache identifies files by volume and file ID, size, write time and change\n");
+  printf("    time; the default cache is %%LOCALAPPDATA%%\\HashCalc\\digests.cache\n");
+  printf("  - --resume checkpoints every 1 GB and works with BLAKE3, MD6, HAVAL, SHA-3,\n");
+  printf("    Keccak, GOST, CRC-8, CRC-16, CRC32, CRC-32C and CRC-64; the checkpoint is\n");
+  printf("    deleted when done\n");
+  printf("  - --append needs the same algorithms as --resume; a file is continued only\n");
+  printf("    if it grew and its last 64 KB hashed before are unchanged\n");
+  printf("  - --outboard needs no -a; the tree has 16 KB leaves and costs 0.4%% of the\n");
+  printf("    file size, and --verify-range reads the covered leaves plus about 64 bytes\n");
+  printf("    of outboard per tree level\n\n");
 }
 
 void CommandLineParser::PrintAlgorithmList() {
@@ -186,7 +240,8 @@ void CommandLineParser::PrintAlgorithmList() {
 
   printf("MD Family:\n");
   printf("  MD2, MD4, MD5\n");
-  printf("  MD6-128, MD6-160, MD6-192, MD6-224, MD6-256, MD6-384, MD6-512\n\n");
+  printf("  MD6-128, MD6-160, MD6-192, MD6-224, MD6-256, MD6-384, MD6-512\n");
+  printf("  (mode and rounds by name, e.g. -a MD6-256/L=0 or -a MD6-512/L=4/r=100)\n\n");
 
   printf("SHA Family:\n");
   printf("  SHA-1, SHA-224, SHA-256, SHA-384, SHA-512\n\n");
@@ -216,6 +271,13 @@ void CommandLineParser::PrintAlgorithmList() {
 
   printf("Checksums:\n");
   printf("  CRC-8, CRC-16, CRC32, CRC-32C, CRC-64, Adler32\n\n");
+
+  printf("CRC Catalogue (by full name, e.g. -a CRC-16/MODBUS):\n");
+  printf("  CRC-8/MAXIM-DOW, CRC-8/AUTOSAR, CRC-8/BLUETOOTH\n");
+  printf("  CRC-16/ARC, CRC-16/MODBUS, CRC-16/USB, CRC-16/KERMIT, CRC-16/XMODEM,\n");
+  printf("  CRC-16/IBM-SDLC, CRC-16/GENIBUS, CRC-24/OPENPGP\n");
+  printf("  CRC-32/BZIP2, CRC-32/MPEG-2, CRC-32/CKSUM, CRC-32/JAMCRC, CRC-32/AUTOSAR\n");
+  printf("  CRC-64/XZ, CRC-64/GO-ISO, CRC-64/WE, CRC-64/NVME\n\n");
 }
 
 int CommandLineParser::RunConsoleMode(LPWSTR lpCmdLine) {
@@ -251,6 +313,20 @@ int CommandLineParser::RunConsoleMode(LPWSTR lpCmdLine) {
     return 0;
   }
 
+  // Handle --outboard (always BLAKE3, no -a needed)
+  if (!args.outboardPath.empty()) {
+    CoInitialize(NULL);
+    int result = ComputeOutboard(args);
+    CoUninitialize();
+    if (needWait) {
+      printf("\nPress any key to exit...");
+      _getch();
+    } else {
+      fflush(stdout);
+    }
+    return result;
+  }
+
   // Console mode requires algorithms (either -a or --all)
   if (args.algorithms.empty() && !args.allAlgorithms) {
     printf("Error: Console mode requires at least one algorithm (-a option) or --all flag.\n");
@@ -288,14 +364,52 @@ int CommandLineParser::RunConsoleMode(LPWSTR lpCmdLine) {
     return 1;
   }
 
+  core::ReadOptions readOptions;
+  if (!ParseReadMode(args.ioMode, readOptions.mode)) {
+    wprintf(L"Error: Unknown I/O mode '%s'. Use auto, read, mmap, direct or ioring.\n\n", args.ioMode.c_str());
+
+    if (needWait) {
+      printf("Press any key to exit...");
+      _getch();
+    } else {
+      fflush(stdout);
+    }
+    return 1;
+  }
+  if (readOptions.mode == core::ReadMode::Direct) {
+    // Unbuffered reads get no read-ahead from the cache: keep more, larger requests in flight
+    readOptions.blockSize = core::ReadOptions::DIRECT_BLOCK_SIZE;
+    readOptions.queueDepth = core::ReadOptions::DIRECT_QUEUE_DEPTH;
+  } else if (readOptions.mode == core::ReadMode::IoRing) {
+    readOptions.blockSize = core::ReadOptions::IORING_BLOCK_SIZE;
+    readOptions.queueDepth = core::ReadOptions::IORING_QUEUE_DEPTH;
+  }
+
+  // Open the digest cache; hashing works the same without it
+  std::unique_ptr<core::DigestCache> digestCache;
+  if (args.useCache && args.isFile) {
+    std::wstring cachePath = args.cachePath.empty() ? core::DigestCache::defaultPath() : args.cachePath;
+    try {
+      digestCache.reset(new core::DigestCache(cachePath));
+    } catch (const std::exception& ex) {
+      printf("Warning: Digest cache unavailable (%s), continuing without it.\n\n", ex.what());
+    }
+  }
+
   // Initialize COM
   CoInitialize(NULL);
 
   // Compute hash
   int result = 0;
   if (args.isFile) {
-    if (!args.input.empty()) {
-      result = ComputeHashForFileWithAlgorithms(args.input, algorithmInfos, args.lowercase);
+    if (args.paths.size() > 1 || !args.directories.empty()) {
+      if (!args.resumePath.empty()) {
+        printf("Warning: --resume applies to a single file only, ignoring it.\n\n");
+      }
+      result = ComputeHashForPaths(args, algorithmInfos, readOptions, digestCache.get());
+    } else if (!args.input.empty()) {
+      result = ComputeHashForFileWithAlgorithms(args.input, algorithmInfos, args.lowercase, readOptions,
+                                                digestCache.get(), args.resumePath, args.appendMode);
     } else {
       printf("Error: No file path specified after --file/-f option\n");
       result = 1;
@@ -336,6 +450,14 @@ std::string CommandLineParser::GetAlgorithmDisplayName(int algorithmId, int hava
   return "Unknown";
 }
 
+std::string CommandLineParser::GetAlgorithmDisplayName(const AlgorithmInfo& info) {
+  return info.factoryName.empty() ? GetAlgorithmDisplayName(info.id, info.havalPass) : info.factoryName;
+}
+
+std::string CommandLineParser::GetFactoryAlgorithmName(const AlgorithmInfo& info) {
+  return info.factoryName.empty() ? GetFactoryAlgorithmName(info.id, info.havalPass) : info.factoryName;
+}
+
 std::string CommandLineParser::GetFactoryAlgorithmName(int algorithmId, int havalPass) {
   InitializeAlgorithmMappings();
 
@@ -430,28 +552,54 @@ bool CommandLineParser::IsConsoleMode(LPWSTR lpCmdLine) {
     return false;
   }
 
-  std::wstring cmdLine(lpCmdLine);
+  std::vector<std::wstring> tokens = Tokenize(lpCmdLine);
 
   // Check for help and list flags
-  if (cmdLine.find(L"--help") != std::wstring::npos ||
-      cmdLine.find(L"-h") != std::wstring::npos ||
-      cmdLine.find(L"/?") != std::wstring::npos ||
-      cmdLine.find(L"--list") != std::wstring::npos ||
-      cmdLine.find(L"-l") != std::wstring::npos) {
+  if (HasFlag(tokens, L"-h", L"--help") ||
+      HasFlag(tokens, L"/?", nullptr) ||
+      HasFlag(tokens, L"-l", L"--list")) {
     return true;
   }
 
-  // Check for console mode flags (-f/-t)
-  if (cmdLine.find(L"--file") != std::wstring::npos ||
-      cmdLine.find(L"-f") != std::wstring::npos ||
-      cmdLine.find(L"--text") != std::wstring::npos ||
-      cmdLine.find(L"-t") != std::wstring::npos) {
+  // Check for console mode flags (-f/-t/-r)
+  if (HasFlag(tokens, L"-f", L"--file") ||
+      HasFlag(tokens, L"-t", L"--text") ||
+      HasFlag(tokens, L"-r", L"--recursive")) {
     return true;
   }
 
   return false;
 }
 
+std::vector<std::wstring> CommandLineParser::Tokenize(const std::wstring& cmdLine) {
+  std::vector<std::wstring> tokens;
+
+  // CommandLineToArgvW treats the first argument as the program name, which
+  // has different quoting rules; give it a dummy one and drop it
+  std::wstring fullLine = L"HashCalc.exe " + cmdLine;
+  int argc = 0;
+  LPWSTR* argv = CommandLineToArgvW(fullLine.c_str(), &argc);
+  if (argv == nullptr) {
+    return tokens;
+  }
+
+  for (int i = 1; i < argc; i++) {
+    tokens.push_back(argv[i]);
+  }
+  LocalFree(argv);
+
+  return tokens;
+}
+
+bool CommandLineParser::HasFlag(const std::vector<std::wstring>& tokens, const wchar_t* shortFlag, const wchar_t* longFlag) {
+  for (const auto& token : tokens) {
+    if (token == shortFlag || (longFlag != nullptr && token == longFlag)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool CommandLineParser::AttachConsoleWindow(bool& outNeedWait) {
   outNeedWait = false;
 
@@ -482,71 +630,97 @@ bool CommandLineParser::AttachConsoleWindow(bool& outNeedWait) {
   return false;
 }
 
-std::wstring CommandLineParser::ExtractValue(const std::wstring& cmdLine, size_t startPos) {
-  if (startPos >= cmdLine.length()) {
-    return L"";
-  }
-
-  // Check if quoted
-  if (cmdLine[startPos] == L'"') {
-    size_t endPos = cmdLine.find(L'"', startPos + 1);
-    if (endPos != std::wstring::npos) {
-      return cmdLine.substr(startPos + 1, endPos - startPos - 1);
-    }
-    return L"";
-  }
-
-  // Not quoted - find end (space, tab, or dash)
-  size_t endPos = cmdLine.find_first_of(L" \t-", startPos);
-
-  // If we hit a dash, backtrack to skip trailing whitespace
-  if (endPos != std::wstring::npos && cmdLine[endPos] == L'-') {
-    while (endPos > startPos && (cmdLine[endPos - 1] == L' ' || cmdLine[endPos - 1] == L'\t')) {
-      endPos--;
-    }
-  }
-
-  if (endPos != std::wstring::npos && endPos > startPos) {
-    return cmdLine.substr(startPos, endPos - startPos);
-  } else if (endPos == std::wstring::npos) {
-    return cmdLine.substr(startPos);
+bool CommandLineParser::ParseReadMode(const std::wstring& name, core::ReadMode& outMode) {
+  if (name.empty() || _wcsicmp(name.c_str(), L"auto") == 0) {
+    outMode = core::ReadMode::Auto;
+  } else if (_wcsicmp(name.c_str(), L"read") == 0) {
+    outMode = core::ReadMode::Stream;
+  } else if (_wcsicmp(name.c_str(), L"mmap") == 0) {
+    outMode = core::ReadMode::Mapped;
+  } else if (_wcsicmp(name.c_str(), L"direct") == 0) {
+    outMode = core::ReadMode::Direct;
+  } else if (_wcsicmp(name.c_str(), L"ioring") == 0) {
+    outMode = core::ReadMode::IoRing;
+  } else {
+    return false;
   }
-
-  return L"";
+  return true;
 }
 
 void CommandLineParser::ParseConsoleModeArgs(const std::wstring& cmdLine, ParsedArgs& args) {
-  // Parse algorithm parameters
-  args.algorithms = ParseAlgorithmParameters(cmdLine);
-
-  // Find file or text flag
-  size_t filePos = cmdLine.find(L"--file");
-  if (filePos == std::wstring::npos) {
-    filePos = cmdLine.find(L"-f");
-  }
+  std::vector<std::wstring> tokens = Tokenize(cmdLine);
 
-  size_t textPos = cmdLine.find(L"--text");
-  if (textPos == std::wstring::npos) {
-    textPos = cmdLine.find(L"-t");
-  }
+  for (size_t i = 0; i < tokens.size(); i++) {
+    const std::wstring& token = tokens[i];
+    bool hasValue = i + 1 < tokens.size();
 
-  // Parse file input
-  if (filePos != std::wstring::npos) {
-    args.isFile = true;
-    size_t flagLen = (cmdLine[filePos + 1] == L'-') ? 6 : 2;  // --file vs -f
-    size_t valueStart = cmdLine.find_first_not_of(L" \t", filePos + flagLen);
-    if (valueStart != std::wstring::npos) {
-      args.input = ExtractValue(cmdLine, valueStart);
+    if (token == L"-a" || token == L"--algorithm") {
+      if (hasValue) {
+        args.algorithms.push_back(tokens[++i]);
+      }
+    } else if (token == L"-f" || token == L"--file") {
+      args.isFile = true;
+      if (hasValue) {
+        args.paths.push_back(tokens[++i]);
+      }
+    } else if (token == L"-t" || token == L"--text") {
+      // Text input wins only if no file flag was given, as before
+      if (hasValue && !args.isFile && args.input.empty()) {
+        args.input = tokens[i + 1];
+      }
+      if (hasValue) {
+        i++;
+      }
+    } else if (token == L"-r" || token == L"--recursive") {
+      args.isFile = true;
+      if (hasValue) {
+        args.directories.push_back(tokens[++i]);
+      }
+    } else if (token == L"-j" || token == L"--jobs") {
+      if (hasValue) {
+        args.jobs = wcstoul(tokens[++i].c_str(), nullptr, 10);
+      }
+    } else if (token == L"--io") {
+      if (hasValue) {
+        args.ioMode = tokens[++i];
+      }
+    } else if (token == L"--resume") {
+      if (hasValue) {
+        args.resumePath = tokens[++i];
+      }
+    } else if (token == L"--append") {
+      args.appendMode = true;
+      args.useCache = true;
+    } else if (token == L"--outboard") {
+      if (hasValue) {
+        args.outboardPath = tokens[++i];
+      }
+    } else if (token == L"--verify-range") {
+      if (hasValue) {
+        args.verifyRange = tokens[++i];
+      }
+    } else if (token == L"--root") {
+      if (hasValue) {
+        args.rootHash = tokens[++i];
+      }
+    } else if (token == L"--cache-file") {
+      args.useCache = true;
+      if (hasValue) {
+        args.cachePath = tokens[++i];
+      }
+    } else if (token == L"-A" || token == L"--all" || token == L"-c" || token == L"--lowercase" ||
+               token == L"--cache") {
+      // Handled in Parse()
+    } else if (!token.empty() && token[0] == L'-') {
+      wprintf(L"Warning: Unknown option '%s', ignoring.\n", token.c_str());
+    } else {
+      // Positional argument: another file to hash
+      args.paths.push_back(token);
     }
   }
-  // Parse text input
-  else if (textPos != std::wstring::npos) {
-    args.isFile = false;
-    size_t flagLen = (cmdLine[textPos + 1] == L'-') ? 6 : 2;  // --text vs -t
-    size_t valueStart = cmdLine.find_first_not_of(L" \t", textPos + flagLen);
-    if (valueStart != std::wstring::npos) {
-      args.input = ExtractValue(cmdLine, valueStart);
-    }
+
+  if (args.isFile) {
+    args.input = args.paths.empty() ? L"" : args.paths.front();
   }
 }
 
@@ -558,6 +732,19 @@ void CommandLineParser::ParseGUIModeArgs(const std::wstring& cmdLine, ParsedArgs
   std::wstring inputOnly = cmdLine;
   RemoveAlgorithmParameters(inputOnly);
 
+  // Remove the --cache flag (standalone only, so a path containing it survives)
+  size_t cachePos = 0;
+  while ((cachePos = inputOnly.find(L"--cache", cachePos)) != std::wstring::npos) {
+    size_t endPos = cachePos + 7;
+    bool standalone = (cachePos == 0 || inputOnly[cachePos - 1] == L' ' || inputOnly[cachePos - 1] == L'\t') &&
+                      (endPos == inputOnly.length() || inputOnly[endPos] == L' ' || inputOnly[endPos] == L'\t');
+    if (standalone) {
+      inputOnly.erase(cachePos, endPos - cachePos);
+    } else {
+      cachePos = endPos;
+    }
+  }
+
   // Trim whitespace
   size_t start = inputOnly.find_first_not_of(L" \t");
   if (start == std::wstring::npos) {
@@ -728,6 +915,17 @@ std::vector<AlgorithmInfo> CommandLineParser::ConvertAlgorithmsToInfo(
   for (const auto& algoName : algorithms) {
     int id = configManager.GetAlgorithmIdFromName(algoName);
     if (id == 0) {
+      // Algorithms without a checkbox (CRC catalogue) go by their registered name
+      std::string factoryName(algoName.begin(), algoName.end());
+      for (char& c : factoryName) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+      }
+      if (core::HashAlgorithmFactory::isAvailable(factoryName)) {
+        AlgorithmInfo info;
+        info.factoryName = factoryName;
+        algorithmInfos.push_back(info);
+        continue;
+      }
       wprintf(L"Warning: Unknown algorithm '%s', skipping.\n", algoName.c_str());
       continue;
     }
@@ -748,14 +946,223 @@ std::vector<AlgorithmInfo> CommandLineParser::ConvertAlgorithmsToInfo(
   return algorithmInfos;
 }
 
+int CommandLineParser::ComputeHashForPaths(
+  const ParsedArgs& args,
+  const std::vector<AlgorithmInfo>& algorithmInfos,
+  const core::ReadOptions& readOptions,
+  core::DigestCache* digestCache
+) {
+  // Resolve algorithms once for the whole run
+  std::vector<std::string> factoryNames;
+  std::vector<std::string> displayNames;
+  for (const AlgorithmInfo& info : algorithmInfos) {
+    std::string factoryName = GetFactoryAlgorithmName(info);
+    std::string displayName = GetAlgorithmDisplayName(info);
+
+    if (factoryName.empty() || !core::HashAlgorithmFactory::isAvailable(factoryName)) {
+      printf("%-15s: Error - Not available, skipping\n", displayName.c_str());
+      continue;
+    }
+    factoryNames.push_back(factoryName);
+    displayNames.push_back(displayName);
+  }
+
+  if (factoryNames.empty()) {
+    printf("\nFailed to compute any hashes.\n");
+    return 1;
+  }
+
+  core::BatchHasher batch(factoryNames);
+  batch.setThreadCount(args.jobs);
+  batch.setReadOptions(readOptions);
+  batch.setDigestCache(digestCache);
+  batch.setAppendMode(args.appendMode);
+
+  size_t errorCount = 0;
+  for (const auto& path : args.paths) {
+    DWORD fileAttr = GetFileAttributesW(path.c_str());
+    if (fileAttr != INVALID_FILE_ATTRIBUTES && (fileAttr & FILE_ATTRIBUTE_DIRECTORY)) {
+      wprintf(L"Error: Path is a directory, use -r to hash its contents: %s\n", path.c_str());
+      errorCount++;
+      continue;
+    }
+    batch.addFile(path);
+  }
+  for (const auto& directory : args.directories) {
+    batch.addDirectory(directory);
+  }
+
+  size_t threadCount = args.jobs != 0 ? args.jobs : core::ThreadPool::defaultThreadCount();
+  printf("Hashing with %zu algorithm(s) on %zu thread(s)...\n\n", factoryNames.size(), threadCount);
+
+  // Start timing
+  auto start_time = std::chrono::high_resolution_clock::now();
+
+  size_t fileCount = 0;
+  size_t cachedCount = 0;
+  size_t appendedCount = 0;
+  uint64_t byteCount = 0;
+  batch.run([&](const core::BatchHasher::Result& result) {
+    wprintf(L"%s%s\n", result.path.c_str(), result.hardLink ? L" (hard link, hashed once)" : L"");
+
+    if (!result.error.empty()) {
+      printf("%-15s: Error - %s\n\n", "", result.error.c_str());
+      errorCount++;
+      return;
+    }
+
+    for (size_t i = 0; i < result.digests.size(); i++) {
+      // Use uppercase by default, lowercase if flag is set
+      std::string hash = core::IHashAlgorithm::toHexString(result.digests[i], !args.lowercase);
+      printf("%-15s: %s\n", displayNames[i].c_str(), hash.c_str());
+    }
+    printf("\n");
+
+    fileCount++;
+    if (result.cached) {
+      cachedCount++;
+    }
+    if (result.appended) {
+      appendedCount++;
+    }
+    if (!result.hardLink) {
+      byteCount += result.size;
+    }
+  });
+
+  // End timing
+  auto end_time = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> elapsed = end_time - start_time;
+
+  printf("Hashed %zu file(s), %llu bytes, %zu error(s)", fileCount,
+         static_cast<unsigned long long>(byteCount), errorCount);
+  if (digestCache != nullptr) {
+    printf(", %zu from cache", cachedCount);
+  }
+  if (digestCache != nullptr && args.appendMode) {
+    printf(", %zu appended to", appendedCount);
+  }
+  printf("\n");
+  printf("Calculation took %.3f seconds\n", elapsed.count());
+
+  return (errorCount == 0 && fileCount > 0) ? 0 : 1;
+}
+
+int CommandLineParser::ComputeOutboard(const ParsedArgs& args) {
+  if (args.input.empty() || args.paths.size() > 1 || !args.directories.empty()) {
+    printf("Error: --outboard needs exactly one file (-f <path>)\n");
+    return 1;
+  }
+
+  core::ReadOptions readOptions;
+  if (!ParseReadMode(args.ioMode, readOptions.mode)) {
+    wprintf(L"Error: Unknown I/O mode '%s'. Use auto, read, mmap, direct or ioring.\n", args.ioMode.c_str());
+    return 1;
+  }
+
+  auto start_time = std::chrono::high_resolution_clock::now();
+
+  if (args.verifyRange.empty()) {
+    wprintf(L"Creating outboard of file: %s\n\n", args.input.c_str());
+    try {
+      std::vector<uint8_t> root = core::BaoOutboard::create(args.input, args.outboardPath,
+                                                            core::BaoOutboard::DEFAULT_CHUNK_GROUP_LOG,
+                                                            readOptions);
+      std::string hash = core::IHashAlgorithm::toHexString(root, !args.lowercase);
+      printf("%-15s: %s\n", "BLAKE3", hash.c_str());
+      wprintf(L"%-15s: %s\n", L"Outboard", args.outboardPath.c_str());
+    } catch (const std::exception& ex) {
+      printf("Error: %s\n", ex.what());
+      return 1;
+    }
+  } else {
+    uint64_t offset = 0;
+    uint64_t length = 0;
+    if (!ParseRange(args.verifyRange, offset, length)) {
+      wprintf(L"Error: Invalid range '%s', expected <offset>:<length>.\n", args.verifyRange.c_str());
+      return 1;
+    }
+    std::vector<uint8_t> root;
+    if (!ParseHexDigest(args.rootHash, root) || root.size() != 32) {
+      printf("Error: --verify-range needs the 64 hex digit BLAKE3 root hash (--root).\n");
+      return 1;
+    }
+
+    wprintf(L"Verifying range of file: %s\n", args.input.c_str());
+    printf("Range: offset %llu, length %llu\n\n", static_cast<unsigned long long>(offset),
+           static_cast<unsigned long long>(length));
+    core::BaoOutboard::RangeCheck check;
+    try {
+      check = core::BaoOutboard::verifyRange(args.input, args.outboardPath, root, offset, length);
+    } catch (const std::exception& ex) {
+      printf("Error: %s\n", ex.what());
+      return 1;
+    }
+    printf("%-15s: %s\n", "Result", check.verified ? "Verified" : "FAILED - range does not match the root hash");
+    printf("%-15s: %llu content bytes, %llu outboard bytes\n", "Read",
+           static_cast<unsigned long long>(check.contentBytesRead),
+           static_cast<unsigned long long>(check.outboardBytesRead));
+    if (!check.verified) {
+      return 1;
+    }
+  }
+
+  auto end_time = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> elapsed = end_time - start_time;
+  printf("\nCalculation took %.3f seconds\n", elapsed.count());
+  return 0;
+}
+
+bool CommandLineParser::ParseRange(const std::wstring& text, uint64_t& outOffset, uint64_t& outLength) {
+  size_t colon = text.find(L':');
+  if (colon == std::wstring::npos || colon == 0 || colon + 1 == text.size()) {
+    return false;
+  }
+  std::wstring offsetText = text.substr(0, colon);
+  std::wstring lengthText = text.substr(colon + 1);
+  if (offsetText.find_first_not_of(L"0123456789") != std::wstring::npos ||
+      lengthText.find_first_not_of(L"0123456789") != std::wstring::npos) {
+    return false;
+  }
+  outOffset = wcstoull(offsetText.c_str(), nullptr, 10);
+  outLength = wcstoull(lengthText.c_str(), nullptr, 10);
+  return true;
+}
+
+bool CommandLineParser::ParseHexDigest(const std::wstring& text, std::vector<uint8_t>& outBytes) {
+  if (text.empty() || text.size() % 2 != 0) {
+    return false;
+  }
+  outBytes.clear();
+  for (size_t i = 0; i < text.size(); i += 2) {
+    int value = 0;
+    for (size_t j = i; j < i + 2; j++) {
+      wchar_t c = text[j];
+      int digit;
+      if (c >= L'0' && c <= L'9') {
+        digit = c - L'0';
+      } else if (c >= L'a' && c <= L'f') {
+        digit = c - L'a' + 10;
+      } else if (c >= L'A' && c <= L'F') {
+        digit = c - L'A' + 10;
+      } else {
+        return false;
+      }
+      value = value * 16 + digit;
+    }
+    outBytes.push_back(static_cast<uint8_t>(value));
+  }
+  return true;
+}
+
 bool CommandLineParser::ComputeSingleHash(
   const AlgorithmInfo& algorithmInfo,
   const std::wstring& inputData,
   bool isFile,
   bool lowercase
 ) {
-  std::string factoryName = GetFactoryAlgorithmName(algorithmInfo.id, algorithmInfo.havalPass);
-  std::string displayName = GetAlgorithmDisplayName(algorithmInfo.id, algorithmInfo.havalPass);
+  std::string factoryName = GetFactoryAlgorithmName(algorithmInfo);
+  std::string displayName = GetAlgorithmDisplayName(algorithmInfo);
 
   if (factoryName.empty()) {
     printf("%-15s: Error - Unknown algorithm ID\n", displayName.c_str());
@@ -833,7 +1240,11 @@ int CommandLineParser::ComputeHashForTextWithAlgorithms(
 int CommandLineParser::ComputeHashForFileWithAlgorithms(
   const std::wstring& filePath,
   const std::vector<AlgorithmInfo>& algorithmInfos,
-  bool lowercase
+  bool lowercase,
+  const core::ReadOptions& readOptions,
+  core::DigestCache* digestCache,
+  const std::wstring& resumePath,
+  bool appendMode
 ) {
   // Validate file exists
   DWORD fileAttr = GetFileAttributesW(filePath.c_str());
@@ -871,10 +1282,108 @@ int CommandLineParser::ComputeHashForFileWithAlgorithms(
   // Start timing
   auto start_time = std::chrono::high_resolution_clock::now();
 
+  // Instantiate every algorithm up front so the file is read only once
+  core::MultiHasher hasher;
+  hasher.setReadOptions(readOptions);
+  std::vector<std::string> displayNames(algorithmInfos.size());
+  std::vector<std::string> errors(algorithmInfos.size());
+  std::vector<size_t> digestIndex(algorithmInfos.size(), SIZE_MAX);
+  std::vector<std::string> factoryNames; // In add() order, for the digest cache
+
+  for (size_t i = 0; i < algorithmInfos.size(); i++) {
+    const AlgorithmInfo& info = algorithmInfos[i];
+    std::string factoryName = GetFactoryAlgorithmName(info);
+    displayNames[i] = GetAlgorithmDisplayName(info);
+
+    if (factoryName.empty()) {
+      errors[i] = "Unknown algorithm ID";
+      continue;
+    }
+
+    try {
+      digestIndex[i] = hasher.add(core::HashAlgorithmFactory::create(factoryName));
+      factoryNames.push_back(factoryName);
+    } catch (const std::exception& ex) {
+      errors[i] = ex.what();
+    }
+  }
+
+  // With --resume, continue from a matching checkpoint and keep saving new ones
+  bool checkpointing = false;
+  bool resuming = false;
+  bool saveFailed = false;
+  core::MultiHasher::Checkpoint checkpoint;
+  if (!resumePath.empty() && !hasher.empty()) {
+    if (!hasher.supportsState()) {
+      printf("Warning: Not every selected algorithm can be checkpointed, --resume is ignored.\n\n");
+    } else {
+      checkpointing = true;
+      try {
+        std::vector<std::string> savedNames;
+        core::DigestCache::FileKey key;
+        if (core::CheckpointFile::load(resumePath, savedNames, checkpoint)) {
+          if (savedNames != factoryNames) {
+            printf("Warning: Checkpoint was saved for other algorithms, starting over.\n\n");
+          } else if (!core::DigestCache::queryFileKey(filePath, key) || key != checkpoint.file) {
+            printf("Warning: File changed since the checkpoint was saved, starting over.\n\n");
+          } else {
+            resuming = true;
+            printf("Resuming at byte %llu\n\n", static_cast<unsigned long long>(checkpoint.offset));
+          }
+        }
+      } catch (const std::exception& ex) {
+        printf("Warning: Cannot use checkpoint (%s), starting over.\n\n", ex.what());
+      }
+
+      hasher.setCheckpointCallback([&](const core::MultiHasher::Checkpoint& current) {
+        try {
+          core::CheckpointFile::save(resumePath, factoryNames, current);
+        } catch (const std::exception& ex) {
+          // Hashing goes on; only the ability to resume is lost
+          if (!saveFailed) {
+            printf("Warning: Cannot save checkpoint (%s).\n", ex.what());
+            saveFailed = true;
+          }
+        }
+      });
+    }
+  }
+
+  std::vector<std::vector<uint8_t>> digests;
+  if (!hasher.empty()) {
+    hasher.setDigestCache(digestCache, factoryNames);
+    if (appendMode && digestCache != nullptr) {
+      if (hasher.supportsState()) {
+        hasher.setAppendMode(true);
+      } else {
+        printf("Warning: Not every selected algorithm can save its state, --append is ignored.\n\n");
+      }
+    }
+    try {
+      digests = resuming ? hasher.resumeFile(filePath, checkpoint) : hasher.computeFile(filePath);
+      if (checkpointing) {
+        core::CheckpointFile::remove(resumePath);
+      }
+    } catch (const std::exception& ex) {
+      // A read error affects every algorithm in the set
+      for (size_t i = 0; i < algorithmInfos.size(); i++) {
+        if (digestIndex[i] != SIZE_MAX) {
+          errors[i] = ex.what();
+          digestIndex[i] = SIZE_MAX;
+        }
+      }
+    }
+  }
+
   bool anyComputed = false;
-  for (const AlgorithmInfo& info : algorithmInfos) {
-    if (ComputeSingleHash(info, filePath, true, lowercase)) {
+  for (size_t i = 0; i < algorithmInfos.size(); i++) {
+    if (digestIndex[i] != SIZE_MAX) {
+      // Use uppercase by default, lowercase if flag is set
+      std::string hash = core::IHashAlgorithm::toHexString(digests[digestIndex[i]], !lowercase);
+      printf("%-15s: %s\n", displayNames[i].c_str(), hash.c_str());
       anyComputed = true;
+    } else {
+      printf("%-15s: Error - %s\n", displayNames[i].c_str(), errors[i].c_str());
     }
   }
 
@@ -887,6 +1396,11 @@ int CommandLineParser::ComputeHashForFileWithAlgorithms(
     return 1;
   }
 
+  if (hasher.getAppendOffset() > 0) {
+    printf("\nContinued from byte %llu of the cached run\n",
+           static_cast<unsigned long long>(hasher.getAppendOffset()));
+  }
+
   // Print elapsed time
   printf("\nCalculation took %.3f seconds\n", elapsed.count());
 
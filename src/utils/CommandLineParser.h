@@ -12,6 +12,8 @@
 #define COMMANDLINEPARSER_H
 
 #include <windows.h>
+#include "../core/ReadOptions.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -19,6 +21,10 @@
 // Forward declarations
 class ConfigManager;
 
+namespace core {
+class DigestCache;
+}
+
 namespace utils {
 
 /**
@@ -27,6 +33,7 @@ namespace utils {
 struct AlgorithmInfo {
   int id;         // Algorithm ID from resource.h
   int havalPass;  // HAVAL pass number (3, 4, or 5), or 0 for non-HAVAL algorithms
+  std::string factoryName;  // Registered name of an algorithm without an ID (CRC catalogue), else empty
 
   AlgorithmInfo(int _id = 0, int _pass = 0) : id(_id), havalPass(_pass) {}
 };
@@ -58,9 +65,21 @@ public:
     bool isFile;                            // true = file input (-f), false = text input (-t)
     bool allAlgorithms;                     // --all flag (use all available algorithms)
     bool lowercase;                         // --lowercase flag (use lowercase output in console mode)
+    std::wstring ioMode;                    // --io value (file input backend, empty = auto)
+    std::vector<std::wstring> paths;        // Console: files from -f and positional arguments
+    std::vector<std::wstring> directories;  // Console: trees to hash from -r/--recursive
+    size_t jobs;                            // Console: --jobs value (0 = one per available CPU)
+    bool useCache;                          // --cache flag (look up and record digests in the digest cache)
+    std::wstring cachePath;                 // Console: --cache-file value (empty = default location)
+    std::wstring resumePath;                // Console: --resume value (checkpoint file for a single file)
+    bool appendMode;                        // Console: --append flag (hash only data appended since cached)
+    std::wstring outboardPath;              // Console: --outboard value (BLAKE3 outboard tree file)
+    std::wstring verifyRange;               // Console: --verify-range value ("<offset>:<length>")
+    std::wstring rootHash;                  // Console: --root value (hex BLAKE3 root for --verify-range)
 
     ParsedArgs()
-      : mode(Mode::GUI), isHelp(false), isList(false), isFile(false), allAlgorithms(false), lowercase(false) {}
+      : mode(Mode::GUI), isHelp(false), isList(false), isFile(false), allAlgorithms(false), lowercase(false),
+        jobs(0), useCache(false), appendMode(false) {}
   };
 
   // ============================================================================
@@ -111,6 +130,13 @@ public:
    */
   static std::string GetFactoryAlgorithmName(int algorithmId, int havalPass = 0);
 
+  /**
+   * @brief Get display and factory names of a parsed algorithm
+   * @param info Algorithm from ConvertAlgorithmsToInfo (by ID, or by factory name)
+   */
+  static std::string GetAlgorithmDisplayName(const AlgorithmInfo& info);
+  static std::string GetFactoryAlgorithmName(const AlgorithmInfo& info);
+
   /**
    * @brief Extract HAVAL pass number from algorithm name
    * @param algoName Algorithm name (e.g., "HAVAL-3-256")
@@ -144,6 +170,22 @@ private:
    */
   static bool IsConsoleMode(LPWSTR lpCmdLine);
 
+  /**
+   * @brief Split a command line into arguments using the standard Windows quoting rules
+   * @param cmdLine Command line string (without the program name)
+   * @return Arguments in order
+   */
+  static std::vector<std::wstring> Tokenize(const std::wstring& cmdLine);
+
+  /**
+   * @brief Check whether a flag appears as a whole argument
+   * @param tokens Arguments from Tokenize()
+   * @param shortFlag Short form (e.g., L"-c")
+   * @param longFlag Long form (e.g., L"--lowercase"), or nullptr
+   * @return true if either form is present
+   */
+  static bool HasFlag(const std::vector<std::wstring>& tokens, const wchar_t* shortFlag, const wchar_t* longFlag);
+
   /**
    * @brief Attach console to the current process for command-line output
    * @param outNeedWait Set to true if we allocated a new console (need to wait for user)
@@ -159,15 +201,15 @@ private:
   static std::vector<std::wstring> ParseAlgorithmParameters(const std::wstring& cmdLine);
 
   /**
-   * @brief Extract quoted or unquoted string value after a position
-   * @param cmdLine Command line string
-   * @param startPos Position to start extraction
-   * @return Extracted string value
+   * @brief Convert an --io value to a file input backend
+   * @param name Backend name ("auto", "read", "mmap", "direct" or "ioring"; empty = auto)
+   * @param outMode Resulting read mode
+   * @return false if the name is not recognized
    */
-  static std::wstring ExtractValue(const std::wstring& cmdLine, size_t startPos);
+  static bool ParseReadMode(const std::wstring& name, core::ReadMode& outMode);
 
   /**
-   * @brief Parse console mode arguments (-f/-t and input)
+   * @brief Parse console mode arguments (-f/-t/-r, paths and options)
    * @param cmdLine Command line string
    * @param args Output parsed arguments
    */
@@ -213,14 +255,61 @@ private:
    * @param filePath Path to file to hash
    * @param algorithmInfos Vector of algorithm information to use
    * @param lowercase True to output lowercase hex, false for uppercase
+   * @param readOptions File input options (backend selected with --io)
+   * @param digestCache Digest cache to consult (--cache), or nullptr
+   * @param resumePath Checkpoint file to resume from and save to (--resume), or empty
+   * @param appendMode Hash only data appended since the cached run (--append)
    * @return 0 on success, 1 on error
    */
   static int ComputeHashForFileWithAlgorithms(
     const std::wstring& filePath,
     const std::vector<AlgorithmInfo>& algorithmInfos,
-    bool lowercase = false
+    bool lowercase = false,
+    const core::ReadOptions& readOptions = core::ReadOptions(),
+    core::DigestCache* digestCache = nullptr,
+    const std::wstring& resumePath = std::wstring(),
+    bool appendMode = false
   );
 
+  /**
+   * @brief Hash several files and directory trees on a thread pool
+   * @param args Parsed arguments (paths, directories, jobs, lowercase)
+   * @param algorithmInfos Vector of algorithm information to use
+   * @param readOptions File input options (backend selected with --io)
+   * @param digestCache Digest cache to consult (--cache), or nullptr
+   * @return 0 if every file was hashed, 1 otherwise
+   */
+  static int ComputeHashForPaths(
+    const ParsedArgs& args,
+    const std::vector<AlgorithmInfo>& algorithmInfos,
+    const core::ReadOptions& readOptions,
+    core::DigestCache* digestCache
+  );
+
+  /**
+   * @brief Write a BLAKE3 outboard tree for a file, or verify a range against one
+   * @param args Parsed arguments (input, outboardPath, verifyRange, rootHash, ioMode)
+   * @return 0 on success (range verified), 1 on error or verification failure
+   */
+  static int ComputeOutboard(const ParsedArgs& args);
+
+  /**
+   * @brief Parse a --verify-range value
+   * @param text Range as "<offset>:<length>" in decimal
+   * @param outOffset First byte of the range
+   * @param outLength Bytes in the range
+   * @return false if the text is malformed
+   */
+  static bool ParseRange(const std::wstring& text, uint64_t& outOffset, uint64_t& outLength);
+
+  /**
+   * @brief Parse a hex digest (upper or lower case)
+   * @param text Hex string with an even number of digits
+   * @param outBytes Decoded bytes
+   * @return false if the text is not valid hex
+   */
+  static bool ParseHexDigest(const std::wstring& text, std::vector<uint8_t>& outBytes);
+
   /**
    * @brief Compute single hash with error handling
    * @param algorithmInfo Algorithm information